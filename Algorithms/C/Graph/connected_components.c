@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "connected_components.h"
+
+#define AFFOREST_NEIGHBOR_ROUNDS 2
+#define AFFOREST_SAMPLES 1024
+
+// comp[v] is v's parent in a forest whose roots point to themselves. Parents
+// only ever move to smaller ids, so the smallest vertex of a component stays
+// its root.
+static _Atomic int32_t* compAlloc(int32_t n) {
+    _Atomic int32_t* comp = (_Atomic int32_t*)malloc(((size_t)n + 1) * sizeof(_Atomic int32_t));
+    if (!comp) {
+        perror("malloc failed");
+        exit(EXIT_FAILURE);
+    }
+    #pragma omp parallel for schedule(static)
+    for (int32_t v = 0; v < n; v++) {
+        atomic_init(&comp[v], v);
+    }
+    return comp;
+}
+
+// Hands the labels back as a plain array and frees the atomic one
+static int32_t* compRelease(_Atomic int32_t* comp, int32_t n) {
+    int32_t* labels = (int32_t*)malloc(((size_t)n + 1) * sizeof(int32_t));
+    if (!labels) {
+        perror("malloc failed");
+        exit(EXIT_FAILURE);
+    }
+    #pragma omp parallel for schedule(static)
+    for (int32_t v = 0; v < n; v++) {
+        labels[v] = atomic_load_explicit(&comp[v], memory_order_relaxed);
+    }
+    free(comp);
+    return labels;
+}
+
+// Points every vertex straight at its root
+static void compress(_Atomic int32_t* comp, int32_t n) {
+    #pragma omp parallel for schedule(dynamic, 16384)
+    for (int32_t v = 0; v < n; v++) {
+        int32_t parent = atomic_load_explicit(&comp[v], memory_order_relaxed);
+        int32_t grand = atomic_load_explicit(&comp[parent], memory_order_relaxed);
+        while (parent != grand) {
+            atomic_store_explicit(&comp[v], grand, memory_order_relaxed);
+            parent = grand;
+            grand = atomic_load_explicit(&comp[parent], memory_order_relaxed);
+        }
+    }
+}
+
+int32_t* cc_shiloach_vishkin(const CSRGraph* graph) {
+    const int32_t n = graph->numVertices;
+    _Atomic int32_t* comp = compAlloc(n);
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        // Hooking: after a shortcut every label is a root, so any edge whose
+        // ends disagree hooks one root under the other
+        #pragma omp parallel for schedule(dynamic, 16384) reduction(||:changed)
+        for (int32_t u = 0; u < n; u++) {
+            for (int64_t i = graph->offsets[u]; i < graph->offsets[u + 1]; i++) {
+                int32_t cu = atomic_load_explicit(&comp[u], memory_order_relaxed);
+                int32_t cv = atomic_load_explicit(&comp[graph->neighbors[i]], memory_order_relaxed);
+                if (cu == cv) {
+                    continue;
+                }
+                int32_t high = cu > cv ? cu : cv;
+                int32_t low = cu > cv ? cv : cu;
+                // Only a root may be hooked; losing the race leaves it for the next round
+                if (atomic_compare_exchange_strong_explicit(&comp[high], &high, low,
+                                                            memory_order_relaxed, memory_order_relaxed)) {
+                    changed = true;
+                }
+            }
+        }
+        compress(comp, n);
+    }
+    return compRelease(comp, n);
+}
+
+// Joins the trees of u and v, always linking the larger root under the smaller
+static void linkRoots(_Atomic int32_t* comp, int32_t u, int32_t v) {
+    int32_t p1 = atomic_load_explicit(&comp[u], memory_order_relaxed);
+    int32_t p2 = atomic_load_explicit(&comp[v], memory_order_relaxed);
+    while (p1 != p2) {
+        int32_t high = p1 > p2 ? p1 : p2;
+        int32_t low = p1 > p2 ? p2 : p1;
+        int32_t parent = atomic_load_explicit(&comp[high], memory_order_relaxed);
+        if (parent == low) {
+            return;
+        }
+        if (parent == high && atomic_compare_exchange_strong_explicit(&comp[high], &parent, low,
+                                                                      memory_order_relaxed, memory_order_relaxed)) {
+            return;
+        }
+        // high was not a root, or another thread moved it; climb one level and retry
+        p1 = atomic_load_explicit(&comp[atomic_load_explicit(&comp[high], memory_order_relaxed)],
+                                  memory_order_relaxed);
+        p2 = atomic_load_explicit(&comp[low], memory_order_relaxed);
+    }
+}
+
+static int compareInt32(const void* a, const void* b) {
+    int32_t x = *(const int32_t*)a, y = *(const int32_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Most common label among a fixed random sample of vertices, the likely giant component
+static int32_t sampleFrequentLabel(_Atomic int32_t* comp, int32_t n) {
+    int32_t samples[AFFOREST_SAMPLES];
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    for (int i = 0; i < AFFOREST_SAMPLES; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        samples[i] = atomic_load_explicit(&comp[(state >> 33) % (uint64_t)n], memory_order_relaxed);
+    }
+    qsort(samples, AFFOREST_SAMPLES, sizeof(int32_t), compareInt32);
+    int32_t best = samples[0];
+    int run = 0, bestRun = 0;
+    for (int i = 0; i < AFFOREST_SAMPLES; i++) {
+        run = (i > 0 && samples[i] == samples[i - 1]) ? run + 1 : 1;
+        if (run > bestRun) {
+            bestRun = run;
+            best = samples[i];
+        }
+    }
+    return best;
+}
+
+int32_t* cc_afforest(const CSRGraph* graph, bool symmetric) {
+    const int32_t n = graph->numVertices;
+    _Atomic int32_t* comp = compAlloc(n);
+    if (n == 0) {
+        return compRelease(comp, n);
+    }
+
+    // Subgraph sampling: the r-th neighbor of every vertex, one round at a time
+    for (int r = 0; r < AFFOREST_NEIGHBOR_ROUNDS; r++) {
+        #pragma omp parallel for schedule(dynamic, 16384)
+        for (int32_t u = 0; u < n; u++) {
+            int64_t i = graph->offsets[u] + r;
+            if (i < graph->offsets[u + 1]) {
+                linkRoots(comp, u, graph->neighbors[i]);
+            }
+        }
+        compress(comp, n);
+    }
+
+    // A vertex already in the giant component needs none of its other edges:
+    // in a symmetric graph each such edge is also seen from the far end. A
+    // directed graph has no way to see it from there, so nothing is skipped.
+    int32_t giant = symmetric ? sampleFrequentLabel(comp, n) : -1;
+    #pragma omp parallel for schedule(dynamic, 16384)
+    for (int32_t u = 0; u < n; u++) {
+        if (atomic_load_explicit(&comp[u], memory_order_relaxed) == giant) {
+            continue;
+        }
+        for (int64_t i = graph->offsets[u] + AFFOREST_NEIGHBOR_ROUNDS; i < graph->offsets[u + 1]; i++) {
+            linkRoots(comp, u, graph->neighbors[i]);
+        }
+    }
+    compress(comp, n);
+    return compRelease(comp, n);
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// connected_components.h
+// Parallel connected components over a CSR graph. Both algorithms label each
+// vertex with the smallest vertex id in its component, so the result of either
+// can be compared with a sequential labelling directly. Directed graphs get
+// their weakly connected components.
+#ifndef CONNECTED_COMPONENTS_H
+#define CONNECTED_COMPONENTS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../../../DataStructure/C/graph/csr_graph.h"
+
+// Shiloach-Vishkin: every round hooks the larger of two adjacent roots under
+// the smaller with a CAS, then shortcuts every vertex to its root, until no
+// hook succeeds. O(log V) rounds, each O(V + E) work.
+int32_t* cc_shiloach_vishkin(const CSRGraph* graph);
+
+// Afforest (Sutton et al., IPDPS 2018): links a couple of sampled neighbors
+// per vertex first, which is usually enough to form the giant component, then
+// links the remaining edges of every vertex outside it. Pass symmetric = false
+// for a graph that does not store both directions of each edge, which turns
+// the skip off. The caller frees the returned array.
+int32_t* cc_afforest(const CSRGraph* graph, bool symmetric);
+
+#endif // CONNECTED_COMPONENTS_H
@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "connected_components.h"
+#include "../../../DataStructure/C/graph/graph.h"
+
+// Sequential reference: flood every component from its smallest vertex
+static int32_t* serial_components(const CSRGraph* csr) {
+    int32_t n = csr->numVertices;
+    // Both directions, so directed inputs give weak components
+    CSREdge* edges = (CSREdge*)malloc(2 * (size_t)csr->numEdges * sizeof(CSREdge) + 1);
+    int64_t m = 0;
+    for (int32_t u = 0; u < n; u++) {
+        for (int64_t i = csr->offsets[u]; i < csr->offsets[u + 1]; i++) {
+            edges[m++] = (CSREdge){u, csr->neighbors[i], 0};
+            edges[m++] = (CSREdge){csr->neighbors[i], u, 0};
+        }
+    }
+    CSRGraph* both = csrFromEdges(n, edges, m, false);
+    free(edges);
+
+    int32_t* label = (int32_t*)malloc(((size_t)n + 1) * sizeof(int32_t));
+    int32_t* queue = (int32_t*)malloc(((size_t)n + 1) * sizeof(int32_t));
+    for (int32_t v = 0; v < n; v++) {
+        label[v] = -1;
+    }
+    for (int32_t s = 0; s < n; s++) {
+        if (label[s] != -1) {
+            continue;
+        }
+        int32_t head = 0, tail = 0;
+        label[s] = s;
+        queue[tail++] = s;
+        while (head < tail) {
+            int32_t u = queue[head++];
+            for (int64_t i = both->offsets[u]; i < both->offsets[u + 1]; i++) {
+                if (label[both->neighbors[i]] == -1) {
+                    label[both->neighbors[i]] = s;
+                    queue[tail++] = both->neighbors[i];
+                }
+            }
+        }
+    }
+    free(queue);
+    csrFree(both);
+    return label;
+}
+
+static int check(const char* name, const int32_t* got, const int32_t* expected, int32_t n, double seconds) {
+    for (int32_t v = 0; v < n; v++) {
+        if (got[v] != expected[v]) {
+            printf("Test failed: %s labels vertex %d with %d, expected %d\n", name, v, got[v], expected[v]);
+            return 0;
+        }
+    }
+    printf("Test passed: %s in %.3f s\n", name, seconds);
+    return 1;
+}
+
+// Random graph built through the graph API: a giant component plus many small
+// pieces and isolated vertices, stored either with both edge directions or one
+static int run_test(int n, int symmetric) {
+    Graph* graph = createGraph(n);
+    unsigned seed = 7;
+    for (int i = 0; i < 2 * n; i++) {
+        int u = rand_r(&seed) % n;
+        // Vertices above n/2 only connect within small blocks of 8
+        int v = u < n / 2 ? rand_r(&seed) % (n / 2) : u - u % 8 + rand_r(&seed) % 8;
+        if (u == v || v >= n) {
+            continue;
+        }
+        add_edge(graph, u, v, 1);
+        if (symmetric) {
+            add_edge(graph, v, u, 1);
+        }
+    }
+    CSRGraph* csr = graph_to_csr(graph);
+    freeGraph(graph);
+
+    printf("%d vertices, %lld %s edges, %d threads\n", n, (long long)csr->numEdges,
+           symmetric ? "symmetric" : "directed", omp_get_max_threads());
+    int32_t* expected = serial_components(csr);
+    int ok = 1;
+
+    double t0 = omp_get_wtime();
+    int32_t* sv = cc_shiloach_vishkin(csr);
+    double t1 = omp_get_wtime();
+    ok &= check("Shiloach-Vishkin", sv, expected, n, t1 - t0);
+    free(sv);
+
+    t0 = omp_get_wtime();
+    int32_t* af = cc_afforest(csr, symmetric);
+    t1 = omp_get_wtime();
+    ok &= check("Afforest", af, expected, n, t1 - t0);
+    free(af);
+
+    free(expected);
+    csrFree(csr);
+    return ok;
+}
+
+int main() {
+    int ok = run_test(1000000, 1);
+    ok &= run_test(200000, 0);
+    ok &= run_test(1, 1);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Compile with: gcc -O3 -fopenmp connected_components.c connected_components_test.c ../../../DataStructure/C/graph/graph.c -o cc
+// Run with: OMP_NUM_THREADS=8 ./cc
@@ -1,80 +1,74 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
+#include "../../../DataStructure/C/graph/graph.h"
 
-// Define the maximum number of vertices in the graph
-#define MAX_VERTICES 100
-
-// Adjacency list node
-typedef struct Node
-{
-    int vertex;
-    struct Node *next;
-} Node;
-
-// Graph structure
-typedef struct Graph
-{
-    int numVertices;
-    Node *adjLists[MAX_VERTICES];
-    int visited[MAX_VERTICES];
-} Graph;
-
-// Function to create a node
-Node *createNode(int v)
+// Add edge to the graph, in both directions for an undirected graph
+void addEdge(Graph *graph, int src, int dest)
 {
-    Node *newNode = (Node *)malloc(sizeof(Node));
-    newNode->vertex = v;
-    newNode->next = NULL;
-    return newNode;
+    add_edge(graph, src, dest, 1);
+    add_edge(graph, dest, src, 1);
 }
 
-// Function to create a graph
-Graph *createGraph(int vertices)
+// DFS algorithm
+// Iterative, with an explicit stack instead of the call stack, so a path of a
+// million vertices needs a million stack entries on the heap rather than a
+// million recursive frames. Each stack entry keeps a cursor into its vertex's
+// edge array, which gives the same preorder as the recursive version.
+// visit is called once per reached vertex; visited must hold numVertices flags.
+void DFS(Graph *graph, int start, bool *visited, void (*visit)(int vertex))
 {
-    Graph *graph = (Graph *)malloc(sizeof(Graph));
-    graph->numVertices = vertices;
+    int *stack = (int *)malloc((size_t)graph->numVertices * sizeof(int));
+    int *cursor = (int *)malloc((size_t)graph->numVertices * sizeof(int));
+    if (!stack || !cursor)
+    {
+        perror("malloc failed");
+        exit(EXIT_FAILURE);
+    }
+
+    int top = 0;
+    visited[start] = true;
+    visit(start);
+    stack[top] = start;
+    cursor[top] = 0;
+    top++;
 
-    for (int i = 0; i < vertices; i++)
+    while (top > 0)
     {
-        graph->adjLists[i] = NULL;
-        graph->visited[i] = 0;
+        Vertex *vertex = &graph->vertices[stack[top - 1]];
+        if (cursor[top - 1] == vertex->degree)
+        {
+            top--; // Every neighbor handled, backtrack
+            continue;
+        }
+
+        int connectedVertex = vertex->edges[cursor[top - 1]++].dest;
+        if (!visited[connectedVertex])
+        {
+            visited[connectedVertex] = true;
+            visit(connectedVertex);
+            stack[top] = connectedVertex;
+            cursor[top] = 0;
+            top++;
+        }
     }
-    return graph;
-}
 
-// Add edge to the graph
-void addEdge(Graph *graph, int src, int dest)
-{
-    // Add edge from src to dest
-    Node *newNode = createNode(dest);
-    newNode->next = graph->adjLists[src];
-    graph->adjLists[src] = newNode;
-
-    // Add edge from dest to src, for undirected graph
-    newNode = createNode(src);
-    newNode->next = graph->adjLists[dest];
-    graph->adjLists[dest] = newNode;
+    free(cursor);
+    free(stack);
 }
 
-// DFS algorithm
-void DFS(Graph *graph, int vertex)
+static void printVisit(int vertex)
 {
-    Node *adjList = graph->adjLists[vertex];
-    Node *temp = adjList;
-
-    graph->visited[vertex] = 1;
     printf("Visited %d \n", vertex);
+}
 
-    while (temp != NULL)
-    {
-        int connectedVertex = temp->vertex;
+static long visitedCount = 0;
+static int lastVisited = -1;
 
-        if (graph->visited[connectedVertex] == 0)
-        {
-            DFS(graph, connectedVertex);
-        }
-        temp = temp->next;
-    }
+static void countVisit(int vertex)
+{
+    visitedCount++;
+    lastVisited = vertex;
 }
 
 // Main function
@@ -96,9 +90,27 @@ int main()
     addEdge(graph, 50, 25);
 
     // Perform DFS starting from vertex 0
-    DFS(graph, 0);
-
-    return 0;
+    bool *visited = (bool *)calloc(graph->numVertices, sizeof(bool));
+    DFS(graph, 0, visited, printVisit);
+    free(visited);
+    freeGraph(graph);
+
+    // A path of a million vertices: the recursive version would need a million
+    // nested calls here and overflow a default 8 MB stack
+    const int n = 1000000;
+    graph = createGraph(n);
+    for (int i = 0; i + 1 < n; i++)
+    {
+        addEdge(graph, i, i + 1);
+    }
+    visited = (bool *)calloc(n, sizeof(bool));
+    DFS(graph, 0, visited, countVisit);
+    printf("%s: DFS over a %d-vertex path visited %ld vertices, last %d\n",
+           visitedCount == n && lastVisited == n - 1 ? "Test passed" : "Test failed", n, visitedCount, lastVisited);
+    free(visited);
+    freeGraph(graph);
+
+    return visitedCount == n ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
-// gcc -pg -fsanitize=address -g -std=c17 ./dfs.c -o dfs -O3  && ./dfs
\ No newline at end of file
+// gcc -pg -fsanitize=address -g -std=c17 ./dfs.c ../../../DataStructure/C/graph/graph.c -o dfs -O3  && ./dfs
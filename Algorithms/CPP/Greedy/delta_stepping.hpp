@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// delta_stepping.hpp
+
+#ifndef DELTA_STEPPING_HPP
+#define DELTA_STEPPING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <omp.h>
+#include "dijkstra.hpp"
+
+// Parallel Delta-stepping (Meyer & Sanders). Tentative distances are grouped
+// into buckets of width delta and buckets are settled in increasing order.
+// Inside bucket i every vertex relaxes its light edges (weight <= delta) in
+// parallel rounds until no distance lands in bucket i again; only then are the
+// heavy edges of the vertices settled in bucket i relaxed, once, since they can
+// only reach later buckets. Dijkstra is delta = 1, Bellman-Ford is delta = inf.
+
+// Copy of a CSR graph whose edges are reordered so each vertex's light edges
+// come first; lightEnd[v] is where its heavy edges start.
+struct DeltaEdges {
+    std::vector<int64_t> offsets;
+    std::vector<int64_t> lightEnd;
+    std::vector<int32_t> targets;
+    std::vector<int32_t> weights;
+};
+
+inline DeltaEdges splitLightHeavy(CSRView graph, int delta) {
+    int n = graph.numVertices();
+    DeltaEdges edges;
+    edges.offsets.assign(graph.offsets(), graph.offsets() + n + 1);
+    edges.lightEnd.resize(n);
+    edges.targets.resize(graph.numEdges());
+    edges.weights.resize(graph.numEdges());
+
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (int u = 0; u < n; u++) {
+        int64_t light = edges.offsets[u], heavy = edges.offsets[u + 1];
+        CSRRange<int32_t> adj = graph.neighbors(u);
+        for (int64_t i = 0; i < adj.size(); i++) {
+            int32_t w = graph.hasWeights() ? graph.weights(u)[i] : 1;
+            int64_t slot = (w <= delta) ? light++ : --heavy;
+            edges.targets[slot] = adj[i];
+            edges.weights[slot] = w;
+        }
+        edges.lightEnd[u] = light;
+    }
+    return edges;
+}
+
+// Meyer & Sanders pick delta = Theta(1 / d) for weights scaled to [0, 1]; in
+// the graph's own units that is the largest weight over the average degree.
+// Larger delta means fewer buckets (fewer barriers) but more re-relaxation.
+inline int chooseDelta(CSRView graph) {
+    int n = graph.numVertices();
+    if (n == 0 || graph.numEdges() == 0 || !graph.hasWeights()) return 1;
+    int32_t maxWeight = 1;
+    const int32_t* w = graph.weightData();
+    #pragma omp parallel for reduction(max : maxWeight)
+    for (int64_t i = 0; i < graph.numEdges(); i++) {
+        maxWeight = std::max(maxWeight, w[i]);
+    }
+    int64_t averageDegree = std::max<int64_t>(1, (graph.numEdges() + n - 1) / n);
+    return (int)std::max<int64_t>(1, maxWeight / averageDegree);
+}
+
+// Weights must be non-negative. delta <= 0 selects chooseDelta(graph).
+inline ShortestPaths deltaStepping(CSRView graph, int source, int delta = 0) {
+    const int n = graph.numVertices();
+    if (delta <= 0) delta = chooseDelta(graph);
+    DeltaEdges edges = splitLightHeavy(graph, delta);
+
+    // Distance in the high half and predecessor in the low half, so a single
+    // CAS keeps the two consistent and an atomic min on the word is a min on
+    // the distance.
+    const uint64_t unreached = ((uint64_t)INF << 32) | 0xFFFFFFFFu;
+    std::vector<std::atomic<uint64_t>> best(n);
+    #pragma omp parallel for
+    for (int v = 0; v < n; v++) best[v].store(unreached, std::memory_order_relaxed);
+    best[source].store((uint64_t)0 << 32 | 0xFFFFFFFFu, std::memory_order_relaxed);
+
+    // Last bucket each vertex was settled in, so heavy edges are relaxed once per bucket
+    std::vector<std::atomic<int64_t>> settledIn(n);
+    #pragma omp parallel for
+    for (int v = 0; v < n; v++) settledIn[v].store(-1, std::memory_order_relaxed);
+
+    const int maxThreads = omp_get_max_threads();
+    std::vector<std::vector<std::vector<int32_t>>> localBins(maxThreads);
+    std::vector<int64_t> binSizes(maxThreads + 1), nextBins(maxThreads);
+    std::vector<int32_t> frontier;
+    int64_t frontierSize = 0;
+    localBins[0].resize(1);
+    localBins[0][0].push_back(source);
+
+    #pragma omp parallel
+    {
+        const int tid = omp_get_thread_num();
+        const int threads = omp_get_num_threads();
+        std::vector<std::vector<int32_t>>& bins = localBins[tid];
+        std::vector<int32_t> settled;
+
+        // Atomic min; on success v goes into the thread's bin for its new bucket
+        auto relax = [&](int32_t u, int32_t v, int64_t candidate) {
+            if (candidate >= INF) return;
+            uint64_t proposal = (uint64_t)candidate << 32 | (uint32_t)u;
+            uint64_t current = best[v].load(std::memory_order_relaxed);
+            while (proposal < current) {
+                if (best[v].compare_exchange_weak(current, proposal, std::memory_order_relaxed)) {
+                    size_t bucket = (size_t)(candidate / delta);
+                    if (bins.size() <= bucket) bins.resize(bucket + 1);
+                    bins[bucket].push_back(v);
+                    return;
+                }
+            }
+        };
+
+        // Every thread's bin for bucket becomes the shared frontier
+        auto gather = [&](size_t bucket) {
+            binSizes[tid + 1] = bucket < bins.size() ? (int64_t)bins[bucket].size() : 0;
+            #pragma omp barrier
+            #pragma omp single
+            {
+                binSizes[0] = 0;
+                for (int t = 0; t < threads; t++) binSizes[t + 1] += binSizes[t];
+                frontierSize = binSizes[threads];
+                frontier.resize(frontierSize);
+            }
+            if (bucket < bins.size()) {
+                std::copy(bins[bucket].begin(), bins[bucket].end(), frontier.begin() + binSizes[tid]);
+                bins[bucket].clear();
+            }
+            #pragma omp barrier
+        };
+
+        size_t bucket = 0;
+        gather(bucket);
+        while (true) {
+            // Light phase: repeat until bucket stops refilling
+            while (frontierSize > 0) {
+                #pragma omp for schedule(dynamic, 64) nowait
+                for (int64_t i = 0; i < frontierSize; i++) {
+                    int32_t u = frontier[i];
+                    int64_t d = (int64_t)(best[u].load(std::memory_order_relaxed) >> 32);
+                    if ((size_t)(d / delta) != bucket) continue; // Stale: improved into an earlier bucket
+                    if (settledIn[u].exchange((int64_t)bucket, std::memory_order_relaxed) != (int64_t)bucket) {
+                        settled.push_back(u);
+                    }
+                    for (int64_t e = edges.offsets[u]; e < edges.lightEnd[u]; e++) {
+                        relax(u, edges.targets[e], d + edges.weights[e]);
+                    }
+                }
+                gather(bucket);
+            }
+
+            // Heavy phase: distances in this bucket are final
+            for (int32_t u : settled) {
+                int64_t d = (int64_t)(best[u].load(std::memory_order_relaxed) >> 32);
+                for (int64_t e = edges.lightEnd[u]; e < edges.offsets[u + 1]; e++) {
+                    relax(u, edges.targets[e], d + edges.weights[e]);
+                }
+            }
+            settled.clear();
+
+            // Next bucket is the smallest non-empty one over all threads
+            size_t next = bucket + 1;
+            while (next < bins.size() && bins[next].empty()) next++;
+            nextBins[tid] = next < bins.size() ? (int64_t)next : -1;
+            #pragma omp barrier
+            int64_t chosen = -1;
+            for (int t = 0; t < threads; t++) {
+                if (nextBins[t] >= 0 && (chosen < 0 || nextBins[t] < chosen)) chosen = nextBins[t];
+            }
+            if (chosen < 0) break;
+            bucket = (size_t)chosen;
+            gather(bucket);
+        }
+    }
+
+    ShortestPaths result;
+    result.distance.resize(n);
+    result.previous.resize(n);
+    #pragma omp parallel for
+    for (int v = 0; v < n; v++) {
+        uint64_t packed = best[v].load(std::memory_order_relaxed);
+        result.distance[v] = (int)(packed >> 32);
+        uint32_t prev = (uint32_t)packed;
+        result.previous[v] = prev == 0xFFFFFFFFu ? -1 : (int)prev;
+    }
+    return result;
+}
+
+// Time and Space Complexity
+// Work: O(V + E + L/delta * (light re-relaxations)), where L is the largest distance; with delta from
+// chooseDelta the expected work on random weights stays O(V + E).
+// Span: O(L/delta) buckets, each a few barriers deep, which is why delta trades depth against extra relaxations.
+// Space Complexity: O(V + E) for the light/heavy copy of the edges, plus O(V) for distances and the thread-local buckets.
+
+#endif // DELTA_STEPPING_HPP
@@ -18,72 +18,43 @@
  */
 
 
+#include <chrono>
 #include <iostream>
+#include <random>
 #include <vector>
-#include <queue>
 #include <utility> // for std::pair
-#include <limits> // for std::numeric_limits
+#include "dijkstra.hpp"
+#include "graph_generators.hpp"
+#include "delta_stepping.hpp"
 
 using namespace std;
 
-const int INF = numeric_limits<int>::max();
-
-
-// Initialize:
-
-// For each vertex v in the graph, set distance[v] = infinity and previous[v] = undefined.
-// Set distance[source] = 0 because the distance from the source to itself is zero.
-// Create a priority queue (min-heap) Q to prioritize vertices with the smallest distance.
-
-// Main Loop:
-// While Q is not empty:
-// Remove a vertex u from Q with the smallest distance.
-// For each neighbor v of u:
-// If distance[u] + weight(u, v) < distance[v]:
-// Update distance[v] = distance[u] + weight(u, v).
-// Update previous[v] = u.
-// Update v's position in Q (decrease-key operation).
-
-// Output:
-// The distance array holds the shortest distances from the source to all vertices.
-// The previous array can be used to reconstruct the shortest paths.
-
-// Data Structures
-// Priority Queue: Implemented as a min-heap to efficiently extract the next vertex with the smallest tentative distance. This is crucial for optimizing the algorithm.
-// Adjacency List: Represents the graph to efficiently iterate over neighbors of a vertex, particularly useful for sparse graphs.
-
-void dijkstra(const vector<vector<pair<int, int>>>& graph, int source) {
-    int n = graph.size();
-    vector<int> distance(n, INF), previous(n, -1);
-    distance[source] = 0;
-
-    // Min-heap to store (distance, vertex) pairs
-    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> Q;
-    Q.push({0, source});
-
-    while (!Q.empty()) {
-        int dist = Q.top().first;
-        int u = Q.top().second;
-        Q.pop();
-
-        // Skip processing if we've found a better path
-        if (dist > distance[u]) continue;
-
-        for (auto& edge : graph[u]) {
-            int v = edge.first, weight = edge.second;
-
-            if (distance[u] + weight < distance[v]) {
-                distance[v] = distance[u] + weight;
-                previous[v] = u;
-                Q.push({distance[v], v});
-            }
+// Distances must agree, and every predecessor must lie on a shortest path
+bool sameShortestPaths(CSRView graph, const ShortestPaths& expected, const ShortestPaths& actual) {
+    if (expected.distance != actual.distance) return false;
+    for (int v = 0; v < graph.numVertices(); ++v) {
+        int p = actual.previous[v];
+        if (p < 0) continue;
+        bool tight = false;
+        CSRRange<int32_t> adj = graph.neighbors(p);
+        for (int64_t i = 0; i < adj.size(); ++i) {
+            tight |= adj[i] == v && actual.distance[p] + graph.weights(p)[i] == actual.distance[v];
         }
+        if (!tight) return false;
     }
+    return true;
+}
 
-    // Output the distances
-    for (int i = 0; i < n; ++i) {
-        cout << "Distance from " << source << " to " << i << " is " << distance[i] << endl;
-    }
+void compare(const char* name, const CSRGraph& graph) {
+    auto t0 = chrono::steady_clock::now();
+    ShortestPaths serial = dijkstra(graph, 0);
+    auto t1 = chrono::steady_clock::now();
+    ShortestPaths parallel = deltaStepping(graph, 0);
+    auto t2 = chrono::steady_clock::now();
+    cout << (sameShortestPaths(graph, serial, parallel) ? "Test passed: " : "Test failed: ") << name
+         << " (dijkstra " << chrono::duration<double>(t1 - t0).count() << " s, delta-stepping "
+         << chrono::duration<double>(t2 - t1).count() << " s, delta " << chooseDelta(graph)
+         << ", " << omp_get_max_threads() << " threads)" << endl;
 }
 
 int main() {
@@ -96,17 +67,19 @@ int main() {
     };
 
     int source = 0;
-    dijkstra(graph, source);
-
-    return 0;
-}
-
-
-
+    ShortestPaths paths = dijkstra(CSRGraph::fromAdjacencyList(graph), source);
 
+    // Output the distances
+    for (size_t i = 0; i < paths.distance.size(); ++i) {
+        cout << "Distance from " << source << " to " << i << " is " << paths.distance[i]
+             << " (previous " << paths.previous[i] << ")" << endl;
+    }
 
+    mt19937 rng(2024);
+    compare("road-like grid", makeGrid(700, rng));
+    compare("random graph", makeRandom(200000, 8, rng, 0, 99));
 
-// Time and Space Complexity
-// Time Complexity: O((V+E) log V), where V is the number of vertices and E is the number of edges. The log V factor comes from the operations on the priority queue.
-// Space Complexity: O(V + E) for storing the graph as an adjacency list, plus O(V) for the distance and previous arrays, resulting in O(V + E) overall.
+    return 0;
+}
 
+// Compile with: g++ -std=c++17 -O3 -fopenmp dijkstra.cpp -o dijkstra
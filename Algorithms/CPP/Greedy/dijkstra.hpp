@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// dijkstra.hpp
+
+#ifndef DIJKSTRA_HPP
+#define DIJKSTRA_HPP
+
+#include <limits>
+#include <utility>
+#include <vector>
+#include "../../../Concurrent DataStructure/CPP/Graph/CSRGraph.hpp"
+#include "indexed_heap.hpp"
+
+const int INF = std::numeric_limits<int>::max();
+
+// Result of a single-source shortest path search
+struct ShortestPaths {
+    std::vector<int> distance; // INF when unreachable
+    std::vector<int> previous; // Predecessor on a shortest path, -1 for the source and unreachable vertices
+};
+
+
+// Initialize:
+
+// For each vertex v in the graph, set distance[v] = infinity and previous[v] = undefined.
+// Set distance[source] = 0 because the distance from the source to itself is zero.
+// Create a priority queue (min-heap) Q to prioritize vertices with the smallest distance.
+
+// Main Loop:
+// While Q is not empty:
+// Remove a vertex u from Q with the smallest distance.
+// For each neighbor v of u:
+// If distance[u] + weight(u, v) < distance[v]:
+// Update distance[v] = distance[u] + weight(u, v).
+// Update previous[v] = u.
+// Update v's position in Q (decrease-key operation).
+
+// Output:
+// The distance array holds the shortest distances from the source to all vertices.
+// The previous array can be used to reconstruct the shortest paths.
+
+// Data Structures
+// Priority Queue: Implemented as a min-heap to efficiently extract the next vertex with the smallest tentative distance. This is crucial for optimizing the algorithm.
+// The queue is a template parameter (see indexed_heap.hpp): LazyBinaryHeap pushes duplicates instead of decreasing keys,
+// IndexedDaryHeap<D> and RadixHeap keep one entry per vertex with a real decrease-key.
+// CSR Graph: Each vertex's neighbors and weights are contiguous slices of two flat arrays, so relaxing a vertex is a linear scan rather than a walk over per-vertex vectors.
+
+template <typename Heap = LazyBinaryHeap>
+ShortestPaths dijkstra(CSRView graph, int source) {
+    int n = graph.numVertices();
+    ShortestPaths result;
+    std::vector<int>& distance = result.distance;
+    std::vector<int>& previous = result.previous;
+    distance.assign(n, INF);
+    previous.assign(n, -1);
+    distance[source] = 0;
+
+    // Min-heap of (distance, vertex) pairs
+    Heap Q(n);
+    Q.update(source, 0);
+
+    while (!Q.empty()) {
+        std::pair<int, int> top = Q.pop();
+        int dist = top.first;
+        int u = top.second;
+
+        // Skip processing if we've found a better path (only a lazy heap returns stale entries)
+        if (dist > distance[u]) continue;
+
+        CSRRange<int32_t> adj = graph.neighbors(u);
+        for (int64_t i = 0; i < adj.size(); ++i) {
+            // An unweighted graph counts every edge as 1
+            int v = adj[i], weight = graph.hasWeights() ? graph.weights(u)[i] : 1;
+
+            if (distance[u] + weight < distance[v]) {
+                distance[v] = distance[u] + weight;
+                previous[v] = u;
+                Q.update(v, distance[v]);
+            }
+        }
+    }
+
+    return result;
+}
+
+// Time and Space Complexity
+// Time Complexity: O((V+E) log V), where V is the number of vertices and E is the number of edges. The log V factor comes from the operations on the priority queue.
+// With LazyBinaryHeap the queue can hold O(E) entries; IndexedDaryHeap<D> is O(E log_D V + V D log_D V) with an O(V) queue,
+// and RadixHeap is O(E + V log C) for integer weights at most C.
+// Space Complexity: O(V + E) for storing the graph in CSR form, plus O(V) for the distance and previous arrays, resulting in O(V + E) overall.
+
+#endif // DIJKSTRA_HPP
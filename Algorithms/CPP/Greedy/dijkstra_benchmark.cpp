@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// Compares the priority queues of indexed_heap.hpp under dijkstra<Heap> on a
+// road-like grid, a sparse random graph and a dense random graph (where the
+// lazy heap's duplicates pile up). Each cell is the best of a few runs from
+// the same sources; every heap must reproduce the lazy heap's distances.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "dijkstra.hpp"
+#include "graph_generators.hpp"
+
+using namespace std;
+using namespace std::chrono;
+
+template <typename Heap>
+void benchmarkHeap(const string& name, const CSRGraph& graph, const vector<int>& sources,
+                   const vector<vector<int>>& expected, int repeats) {
+    double best = 1e30;
+    bool ok = true;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = steady_clock::now();
+        for (size_t s = 0; s < sources.size(); ++s) {
+            ShortestPaths paths = dijkstra<Heap>(graph, sources[s]);
+            ok &= paths.distance == expected[s];
+        }
+        best = min(best, duration<double, milli>(steady_clock::now() - start).count());
+    }
+    cout << "  " << name << ": " << best / sources.size() << " ms per query"
+         << (ok ? "" : "  (distances differ!)") << "\n";
+}
+
+void benchmarkGraph(const string& name, const CSRGraph& graph, int repeats) {
+    cout << name << " (" << graph.numVertices() << " vertices, " << graph.numEdges() << " edges)\n";
+    vector<int> sources = {0, graph.numVertices() / 2, graph.numVertices() - 1};
+    vector<vector<int>> expected;
+    for (int s : sources) expected.push_back(dijkstra<LazyBinaryHeap>(graph, s).distance);
+
+    benchmarkHeap<LazyBinaryHeap>("std::priority_queue (lazy)", graph, sources, expected, repeats);
+    benchmarkHeap<IndexedDaryHeap<2>>("indexed binary heap", graph, sources, expected, repeats);
+    benchmarkHeap<IndexedDaryHeap<4>>("indexed 4-ary heap", graph, sources, expected, repeats);
+    benchmarkHeap<IndexedDaryHeap<8>>("indexed 8-ary heap", graph, sources, expected, repeats);
+    benchmarkHeap<RadixHeap>("radix heap", graph, sources, expected, repeats);
+}
+
+int main(int argc, char** argv) {
+    // Optional argument scales the vertex counts (1 = about a million vertices per graph)
+    double scale = argc > 1 ? atof(argv[1]) : 1.0;
+    int repeats = 3;
+    mt19937 rng(7);
+
+    benchmarkGraph("Road-like grid", makeGrid((int)(1000 * sqrt(scale)), rng), repeats);
+    benchmarkGraph("Sparse random", makeRandom((int)(1000000 * scale), 4, rng), repeats);
+    benchmarkGraph("Dense random", makeRandom((int)(20000 * scale), 200, rng), repeats);
+    return 0;
+}
+
+// Compile with: g++ -std=c++17 -O3 dijkstra_benchmark.cpp -o dijkstra_benchmark
+// Run with: ./dijkstra_benchmark [scale]
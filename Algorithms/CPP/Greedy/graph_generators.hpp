@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// graph_generators.hpp
+// Weighted test graphs shared by the shortest-path programs. Weights are drawn
+// uniformly from [minWeight, maxWeight]; zero weights are allowed.
+
+#ifndef GRAPH_GENERATORS_HPP
+#define GRAPH_GENERATORS_HPP
+
+#include <random>
+#include <vector>
+#include "../../../Concurrent DataStructure/CPP/Graph/CSRGraph.hpp"
+
+// Undirected side x side grid, a stand-in for a road network: low degree, large diameter
+inline CSRGraph makeGrid(int side, std::mt19937& rng, int minWeight = 1, int maxWeight = 1000) {
+    const unsigned span = (unsigned)(maxWeight - minWeight) + 1;
+    std::vector<CSREdge> edges;
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            int v = r * side + c;
+            if (c + 1 < side) edges.push_back({v, v + 1, minWeight + (int)(rng() % span)});
+            if (r + 1 < side) edges.push_back({v, v + side, minWeight + (int)(rng() % span)});
+        }
+    }
+    return CSRGraph::fromEdgeList(side * side, edges, true, true);
+}
+
+// Directed graph with n * degree edges between uniformly random endpoints
+inline CSRGraph makeRandom(int n, int degree, std::mt19937& rng, int minWeight = 1, int maxWeight = 1000) {
+    const unsigned span = (unsigned)(maxWeight - minWeight) + 1;
+    std::vector<CSREdge> edges;
+    for (long long i = 0; i < (long long)n * degree; ++i) {
+        edges.push_back({(int)(rng() % n), (int)(rng() % n), minWeight + (int)(rng() % span)});
+    }
+    return CSRGraph::fromEdgeList(n, edges, true, false);
+}
+
+#endif // GRAPH_GENERATORS_HPP
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// indexed_heap.hpp
+// Priority queues over vertex ids 0..n-1 for dijkstra<Heap>. All three share
+// one interface:
+//   Heap(int n)           capacity for ids [0, n)
+//   bool empty()
+//   void update(v, key)   insert v, or lower its key if already queued
+//   pair<key, v> pop()    remove a minimum entry
+// LazyBinaryHeap keeps the old behaviour: update pushes a duplicate and pop may
+// return stale entries, which dijkstra skips. The indexed heaps hold each
+// vertex at most once, so their size stays O(V) instead of O(E).
+
+#ifndef INDEXED_HEAP_HPP
+#define INDEXED_HEAP_HPP
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+class LazyBinaryHeap {
+public:
+    explicit LazyBinaryHeap(int) {}
+
+    bool empty() const { return heap.empty(); }
+    void update(int v, int key) { heap.push({key, v}); }
+
+    std::pair<int, int> pop() {
+        std::pair<int, int> top = heap.top();
+        heap.pop();
+        return top;
+    }
+
+private:
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>,
+                        std::greater<std::pair<int, int>>> heap;
+};
+
+// Implicit D-ary min-heap with a position index for decrease-key. A wider node
+// makes the tree shallower, so decrease-key (sift-up) gets cheaper while pop
+// (sift-down over D children, which share a cache line for D = 4 with int keys
+// in a separate array) costs a little more; 4 is the usual sweet spot.
+template <int D = 4>
+class IndexedDaryHeap {
+    static_assert(D >= 2, "IndexedDaryHeap needs at least two children per node");
+
+public:
+    explicit IndexedDaryHeap(int n) : position(n, -1) {
+        heap.reserve(n);
+        keys.reserve(n);
+    }
+
+    bool empty() const { return heap.empty(); }
+
+    void update(int v, int key) {
+        int i = position[v];
+        if (i < 0) {
+            i = (int)heap.size();
+            heap.push_back(v);
+            keys.push_back(key);
+            position[v] = i;
+        } else if (key < keys[i]) {
+            keys[i] = key;
+        } else {
+            return;
+        }
+        siftUp(i);
+    }
+
+    std::pair<int, int> pop() {
+        std::pair<int, int> top = {keys[0], heap[0]};
+        position[heap[0]] = -1;
+        int last = (int)heap.size() - 1;
+        if (last > 0) {
+            heap[0] = heap[last];
+            keys[0] = keys[last];
+            position[heap[0]] = 0;
+        }
+        heap.pop_back();
+        keys.pop_back();
+        if (last > 0) siftDown(0);
+        return top;
+    }
+
+private:
+    std::vector<int> heap;     // Vertex ids in heap order
+    std::vector<int> keys;     // keys[i] belongs to heap[i]
+    std::vector<int> position; // Index of each vertex in heap, -1 when absent
+
+    void place(int i, int v, int key) {
+        heap[i] = v;
+        keys[i] = key;
+        position[v] = i;
+    }
+
+    void siftUp(int i) {
+        int v = heap[i], key = keys[i];
+        while (i > 0) {
+            int parent = (i - 1) / D;
+            if (keys[parent] <= key) break;
+            place(i, heap[parent], keys[parent]);
+            i = parent;
+        }
+        place(i, v, key);
+    }
+
+    void siftDown(int i) {
+        int n = (int)heap.size();
+        int v = heap[i], key = keys[i];
+        while (true) {
+            int first = i * D + 1;
+            if (first >= n) break;
+            int best = first;
+            int end = first + D < n ? first + D : n;
+            for (int c = first + 1; c < end; c++) {
+                if (keys[c] < keys[best]) best = c;
+            }
+            if (keys[best] >= key) break;
+            place(i, heap[best], keys[best]);
+            i = best;
+        }
+        place(i, v, key);
+    }
+};
+
+// Monotone radix heap (Ahuja, Mehlhorn, Orlin, Tarjan) for non-negative
+// integer keys that never drop below the last key popped, which Dijkstra
+// guarantees. Bucket b > 0 holds keys whose highest bit differing from the
+// last popped key is bit b - 1; bucket 0 holds keys equal to it. pop empties
+// the first non-empty bucket into lower ones, and each key can only move
+// down, so every entry is moved at most 33 times in total: pops cost O(log C)
+// amortized and updates O(1). Vertices are indexed, so decrease-key moves the
+// entry between buckets instead of adding a duplicate.
+class RadixHeap {
+public:
+    explicit RadixHeap(int n) : keys(n, 0), slot(n, -1), bucketOf(n, -1), last(0), count(0) {}
+
+    bool empty() const { return count == 0; }
+
+    void update(int v, int key) {
+        uint32_t k = (uint32_t)key;
+        if (slot[v] >= 0) {
+            if (k >= keys[v]) return;
+            erase(v);
+        } else {
+            count++;
+        }
+        keys[v] = k;
+        insert(v, bucketIndex(k));
+    }
+
+    std::pair<int, int> pop() {
+        if (buckets[0].empty()) {
+            int b = 1;
+            while (buckets[b].empty()) b++;
+            uint32_t lowest = UINT32_MAX;
+            for (int v : buckets[b]) {
+                if (keys[v] < lowest) lowest = keys[v];
+            }
+            last = lowest;
+            std::vector<int> moving;
+            moving.swap(buckets[b]);
+            for (int v : moving) insert(v, bucketIndex(keys[v]));
+        }
+        int v = buckets[0].back();
+        buckets[0].pop_back();
+        slot[v] = -1;
+        bucketOf[v] = -1;
+        count--;
+        return {(int)keys[v], v};
+    }
+
+private:
+    static constexpr int numBuckets = 33;
+
+    std::vector<int> buckets[numBuckets];
+    std::vector<uint32_t> keys;
+    std::vector<int> slot;     // Index of each vertex inside its bucket, -1 when absent
+    std::vector<int> bucketOf; // Bucket holding each vertex
+    uint32_t last;             // Last key popped, the lower bound of every queued key
+    int count;
+
+    int bucketIndex(uint32_t key) const {
+        uint32_t diff = key ^ last;
+        return diff == 0 ? 0 : 32 - __builtin_clz(diff);
+    }
+
+    void insert(int v, int b) {
+        slot[v] = (int)buckets[b].size();
+        bucketOf[v] = b;
+        buckets[b].push_back(v);
+    }
+
+    // Swap-with-last removal keeps buckets dense
+    void erase(int v) {
+        std::vector<int>& bucket = buckets[bucketOf[v]];
+        int moved = bucket.back();
+        bucket[slot[v]] = moved;
+        slot[moved] = slot[v];
+        bucket.pop_back();
+    }
+};
+
+#endif // INDEXED_HEAP_HPP
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// BatchedGemm.hpp
+// Many independent small products C[b] = A[b] * B[b] (or C[b] += ...) with
+// the dimensions fixed at compile time. A product of 32 x 32 or less fits in
+// L1 and is too small to pay for gemm's packing, blocking and per-call
+// allocation, so each one is computed straight from its operands: R rows of
+// C are held in vector registers while k runs over B's rows, with every loop
+// bound a template argument so the compiler unrolls the k and vector loops
+// completely. The batch, not the product, is split across threads.
+//
+// Like Gemm.hpp, the kernel is compiled for SSE2, AVX2 and AVX-512 and
+// picked by gemmIsa(); the choice is made once per batch.
+//   gemmBatched<M, K, N>(A, B, C, count)   strided batch: matrix b of A is
+//                                          the M x K row-major block at
+//                                          A + b * M * K, and so on
+//   gemmBatched(As, Bs, Cs)                vectors of Matrix<T> of one shape;
+//                                          square 4, 8, 16 and 32 use the
+//                                          fixed kernels
+
+#ifndef BATCHED_GEMM_HPP
+#define BATCHED_GEMM_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "Gemm.hpp"
+#include "Matrix.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace batched_detail {
+
+// Widest vector of at most MaxBytes that tiles a row of N elements
+template <typename T, int N, int MaxBytes>
+constexpr int rowVectorBytes() {
+    int bytes = MaxBytes;
+    while (bytes > (int)sizeof(T) && (N * (int)sizeof(T)) % bytes != 0) bytes /= 2;
+    return bytes;
+}
+
+// R consecutive rows of C from R rows of A and all of B
+template <typename T, int R, int K, int N, int VB>
+__attribute__((always_inline)) inline void rowBlock(const T* a, int64_t lda, const T* b, int64_t ldb, T* c,
+                                                    int64_t ldc, bool accumulate) {
+    typedef typename gemm_detail::VectorOf<T, VB>::type V;
+    constexpr int lanes = VB / sizeof(T);
+    constexpr int NV = N / lanes;
+    V acc[R][NV];
+#pragma GCC unroll 32
+    for (int i = 0; i < R; i++) {
+#pragma GCC unroll 32
+        for (int v = 0; v < NV; v++) {
+            if (accumulate) {
+                std::memcpy(&acc[i][v], c + i * ldc + v * lanes, sizeof(V));
+            } else {
+                acc[i][v] = V{};
+            }
+        }
+    }
+#pragma GCC unroll 32
+    for (int p = 0; p < K; p++) {
+        V bv[NV];
+#pragma GCC unroll 32
+        for (int v = 0; v < NV; v++) std::memcpy(&bv[v], b + p * ldb + v * lanes, sizeof(V));
+#pragma GCC unroll 32
+        for (int i = 0; i < R; i++) {
+            V av = a[i * lda + p] - V{}; // Broadcast
+#pragma GCC unroll 32
+            for (int v = 0; v < NV; v++) acc[i][v] += av * bv[v];
+        }
+    }
+#pragma GCC unroll 32
+    for (int i = 0; i < R; i++) {
+#pragma GCC unroll 32
+        for (int v = 0; v < NV; v++) std::memcpy(c + i * ldc + v * lanes, &acc[i][v], sizeof(V));
+    }
+}
+
+// One M x K by K x N product. Rows go in blocks of R, as many as leave the
+// accumulators and a few B vectors in the Regs vector registers.
+template <typename T, int M, int K, int N, int MaxBytes, int Regs>
+__attribute__((always_inline)) inline void product(const T* a, int64_t lda, const T* b, int64_t ldb, T* c,
+                                                   int64_t ldc, bool accumulate) {
+    constexpr int VB = rowVectorBytes<T, N, MaxBytes>();
+    constexpr int NV = N * (int)sizeof(T) / VB;
+    constexpr int R = std::max(1, std::min(M, (Regs - 4) / NV));
+    constexpr int full = M / R * R;
+#pragma GCC unroll 8
+    for (int i0 = 0; i0 < full; i0 += R) {
+        rowBlock<T, R, K, N, VB>(a + i0 * lda, lda, b, ldb, c + i0 * ldc, ldc, accumulate);
+    }
+    if constexpr (M % R != 0) {
+        rowBlock<T, M % R, K, N, VB>(a + full * lda, lda, b, ldb, c + full * ldc, ldc, accumulate);
+    }
+}
+
+// Products [begin, end) of a batch whose matrices start every strideA,
+// strideB and strideC elements and have leading dimensions lda, ldb, ldc
+struct Batch {
+    int64_t lda, ldb, ldc;
+    int64_t strideA, strideB, strideC;
+};
+
+template <typename T, int M, int K, int N, int MaxBytes, int Regs>
+__attribute__((always_inline)) inline void run(const T* A, const T* B, T* C, const Batch& s, size_t begin,
+                                               size_t end, bool accumulate) {
+    for (size_t i = begin; i < end; i++) {
+        product<T, M, K, N, MaxBytes, Regs>(A + i * s.strideA, s.lda, B + i * s.strideB, s.ldb, C + i * s.strideC,
+                                            s.ldc, accumulate);
+    }
+}
+
+template <typename T, int M, int K, int N>
+using RangeFn = void (*)(const T*, const T*, T*, const Batch&, size_t, size_t, bool);
+
+template <typename T, int M, int K, int N>
+void runSse2(const T* A, const T* B, T* C, const Batch& s, size_t begin, size_t end, bool accumulate) {
+    run<T, M, K, N, 16, 16>(A, B, C, s, begin, end, accumulate);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+template <typename T, int M, int K, int N>
+__attribute__((target("avx2,fma"))) void runAvx2(const T* A, const T* B, T* C, const Batch& s, size_t begin,
+                                                  size_t end, bool accumulate) {
+    run<T, M, K, N, 32, 16>(A, B, C, s, begin, end, accumulate);
+}
+
+template <typename T, int M, int K, int N>
+__attribute__((target("avx512f,avx512dq,fma"))) void runAvx512(const T* A, const T* B, T* C, const Batch& s,
+                                                                size_t begin, size_t end, bool accumulate) {
+    run<T, M, K, N, 64, 32>(A, B, C, s, begin, end, accumulate);
+}
+#endif
+
+template <typename T, int M, int K, int N>
+RangeFn<T, M, K, N> rangeFor(GemmIsa isa) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (isa == GemmIsa::AVX512) return runAvx512<T, M, K, N>;
+    if (isa == GemmIsa::AVX2) return runAvx2<T, M, K, N>;
+#endif
+    (void)isa;
+    return runSse2<T, M, K, N>;
+}
+
+// Splits the batch into one contiguous range per thread. Batches under about
+// a million multiply-adds stay on the calling thread, where starting a team
+// would cost more than it saves.
+template <typename T, int M, int K, int N>
+void parallelRun(const T* A, const T* B, T* C, const Batch& s, size_t count, bool accumulate, int threads) {
+    const RangeFn<T, M, K, N> range = rangeFor<T, M, K, N>(gemmIsa());
+#ifdef _OPENMP
+    if (threads <= 0) threads = omp_get_max_threads();
+    threads = (int)std::min<size_t>(threads, std::max<size_t>(1, count * M * K * N >> 20));
+    if (threads > 1) {
+#pragma omp parallel num_threads(threads)
+        {
+            const size_t t = omp_get_thread_num(), team = omp_get_num_threads();
+            range(A, B, C, s, count * t / team, count * (t + 1) / team, accumulate);
+        }
+        return;
+    }
+#else
+    (void)threads;
+#endif
+    range(A, B, C, s, 0, count, accumulate);
+}
+
+// Shapes without a fixed kernel: the i-k-j loop with a runtime bound
+template <typename T>
+void dynamicProduct(ConstMatrixView<T> A, ConstMatrixView<T> B, MatrixView<T> C, bool accumulate) {
+    if (!accumulate) C.fill(T(0));
+    for (int i = 0; i < A.rows(); i++) {
+        T* c = C.row(i);
+        for (int p = 0; p < A.cols(); p++) {
+            const T a = A(i, p);
+            const T* b = B.row(p);
+            for (int j = 0; j < B.cols(); j++) c[j] += a * b[j];
+        }
+    }
+}
+
+template <typename T, int S>
+bool runSquare(const std::vector<Matrix<T>>& A, const std::vector<Matrix<T>>& B, std::vector<Matrix<T>>& C,
+               bool accumulate, int threads) {
+    if (A[0].rows() != S || A[0].cols() != S || B[0].cols() != S) return false;
+    // Per-matrix pointers: the strides between separately allocated matrices differ
+    const size_t count = A.size();
+    const RangeFn<T, S, S, S> range = rangeFor<T, S, S, S>(gemmIsa());
+    const Batch s{A[0].stride(), B[0].stride(), C[0].stride(), 0, 0, 0};
+    (void)threads;
+#pragma omp parallel for schedule(static) num_threads(threads > 0 ? threads : omp_get_max_threads()) \
+    if (count * S * S * S >= (1 << 20))
+    for (size_t i = 0; i < count; i++) range(A[i].data(), B[i].data(), C[i].data(), s, 0, 1, accumulate);
+    return true;
+}
+
+} // namespace batched_detail
+
+// C[b] = A[b] * B[b], or C[b] += A[b] * B[b] when accumulate is set, for
+// b < count, with M x K row-major matrices packed back to back in A (then
+// K x N in B and M x N in C). threads <= 0 means omp_get_max_threads().
+template <int M, int K, int N, typename T>
+void gemmBatched(const T* A, const T* B, T* C, size_t count, bool accumulate = false, int threads = 0) {
+    static_assert(M > 0 && K > 0 && N > 0, "gemmBatched: dimensions must be positive");
+    static_assert(std::is_arithmetic<T>::value, "gemmBatched: element type must be arithmetic");
+    const batched_detail::Batch s{K, N, N, (int64_t)M * K, (int64_t)K * N, (int64_t)M * N};
+    batched_detail::parallelRun<T, M, K, N>(A, B, C, s, count, accumulate, threads);
+}
+
+// The same over vectors of matrices, which must all share one shape. C must
+// already hold A.size() matrices of the product shape and is reused as is.
+template <typename T>
+void gemmBatched(const std::vector<Matrix<T>>& A, const std::vector<Matrix<T>>& B, std::vector<Matrix<T>>& C,
+                 bool accumulate = false, int threads = 0) {
+    if (B.size() != A.size() || C.size() != A.size()) {
+        throw std::invalid_argument("gemmBatched: batches differ in length");
+    }
+    if (A.empty()) return;
+    const int m = A[0].rows(), k = A[0].cols(), n = B[0].cols();
+    if (B[0].rows() != k) throw std::invalid_argument("gemm: incompatible dimensions");
+    for (size_t i = 0; i < A.size(); i++) {
+        if (A[i].rows() != m || A[i].cols() != k || B[i].rows() != k || B[i].cols() != n || C[i].rows() != m ||
+            C[i].cols() != n) {
+            throw std::invalid_argument("gemmBatched: matrices differ in shape");
+        }
+    }
+    if (m == 0 || n == 0) return;
+    using namespace batched_detail;
+    if (runSquare<T, 4>(A, B, C, accumulate, threads) || runSquare<T, 8>(A, B, C, accumulate, threads) ||
+        runSquare<T, 16>(A, B, C, accumulate, threads) || runSquare<T, 32>(A, B, C, accumulate, threads)) {
+        return;
+    }
+    const size_t count = A.size();
+    (void)threads;
+#pragma omp parallel for schedule(static) num_threads(threads > 0 ? threads : omp_get_max_threads()) \
+    if (count * m * k * n >= (1 << 20))
+    for (size_t i = 0; i < count; i++) dynamicProduct<T>(A[i], B[i], C[i], accumulate);
+}
+
+#endif // BATCHED_GEMM_HPP
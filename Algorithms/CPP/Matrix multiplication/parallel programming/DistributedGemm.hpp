@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// DistributedGemm.hpp
+// Distributed C = A * B over MPI for matrices too large for one node.
+// Processes form an R x C grid, and every matrix is stored 2-D block-cyclic
+// as in ScaLAPACK: nb x nb block (I, J) lives on process (I mod R, J mod C),
+// so every process holds an equal share of every region of the matrix.
+//   summa:  for each block column K of A (block row K of B), the owning
+//           process column broadcasts its A panel along process rows and
+//           the owning process row broadcasts its B panel along process
+//           columns; every process then adds the panel product to its part
+//           of C. The panels for K + 1 are broadcast with MPI_Ibcast while
+//           the product for K runs. Works on any grid.
+//   cannon: on a square q x q grid, the local parts of A and B are skewed
+//           once and then shifted one step left and up q - 1 times, with
+//           each shift in flight while the previous local product runs.
+// The local products are the packed gemm from Gemm.hpp.
+
+#ifndef DISTRIBUTED_GEMM_HPP
+#define DISTRIBUTED_GEMM_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <mpi.h>
+#include <stdexcept>
+#include <vector>
+#include "Gemm.hpp"
+#include "Matrix.hpp"
+
+template <typename T>
+MPI_Datatype mpiType();
+template <>
+inline MPI_Datatype mpiType<int32_t>() { return MPI_INT32_T; }
+template <>
+inline MPI_Datatype mpiType<int64_t>() { return MPI_INT64_T; }
+template <>
+inline MPI_Datatype mpiType<float>() { return MPI_FLOAT; }
+template <>
+inline MPI_Datatype mpiType<double>() { return MPI_DOUBLE; }
+
+// R x C Cartesian grid over comm; without reordering, rank = i * C + j.
+// rows = 0 picks the largest divisor of the size not above its square root,
+// so the grid is as square as the process count allows.
+class ProcessGrid {
+public:
+    explicit ProcessGrid(MPI_Comm comm, int rows = 0) {
+        int size;
+        MPI_Comm_size(comm, &size);
+        if (rows <= 0) {
+            rows = (int)std::sqrt((double)size);
+            while (size % rows != 0) rows--;
+        }
+        if (size % rows != 0) throw std::invalid_argument("ProcessGrid: rows must divide the process count");
+        numRows = rows;
+        numCols = size / rows;
+        int dims[2] = {numRows, numCols};
+        int periods[2] = {1, 1}; // Cannon's shifts wrap around
+        MPI_Cart_create(comm, 2, dims, periods, 0, &gridComm);
+        int coord[2];
+        MPI_Comm_rank(gridComm, &myRank);
+        MPI_Cart_coords(gridComm, myRank, 2, coord);
+        row = coord[0];
+        col = coord[1];
+        // A rank's index in its row communicator is col, in its column communicator row
+        MPI_Comm_split(gridComm, row, col, &rowComm);
+        MPI_Comm_split(gridComm, col, row, &colComm);
+    }
+    ~ProcessGrid() {
+        MPI_Comm_free(&rowComm);
+        MPI_Comm_free(&colComm);
+        MPI_Comm_free(&gridComm);
+    }
+    ProcessGrid(const ProcessGrid&) = delete;
+    ProcessGrid& operator=(const ProcessGrid&) = delete;
+
+    int rows() const { return numRows; }
+    int cols() const { return numCols; }
+    int myRow() const { return row; }
+    int myCol() const { return col; }
+    int rank() const { return myRank; }
+    int rankOf(int i, int j) const { return i * numCols + j; }
+    MPI_Comm grid() const { return gridComm; }
+    MPI_Comm rowGroup() const { return rowComm; }
+    MPI_Comm colGroup() const { return colComm; }
+
+private:
+    int numRows, numCols, row, col, myRank;
+    MPI_Comm gridComm, rowComm, colComm;
+};
+
+// Number of the n global indices that block-cyclic distribution with block
+// size nb over P processes gives to process p (ScaLAPACK's NUMROC)
+inline int localExtent(int n, int nb, int p, int P) {
+    const int blocks = n / nb;
+    int extent = blocks / P * nb;
+    const int extra = blocks % P;
+    if (p < extra) {
+        extent += nb;
+    } else if (p == extra) {
+        extent += n % nb;
+    }
+    return extent;
+}
+
+// Global index of local index l on process p
+inline int globalIndex(int l, int nb, int p, int P) { return (l / nb * P + p) * nb + l % nb; }
+
+// rows x cols matrix distributed block-cyclically over a grid. Each process
+// keeps its blocks packed into one local Matrix in global order.
+template <typename T>
+class DistributedMatrix {
+public:
+    DistributedMatrix(const ProcessGrid& grid, int rows, int cols, int blockSize)
+        : grid(&grid), numRows(rows), numCols(cols), nb(blockSize),
+          part(localExtent(rows, blockSize, grid.myRow(), grid.rows()),
+               localExtent(cols, blockSize, grid.myCol(), grid.cols())) {
+        if (blockSize <= 0) throw std::invalid_argument("DistributedMatrix: block size must be positive");
+    }
+
+    // Sets every local element from value(globalRow, globalCol), so a matrix
+    // larger than one node is built without ever existing in one place
+    template <typename F>
+    void generate(F value) {
+        for (int i = 0; i < part.rows(); i++) {
+            const int gi = globalRow(i);
+            for (int j = 0; j < part.cols(); j++) part(i, j) = value(gi, globalCol(j));
+        }
+    }
+
+    // Distributes a matrix held by root; other ranks' argument is ignored
+    void scatter(const Matrix<T>& global, int root) {
+        std::vector<T> send, recv((size_t)part.rows() * part.cols());
+        std::vector<int> counts, displs;
+        if (grid->rank() == root) layout(counts, displs, send, &global);
+        MPI_Scatterv(send.data(), counts.data(), displs.data(), mpiType<T>(), recv.data(), (int)recv.size(),
+                     mpiType<T>(), root, grid->grid());
+        for (int i = 0; i < part.rows(); i++) std::copy_n(recv.data() + (size_t)i * part.cols(), part.cols(), part.row(i));
+    }
+
+    // Assembles the whole matrix on root; other ranks get an empty Matrix
+    Matrix<T> gather(int root) const {
+        std::vector<T> send((size_t)part.rows() * part.cols()), recv;
+        for (int i = 0; i < part.rows(); i++) std::copy_n(part.row(i), part.cols(), send.data() + (size_t)i * part.cols());
+        std::vector<int> counts, displs;
+        if (grid->rank() == root) layout(counts, displs, recv, nullptr);
+        MPI_Gatherv(send.data(), (int)send.size(), mpiType<T>(), recv.data(), counts.data(), displs.data(),
+                    mpiType<T>(), root, grid->grid());
+        if (grid->rank() != root) return Matrix<T>();
+        Matrix<T> global(numRows, numCols);
+        size_t offset = 0;
+        forEachRank([&](int pi, int pj, int rows, int cols) {
+            for (int i = 0; i < rows; i++) {
+                for (int j = 0; j < cols; j++) {
+                    global(globalIndex(i, nb, pi, grid->rows()), globalIndex(j, nb, pj, grid->cols())) = recv[offset++];
+                }
+            }
+        });
+        return global;
+    }
+
+    int rows() const { return numRows; }
+    int cols() const { return numCols; }
+    int blockSize() const { return nb; }
+    int globalRow(int localRow) const { return globalIndex(localRow, nb, grid->myRow(), grid->rows()); }
+    int globalCol(int localCol) const { return globalIndex(localCol, nb, grid->myCol(), grid->cols()); }
+    const ProcessGrid& processGrid() const { return *grid; }
+    Matrix<T>& local() { return part; }
+    const Matrix<T>& local() const { return part; }
+
+private:
+    // Calls f(row, col, localRows, localCols) for every process in rank order
+    template <typename F>
+    void forEachRank(F f) const {
+        for (int pi = 0; pi < grid->rows(); pi++) {
+            for (int pj = 0; pj < grid->cols(); pj++) {
+                f(pi, pj, localExtent(numRows, nb, pi, grid->rows()), localExtent(numCols, nb, pj, grid->cols()));
+            }
+        }
+    }
+
+    // Per-rank counts and offsets of the packed local parts; packs global into buffer when given
+    void layout(std::vector<int>& counts, std::vector<int>& displs, std::vector<T>& buffer,
+                const Matrix<T>* global) const {
+        size_t total = 0;
+        forEachRank([&](int, int, int rows, int cols) {
+            counts.push_back(rows * cols);
+            displs.push_back((int)total);
+            total += (size_t)rows * cols;
+        });
+        buffer.resize(total);
+        if (!global) return;
+        size_t offset = 0;
+        forEachRank([&](int pi, int pj, int rows, int cols) {
+            for (int i = 0; i < rows; i++) {
+                for (int j = 0; j < cols; j++) {
+                    buffer[offset++] = (*global)(globalIndex(i, nb, pi, grid->rows()), globalIndex(j, nb, pj, grid->cols()));
+                }
+            }
+        });
+    }
+
+    const ProcessGrid* grid;
+    int numRows;
+    int numCols;
+    int nb;
+    Matrix<T> part;
+};
+
+namespace distributed_detail {
+
+template <typename T>
+void checkOperands(const DistributedMatrix<T>& A, const DistributedMatrix<T>& B, const DistributedMatrix<T>& C) {
+    if (A.cols() != B.rows() || C.rows() != A.rows() || C.cols() != B.cols()) {
+        throw std::invalid_argument("distributed gemm: incompatible dimensions");
+    }
+    if (A.blockSize() != B.blockSize() || A.blockSize() != C.blockSize()) {
+        throw std::invalid_argument("distributed gemm: operands must share one block size");
+    }
+    if (&A.processGrid() != &B.processGrid() || &A.processGrid() != &C.processGrid()) {
+        throw std::invalid_argument("distributed gemm: operands must share one process grid");
+    }
+}
+
+// C += A * B in row chunks, testing the outstanding requests between chunks
+// so the transfers in flight keep progressing during the local product
+template <typename T>
+void multiplyWhileProgressing(ConstMatrixView<T> A, ConstMatrixView<T> B, MatrixView<T> C,
+                              std::vector<MPI_Request>& pending) {
+    const int chunks = 4;
+    const int rows = A.rows(), step = std::max(1, (rows + chunks - 1) / chunks);
+    for (int r = 0; r < rows; r += step) {
+        const int h = std::min(step, rows - r);
+        gemm<T>(A.block(r, 0, h, A.cols()), B, C.block(r, 0, h, C.cols()), true);
+        if (!pending.empty()) {
+            int done;
+            MPI_Testall((int)pending.size(), pending.data(), &done, MPI_STATUSES_IGNORE);
+        }
+    }
+}
+
+} // namespace distributed_detail
+
+// C += A * B by SUMMA on any process grid
+template <typename T>
+void summa(const DistributedMatrix<T>& A, const DistributedMatrix<T>& B, DistributedMatrix<T>& C) {
+    distributed_detail::checkOperands(A, B, C);
+    const ProcessGrid& grid = A.processGrid();
+    const int nb = A.blockSize(), k = A.cols();
+    const int panels = (k + nb - 1) / nb;
+    const Matrix<T>& localA = A.local();
+    const Matrix<T>& localB = B.local();
+    const int rowsA = localA.rows(), colsB = localB.cols();
+    Matrix<T> panelA[2] = {Matrix<T>(rowsA, nb), Matrix<T>(rowsA, nb)};
+    Matrix<T> panelB[2] = {Matrix<T>(nb, colsB), Matrix<T>(nb, colsB)};
+    std::vector<MPI_Request> requests[2];
+
+    // Panel K is local block column K / C of A on process column K mod C and
+    // local block row K / R of B on process row K mod R
+    auto broadcast = [&](int K, int slot) {
+        const int kb = std::min(nb, k - K * nb);
+        const int ownerCol = K % grid.cols(), ownerRow = K % grid.rows();
+        if (grid.myCol() == ownerCol) {
+            const int c0 = K / grid.cols() * nb;
+            for (int i = 0; i < rowsA; i++) std::copy_n(localA.row(i) + c0, kb, panelA[slot].row(i));
+        }
+        if (grid.myRow() == ownerRow) {
+            const int r0 = K / grid.rows() * nb;
+            for (int p = 0; p < kb; p++) std::copy_n(localB.row(r0 + p), colsB, panelB[slot].row(p));
+        }
+        requests[slot].assign(2, MPI_REQUEST_NULL);
+        MPI_Ibcast(panelA[slot].data(), (int)(rowsA * panelA[slot].stride()), mpiType<T>(), ownerCol, grid.rowGroup(),
+                   &requests[slot][0]);
+        MPI_Ibcast(panelB[slot].data(), (int)(kb * panelB[slot].stride()), mpiType<T>(), ownerRow, grid.colGroup(),
+                   &requests[slot][1]);
+    };
+
+    if (panels > 0) broadcast(0, 0);
+    for (int K = 0; K < panels; K++) {
+        const int slot = K % 2;
+        if (K + 1 < panels) broadcast(K + 1, 1 - slot); // Lookahead: next panels travel during this product
+        MPI_Waitall(2, requests[slot].data(), MPI_STATUSES_IGNORE);
+        const int kb = std::min(nb, k - K * nb);
+        distributed_detail::multiplyWhileProgressing<T>(panelA[slot].block(0, 0, rowsA, kb),
+                                                        panelB[slot].block(0, 0, kb, colsB), C.local(),
+                                                        requests[1 - slot]);
+    }
+}
+
+// C += A * B by Cannon's algorithm on a square process grid
+template <typename T>
+void cannon(const DistributedMatrix<T>& A, const DistributedMatrix<T>& B, DistributedMatrix<T>& C) {
+    distributed_detail::checkOperands(A, B, C);
+    const ProcessGrid& grid = A.processGrid();
+    if (grid.rows() != grid.cols()) throw std::invalid_argument("cannon: the process grid must be square");
+    const int q = grid.rows(), i = grid.myRow(), j = grid.myCol(), nb = A.blockSize();
+    const int k = A.cols();
+    auto mod = [q](int x) { return (x % q + q) % q; };
+
+    // The A part from process column r is rowsA x extent(r) and the B part
+    // from process row r is extent(r) x colsB. Buffers fit the largest
+    // extent, so every process in a row (column) shares one A (B) stride.
+    const int rowsA = A.local().rows(), colsB = B.local().cols();
+    const int kMax = localExtent(k, nb, 0, q);
+    Matrix<T> bufA[2] = {Matrix<T>(rowsA, kMax), Matrix<T>(rowsA, kMax)};
+    Matrix<T> bufB[2] = {Matrix<T>(kMax, colsB), Matrix<T>(kMax, colsB)};
+    for (int r = 0; r < rowsA; r++) std::copy_n(A.local().row(r), A.local().cols(), bufA[0].row(r));
+    for (int r = 0; r < B.local().rows(); r++) std::copy_n(B.local().row(r), colsB, bufB[0].row(r));
+
+    // Starts moving buffer cur's A part shiftA processes left and its B part
+    // shiftB processes up; heldB and incomingB are the process rows the
+    // outgoing and the arriving B parts came from
+    auto shift = [&](int cur, int shiftA, int shiftB, int heldB, int incomingB, std::vector<MPI_Request>& requests) {
+        const int next = 1 - cur;
+        const MPI_Datatype type = mpiType<T>();
+        const int countA = (int)(rowsA * bufA[0].stride());
+        requests.assign(4, MPI_REQUEST_NULL);
+        MPI_Irecv(bufA[next].data(), countA, type, grid.rankOf(i, mod(j + shiftA)), 0, grid.grid(), &requests[0]);
+        MPI_Irecv(bufB[next].data(), (int)(localExtent(k, nb, incomingB, q) * bufB[0].stride()), type,
+                  grid.rankOf(mod(i + shiftB), j), 1, grid.grid(), &requests[1]);
+        MPI_Isend(bufA[cur].data(), countA, type, grid.rankOf(i, mod(j - shiftA)), 0, grid.grid(), &requests[2]);
+        MPI_Isend(bufB[cur].data(), (int)(localExtent(k, nb, heldB, q) * bufB[0].stride()), type,
+                  grid.rankOf(mod(i - shiftB), j), 1, grid.grid(), &requests[3]);
+    };
+
+    // Skew: row i of A moves i steps left and column j of B moves j steps
+    // up, so process (i, j) holds the parts from column and row i + j
+    std::vector<MPI_Request> requests;
+    shift(0, i, j, i, mod(i + j), requests);
+    MPI_Waitall(4, requests.data(), MPI_STATUSES_IGNORE);
+    int cur = 1;
+    for (int step = 0; step < q; step++) {
+        const int r = mod(i + j + step), kr = localExtent(k, nb, r, q);
+        const bool more = step + 1 < q;
+        if (more) {
+            shift(cur, 1, 1, r, mod(r + 1), requests);
+        } else {
+            requests.clear();
+        }
+        distributed_detail::multiplyWhileProgressing<T>(bufA[cur].block(0, 0, rowsA, kr),
+                                                        bufB[cur].block(0, 0, kr, colsB), C.local(), requests);
+        if (more) {
+            MPI_Waitall(4, requests.data(), MPI_STATUSES_IGNORE);
+            cur = 1 - cur;
+        }
+    }
+}
+
+#endif // DISTRIBUTED_GEMM_HPP
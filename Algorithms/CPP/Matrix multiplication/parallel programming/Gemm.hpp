@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// Gemm.hpp
+// Packed, register-blocked GEMM in the GotoBLAS/BLIS structure:
+//   for jc over columns of C in steps of NC      B panel (KC x NC) lives in L3
+//     for pc over the shared dimension, KC        pack B[pc.., jc..] into NR-wide slivers
+//       for ic over rows of C in steps of MC     A block (MC x KC) lives in L2
+//         pack A[ic.., pc..] into MR-tall slivers
+//         for each NR sliver, for each MR sliver: micro-kernel
+// The micro-kernel keeps an MR x NR tile of C in vector registers for the
+// whole KC loop: each step loads NR/lanes vectors of B, broadcasts MR values
+// of A and issues MR * NR/lanes multiply-adds, so every load feeds several
+// FMAs and the packed operands stream from L1/L2 with unit stride. Edge tiles
+// are computed in full against zero padding and only the valid part is
+// added to C.
+//
+// The kernel is written once with GCC vector extensions and compiled three
+// times with target attributes. gemmIsa() picks the widest one the CPU
+// supports on first use:
+//   AVX-512: MR = 12, two zmm per row (12 x 32 float, 12 x 16 double),
+//            24 accumulators of 32 registers
+//   AVX2:    MR = 6, two ymm per row (6 x 16 float/int32, 6 x 8 double),
+//            12 accumulators of 16 registers
+//   SSE2:    MR = 4, two xmm per row, the x86-64 baseline and the portable
+//            path on other architectures
+
+#ifndef GEMM_HPP
+#define GEMM_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include "Matrix.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+enum class GemmIsa { SSE2, AVX2, AVX512 };
+
+namespace gemm_detail {
+
+template <typename T, int Bytes>
+struct VectorOf {
+    typedef T type __attribute__((vector_size(Bytes)));
+};
+
+// MR x (NV vectors of VB bytes) tile of C += packed A sliver * packed B sliver.
+// a holds kc columns of MR values, b holds kc rows of NR values.
+template <typename T, int MR, int NV, int VB>
+__attribute__((always_inline)) inline void microKernel(int kc, const T* __restrict a, const T* __restrict b,
+                                                       T* c, int64_t ldc, int mr, int nr) {
+    typedef typename VectorOf<T, VB>::type V;
+    constexpr int lanes = VB / sizeof(T);
+    constexpr int NR = NV * lanes;
+    V acc[MR][NV];
+    for (int i = 0; i < MR; i++) {
+        for (int v = 0; v < NV; v++) acc[i][v] = V{};
+    }
+#pragma GCC unroll 4
+    for (int p = 0; p < kc; p++) {
+        V bv[NV];
+        for (int v = 0; v < NV; v++) std::memcpy(&bv[v], b + p * NR + v * lanes, sizeof(V));
+        for (int i = 0; i < MR; i++) {
+            V av = a[p * MR + i] - V{}; // Broadcast; x - 0 is exact even for -0, unlike 0 + x
+            for (int v = 0; v < NV; v++) acc[i][v] += av * bv[v];
+        }
+    }
+    if (mr == MR && nr == NR) {
+        for (int i = 0; i < MR; i++) {
+            for (int v = 0; v < NV; v++) {
+                V cv;
+                std::memcpy(&cv, c + i * ldc + v * lanes, sizeof(V));
+                cv += acc[i][v];
+                std::memcpy(c + i * ldc + v * lanes, &cv, sizeof(V));
+            }
+        }
+        return;
+    }
+    T tile[MR][NR];
+    std::memcpy(tile, acc, sizeof(tile));
+    for (int i = 0; i < mr; i++) {
+        for (int j = 0; j < nr; j++) c[i * ldc + j] += tile[i][j];
+    }
+}
+
+template <typename T>
+using KernelFn = void (*)(int, const T*, const T*, T*, int64_t, int, int);
+
+template <typename T>
+struct KernelInfo {
+    KernelFn<T> kernel;
+    int mr;
+    int nr;
+};
+
+template <typename T>
+void kernelSse2(int kc, const T* a, const T* b, T* c, int64_t ldc, int mr, int nr) {
+    microKernel<T, 4, 2, 16>(kc, a, b, c, ldc, mr, nr);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+template <typename T>
+__attribute__((target("avx2,fma"))) void kernelAvx2(int kc, const T* a, const T* b, T* c, int64_t ldc, int mr,
+                                                     int nr) {
+    microKernel<T, 6, 2, 32>(kc, a, b, c, ldc, mr, nr);
+}
+
+template <typename T>
+__attribute__((target("avx512f,avx512dq,fma"))) void kernelAvx512(int kc, const T* a, const T* b, T* c,
+                                                                   int64_t ldc, int mr, int nr) {
+    microKernel<T, 12, 2, 64>(kc, a, b, c, ldc, mr, nr);
+}
+#endif
+
+inline GemmIsa detectIsa() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) return GemmIsa::AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return GemmIsa::AVX2;
+#endif
+    return GemmIsa::SSE2;
+}
+
+inline GemmIsa& selectedIsa() {
+    static GemmIsa isa = detectIsa();
+    return isa;
+}
+
+template <typename T>
+KernelInfo<T> kernelFor(GemmIsa isa) {
+    constexpr int perXmm = 16 / sizeof(T);
+#if defined(__x86_64__) || defined(__i386__)
+    if (isa == GemmIsa::AVX512) return {kernelAvx512<T>, 12, 2 * 64 / (int)sizeof(T)};
+    if (isa == GemmIsa::AVX2) return {kernelAvx2<T>, 6, 2 * 32 / (int)sizeof(T)};
+#endif
+    (void)isa;
+    return {kernelSse2<T>, 4, 2 * perXmm};
+}
+
+struct AlignedFree {
+    void operator()(void* p) const { std::free(p); }
+};
+
+template <typename T>
+std::unique_ptr<T, AlignedFree> alignedBuffer(size_t count) {
+    size_t bytes = (count * sizeof(T) + 63) / 64 * 64;
+    T* p = static_cast<T*>(std::aligned_alloc(64, bytes ? bytes : 64));
+    if (!p) throw std::bad_alloc();
+    return std::unique_ptr<T, AlignedFree>(p);
+}
+
+// Packing buffer number slot of the calling thread, grown on demand and kept
+// for later calls, so repeated gemms (Strassen leaves, gemmParallel
+// rectangles) do not allocate
+template <typename T>
+T* packBuffer(int slot, size_t count) {
+    thread_local std::unique_ptr<T, AlignedFree> buffers[2];
+    thread_local size_t capacity[2] = {0, 0};
+    if (capacity[slot] < count) {
+        buffers[slot] = alignedBuffer<T>(count);
+        capacity[slot] = count;
+    }
+    return buffers[slot].get();
+}
+
+// kc x nc block of B as NR-wide slivers, each kc rows of NR values, zero padded
+template <typename T>
+void packB(ConstMatrixView<T> B, int pc, int jc, int kc, int nc, int nr, T* out) {
+    for (int j0 = 0; j0 < nc; j0 += nr) {
+        int width = std::min(nr, nc - j0);
+        for (int p = 0; p < kc; p++) {
+            const T* src = B.row(pc + p) + jc + j0;
+            int j = 0;
+            for (; j < width; j++) out[j] = src[j];
+            for (; j < nr; j++) out[j] = T(0);
+            out += nr;
+        }
+    }
+}
+
+// mc x kc block of A as MR-tall slivers, each kc columns of MR values, zero padded
+template <typename T>
+void packA(ConstMatrixView<T> A, int ic, int pc, int mc, int kc, int mr, T* out) {
+    for (int i0 = 0; i0 < mc; i0 += mr) {
+        int height = std::min(mr, mc - i0);
+        for (int p = 0; p < kc; p++) {
+            int i = 0;
+            for (; i < height; i++) out[i] = A(ic + i0 + i, pc + p);
+            for (; i < mr; i++) out[i] = T(0);
+            out += mr;
+        }
+    }
+}
+
+} // namespace gemm_detail
+
+// Thread grid for gemmParallel: rows x cols threads, each owning one
+// rectangle of C. Of the factorizations of the thread count, the one with
+// the least m / rows + n / cols gives each thread the fewest rows of A and
+// columns of B to pack; ties go to more row bands, whose rectangles span
+// whole rows and so whole pages of C.
+struct GemmGrid {
+    int rows;
+    int cols;
+};
+
+inline GemmGrid gemmGrid(int threads, int m, int n) {
+    GemmGrid best{threads, 1};
+    double bestCost = -1;
+    for (int r = threads; r >= 1; r--) {
+        if (threads % r != 0) continue;
+        double cost = (double)m / r + (double)n / (threads / r);
+        if (bestCost < 0 || cost < bestCost) {
+            best = {r, threads / r};
+            bestCost = cost;
+        }
+    }
+    return best;
+}
+
+// Blocking sizes: a KC x NR sliver of B plus an MR x KC sliver of A stay in
+// L1, the MC x KC block of A in L2 and the KC x NC panel of B in L3
+struct GemmBlocking {
+    int mc = 192; // Rounded down to a multiple of MR
+    int kc = 256;
+    int nc = 4096;
+};
+
+// Kernel used by gemm from now on; forcing a wider ISA than the CPU has faults
+inline GemmIsa gemmIsa() { return gemm_detail::selectedIsa(); }
+inline void gemmForceIsa(GemmIsa isa) { gemm_detail::selectedIsa() = isa; }
+inline const char* gemmIsaName(GemmIsa isa) {
+    return isa == GemmIsa::AVX512 ? "AVX-512" : isa == GemmIsa::AVX2 ? "AVX2" : "SSE2";
+}
+
+// C = A * B, or C += A * B when accumulate is set. C must not overlap A or B.
+template <typename T>
+void gemm(ConstMatrixView<T> A, ConstMatrixView<T> B, MatrixView<T> C, bool accumulate = false,
+          const GemmBlocking& blocking = {}) {
+    const int m = A.rows(), k = A.cols(), n = B.cols();
+    if (B.rows() != k || C.rows() != m || C.cols() != n) {
+        throw std::invalid_argument("gemm: incompatible dimensions");
+    }
+    if (!accumulate) C.fill(T(0));
+    if (m == 0 || n == 0 || k == 0) return;
+
+    const gemm_detail::KernelInfo<T> info = gemm_detail::kernelFor<T>(gemmIsa());
+    const int mr = info.mr, nr = info.nr;
+    const int mcMax = std::max(mr, blocking.mc / mr * mr);
+    const int kcMax = std::max(1, blocking.kc);
+    const int ncMax = std::max(nr, blocking.nc / nr * nr);
+    const size_t kcUsed = std::min(kcMax, k);
+    T* packedA = gemm_detail::packBuffer<T>(0, (size_t)std::min(mcMax, (m + mr - 1) / mr * mr) * kcUsed);
+    T* packedB = gemm_detail::packBuffer<T>(1, (size_t)std::min(ncMax, (n + nr - 1) / nr * nr) * kcUsed);
+
+    for (int jc = 0; jc < n; jc += ncMax) {
+        const int nc = std::min(ncMax, n - jc);
+        for (int pc = 0; pc < k; pc += kcMax) {
+            const int kc = std::min(kcMax, k - pc);
+            gemm_detail::packB(B, pc, jc, kc, nc, nr, packedB);
+            for (int ic = 0; ic < m; ic += mcMax) {
+                const int mc = std::min(mcMax, m - ic);
+                gemm_detail::packA(A, ic, pc, mc, kc, mr, packedA);
+                for (int jr = 0; jr < nc; jr += nr) {
+                    const T* b = packedB + (size_t)jr * kc;
+                    for (int ir = 0; ir < mc; ir += mr) {
+                        info.kernel(kc, packedA + (size_t)ir * kc, b, &C(ic + ir, jc + jr), C.stride(),
+                                    std::min(mr, mc - ir), std::min(nr, nc - jr));
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+Matrix<T> gemm(const Matrix<T>& A, const Matrix<T>& B) {
+    if (A.cols() != B.rows()) throw std::invalid_argument("gemm: incompatible dimensions");
+    Matrix<T> C(A.rows(), B.cols());
+    gemm<T>(A, B, C.view(), true);
+    return C;
+}
+
+// Parallel C = A * B, or C += A * B when accumulate is set. C is cut into a
+// fixed gemmGrid of rectangles on MR x NR tile boundaries and thread t
+// computes rectangle t (and t + team size, ... if the team came up short)
+// with the serial gemm and its own packing buffers, so no element has two
+// writers and no atomics or reductions are needed. The
+// team is bound with proc_bind(spread) and the schedule is static, so the
+// thread that zeroes a rectangle is the one that later updates it: allocate
+// C with Matrix<T>::uninitialized and its pages are first-touched on the
+// NUMA node of the core that uses them. threads <= 0 means
+// omp_get_max_threads(); without OpenMP this runs serially.
+template <typename T>
+void gemmParallel(ConstMatrixView<T> A, ConstMatrixView<T> B, MatrixView<T> C, bool accumulate = false,
+                  int threads = 0, const GemmBlocking& blocking = {}) {
+    const int m = A.rows(), k = A.cols(), n = B.cols();
+    if (B.rows() != k || C.rows() != m || C.cols() != n) {
+        throw std::invalid_argument("gemm: incompatible dimensions");
+    }
+    if (m == 0 || n == 0) return;
+
+    const gemm_detail::KernelInfo<T> info = gemm_detail::kernelFor<T>(gemmIsa());
+    const int64_t rowTiles = (m + info.mr - 1) / info.mr;
+    const int64_t colTiles = (n + info.nr - 1) / info.nr;
+#ifdef _OPENMP
+    if (threads <= 0) threads = omp_get_max_threads();
+#else
+    threads = 1;
+#endif
+    threads = (int)std::max<int64_t>(1, std::min<int64_t>(threads, rowTiles * colTiles));
+    GemmGrid grid = gemmGrid(threads, m, n);
+    // A grid wider or taller than the tile count would leave threads idle
+    while (grid.rows > rowTiles || grid.cols > colTiles) grid = gemmGrid(--threads, m, n);
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threads) proc_bind(spread)
+#endif
+    {
+#ifdef _OPENMP
+        const int t = omp_get_thread_num(), team = omp_get_num_threads();
+#else
+        const int t = 0, team = 1;
+#endif
+        // OpenMP may grant fewer threads than asked for (nested regions,
+        // OMP_THREAD_LIMIT), so every rectangle is visited by stride
+        for (int r = t; r < grid.rows * grid.cols; r += team) {
+            const int tr = r / grid.cols, tc = r % grid.cols;
+            const int r0 = (int)std::min<int64_t>(m, rowTiles * tr / grid.rows * info.mr);
+            const int r1 = (int)std::min<int64_t>(m, rowTiles * (tr + 1) / grid.rows * info.mr);
+            const int c0 = (int)std::min<int64_t>(n, colTiles * tc / grid.cols * info.nr);
+            const int c1 = (int)std::min<int64_t>(n, colTiles * (tc + 1) / grid.cols * info.nr);
+            gemm<T>(A.block(r0, 0, r1 - r0, k), B.block(0, c0, k, c1 - c0), C.block(r0, c0, r1 - r0, c1 - c0),
+                    accumulate, blocking);
+        }
+    }
+}
+
+template <typename T>
+Matrix<T> gemmParallel(const Matrix<T>& A, const Matrix<T>& B, int threads = 0) {
+    if (A.cols() != B.rows()) throw std::invalid_argument("gemm: incompatible dimensions");
+    Matrix<T> C = Matrix<T>::uninitialized(A.rows(), B.cols());
+    gemmParallel<T>(A, B, C.view(), false, threads);
+    return C;
+}
+
+#endif // GEMM_HPP
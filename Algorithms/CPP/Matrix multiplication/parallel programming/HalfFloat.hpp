@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// HalfFloat.hpp
+// 16-bit floating-point storage types for mixed-precision GEMM. Both only
+// store bits and convert to and from float; arithmetic happens in float.
+//   bfloat16: the top half of a binary32 (8-bit exponent, 7-bit mantissa),
+//             the same range as float with less precision.
+//   float16:  IEEE 754 binary16 (5-bit exponent, 10-bit mantissa),
+//             finite values up to 65504 and subnormals down to 2^-24.
+// Conversions from float round to nearest, ties to even. == compares bits.
+
+#ifndef HALF_FLOAT_HPP
+#define HALF_FLOAT_HPP
+
+#include <cstdint>
+#include <cstring>
+
+struct bfloat16 {
+    uint16_t bits;
+
+    bfloat16() = default;
+    explicit bfloat16(float value) : bits(fromFloat(value)) {}
+    explicit operator float() const {
+        uint32_t x = (uint32_t)bits << 16;
+        float f;
+        std::memcpy(&f, &x, sizeof(f));
+        return f;
+    }
+    bool operator==(bfloat16 other) const { return bits == other.bits; }
+    bool operator!=(bfloat16 other) const { return bits != other.bits; }
+
+    static uint16_t fromFloat(float value) {
+        uint32_t x;
+        std::memcpy(&x, &value, sizeof(x));
+        if ((x & 0x7fffffff) > 0x7f800000) return (uint16_t)((x >> 16) | 0x40); // Keep NaN a quiet NaN
+        x += 0x7fff + ((x >> 16) & 1);
+        return (uint16_t)(x >> 16);
+    }
+};
+
+struct float16 {
+    uint16_t bits;
+
+    float16() = default;
+    explicit float16(float value) : bits(fromFloat(value)) {}
+    explicit operator float() const { return toFloat(bits); }
+    bool operator==(float16 other) const { return bits == other.bits; }
+    bool operator!=(float16 other) const { return bits != other.bits; }
+
+    static float toFloat(uint16_t h) {
+        const uint32_t sign = (uint32_t)(h & 0x8000) << 16;
+        const uint32_t exponent = (h >> 10) & 0x1f, mantissa = h & 0x3ff;
+        uint32_t x;
+        if (exponent == 0) {
+            float f = (float)mantissa * 5.9604644775390625e-8f; // Zero or subnormal: mantissa * 2^-24
+            std::memcpy(&x, &f, sizeof(x));
+            x |= sign;
+        } else if (exponent == 31) {
+            x = sign | 0x7f800000 | (mantissa << 13); // Infinity or NaN
+        } else {
+            x = sign | ((exponent + 112) << 23) | (mantissa << 13);
+        }
+        float f;
+        std::memcpy(&f, &x, sizeof(f));
+        return f;
+    }
+
+    static uint16_t fromFloat(float value) {
+        uint32_t x;
+        std::memcpy(&x, &value, sizeof(x));
+        const uint16_t sign = (uint16_t)((x >> 16) & 0x8000);
+        const uint32_t magnitude = x & 0x7fffffff;
+        if (magnitude >= 0x7f800000) return sign | (magnitude > 0x7f800000 ? 0x7e00 : 0x7c00);
+        if (magnitude >= 0x477ff000) return sign | 0x7c00; // 65520 and above round to infinity
+        if (magnitude < 0x38800000) {
+            // Below 2^-14: a subnormal in units of 2^-24, or zero below 2^-25
+            if (magnitude < 0x33000000) return sign;
+            const uint32_t mantissa = (magnitude & 0x7fffff) | 0x800000;
+            const int shift = 126 - (int)(magnitude >> 23);
+            uint32_t h = mantissa >> shift;
+            const uint32_t rest = mantissa & ((1u << shift) - 1), half = 1u << (shift - 1);
+            if (rest > half || (rest == half && (h & 1))) h++;
+            return sign | (uint16_t)h;
+        }
+        uint32_t h = (magnitude - 0x38000000) >> 13; // Rebias the exponent from 127 to 15
+        const uint32_t rest = magnitude & 0x1fff;
+        if (rest > 0x1000 || (rest == 0x1000 && (h & 1))) h++; // A carry rounds up into the exponent
+        return sign | (uint16_t)h;
+    }
+};
+
+#endif // HALF_FLOAT_HPP
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// Matrix.hpp
+// Dense row-major matrix in one 64-byte aligned buffer. Rows are padded to a
+// multiple of 64 bytes, so every row starts on a cache line and element
+// (i, j) is data[i * stride + j]: one multiply-add instead of the two
+// dependent loads of vector<vector<T>>. MatrixView and ConstMatrixView are
+// non-owning windows (pointer, rows, cols, stride); block() returns a
+// submatrix view into the same storage, so recursive algorithms split a
+// matrix into quadrants without copying.
+
+#ifndef MATRIX_HPP
+#define MATRIX_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include "HalfFloat.hpp"
+
+template <typename T>
+class MatrixView {
+public:
+    MatrixView() : ptr(nullptr), numRows(0), numCols(0), ld(0) {}
+    MatrixView(T* data, int rows, int cols, int64_t stride)
+        : ptr(data), numRows(rows), numCols(cols), ld(stride) {}
+
+    T& operator()(int i, int j) const { return ptr[i * ld + j]; }
+    T* row(int i) const { return ptr + i * ld; }
+
+    // rows x cols window whose top-left element is (row0, col0)
+    MatrixView block(int row0, int col0, int rows, int cols) const {
+        return MatrixView(ptr + row0 * ld + col0, rows, cols, ld);
+    }
+
+    void fill(T value) const {
+        for (int i = 0; i < numRows; i++) std::fill(row(i), row(i) + numCols, value);
+    }
+
+    int rows() const { return numRows; }
+    int cols() const { return numCols; }
+    int64_t stride() const { return ld; }
+    T* data() const { return ptr; }
+
+private:
+    T* ptr;
+    int numRows;
+    int numCols;
+    int64_t ld;
+};
+
+template <typename T>
+class ConstMatrixView {
+public:
+    ConstMatrixView() : ptr(nullptr), numRows(0), numCols(0), ld(0) {}
+    ConstMatrixView(const T* data, int rows, int cols, int64_t stride)
+        : ptr(data), numRows(rows), numCols(cols), ld(stride) {}
+    ConstMatrixView(MatrixView<T> view)
+        : ptr(view.data()), numRows(view.rows()), numCols(view.cols()), ld(view.stride()) {}
+
+    const T& operator()(int i, int j) const { return ptr[i * ld + j]; }
+    const T* row(int i) const { return ptr + i * ld; }
+
+    ConstMatrixView block(int row0, int col0, int rows, int cols) const {
+        return ConstMatrixView(ptr + row0 * ld + col0, rows, cols, ld);
+    }
+
+    int rows() const { return numRows; }
+    int cols() const { return numCols; }
+    int64_t stride() const { return ld; }
+    const T* data() const { return ptr; }
+
+private:
+    const T* ptr;
+    int numRows;
+    int numCols;
+    int64_t ld;
+};
+
+template <typename T>
+class Matrix {
+    static_assert(std::is_same<T, int32_t>::value || std::is_same<T, int64_t>::value ||
+                      std::is_same<T, float>::value || std::is_same<T, double>::value ||
+                      std::is_same<T, int8_t>::value || std::is_same<T, int16_t>::value ||
+                      std::is_same<T, bfloat16>::value || std::is_same<T, float16>::value,
+                  "Matrix supports int32_t, int64_t, float and double elements, and int8_t, int16_t, "
+                  "bfloat16 and float16 as mixed-precision GEMM inputs");
+
+public:
+    static constexpr size_t alignment = 64;
+
+    Matrix() : numRows(0), numCols(0), ld(0) {}
+
+    // Zero-initialized rows x cols matrix
+    Matrix(int rows, int cols) : numRows(rows), numCols(cols), ld(paddedStride(cols)) {
+        if (rows < 0 || cols < 0) throw std::invalid_argument("Matrix: negative dimension");
+        buffer.reset(allocate((size_t)rows * ld));
+        if (buffer) std::memset(buffer.get(), 0, (size_t)rows * ld * sizeof(T));
+    }
+
+    // rows x cols matrix whose buffer is allocated but never written, so each
+    // page is placed on the NUMA node of the thread that first stores to it.
+    // Callers must write every element before reading it.
+    static Matrix uninitialized(int rows, int cols) { return Matrix(rows, cols, NoInit()); }
+
+    Matrix(std::initializer_list<std::initializer_list<T>> values)
+        : Matrix((int)values.size(), values.size() ? (int)values.begin()->size() : 0) {
+        int i = 0;
+        for (const auto& r : values) {
+            if ((int)r.size() != numCols) throw std::invalid_argument("Matrix: rows of different lengths");
+            std::copy(r.begin(), r.end(), row(i++));
+        }
+    }
+
+    Matrix(const Matrix& other) : Matrix(other.numRows, other.numCols) {
+        if (buffer) std::memcpy(buffer.get(), other.buffer.get(), (size_t)numRows * ld * sizeof(T));
+    }
+    Matrix(Matrix&& other) noexcept
+        : numRows(other.numRows), numCols(other.numCols), ld(other.ld), buffer(std::move(other.buffer)) {
+        other.numRows = other.numCols = 0;
+        other.ld = 0;
+    }
+    Matrix& operator=(const Matrix& other) {
+        if (this != &other) *this = Matrix(other);
+        return *this;
+    }
+    Matrix& operator=(Matrix&& other) noexcept {
+        numRows = other.numRows;
+        numCols = other.numCols;
+        ld = other.ld;
+        buffer = std::move(other.buffer);
+        other.numRows = other.numCols = 0;
+        other.ld = 0;
+        return *this;
+    }
+
+    T& operator()(int i, int j) { return buffer[i * ld + j]; }
+    const T& operator()(int i, int j) const { return buffer[i * ld + j]; }
+    T* row(int i) { return buffer.get() + i * ld; }
+    const T* row(int i) const { return buffer.get() + i * ld; }
+
+    MatrixView<T> view() { return MatrixView<T>(buffer.get(), numRows, numCols, ld); }
+    ConstMatrixView<T> view() const { return ConstMatrixView<T>(buffer.get(), numRows, numCols, ld); }
+    operator MatrixView<T>() { return view(); }
+    operator ConstMatrixView<T>() const { return view(); }
+
+    MatrixView<T> block(int row0, int col0, int rows, int cols) { return view().block(row0, col0, rows, cols); }
+    ConstMatrixView<T> block(int row0, int col0, int rows, int cols) const {
+        return view().block(row0, col0, rows, cols);
+    }
+
+    int rows() const { return numRows; }
+    int cols() const { return numCols; }
+    bool empty() const { return numRows == 0 || numCols == 0; }
+    int64_t stride() const { return ld; }
+    T* data() { return buffer.get(); }
+    const T* data() const { return buffer.get(); }
+
+    bool operator==(const Matrix& other) const {
+        if (numRows != other.numRows || numCols != other.numCols) return false;
+        for (int i = 0; i < numRows; i++) {
+            if (!std::equal(row(i), row(i) + numCols, other.row(i))) return false;
+        }
+        return true;
+    }
+    bool operator!=(const Matrix& other) const { return !(*this == other); }
+
+    // Elements per row including padding: the smallest multiple of 64 bytes
+    static int64_t paddedStride(int cols) {
+        const int64_t perLine = alignment / sizeof(T);
+        return (cols + perLine - 1) / perLine * perLine;
+    }
+
+private:
+    struct NoInit {};
+
+    Matrix(int rows, int cols, NoInit) : numRows(rows), numCols(cols), ld(paddedStride(cols)) {
+        if (rows < 0 || cols < 0) throw std::invalid_argument("Matrix: negative dimension");
+        buffer.reset(allocate((size_t)rows * ld));
+    }
+
+    struct Free {
+        void operator()(T* p) const { std::free(p); }
+    };
+
+    static T* allocate(size_t count) {
+        if (count == 0) return nullptr;
+        size_t bytes = (count * sizeof(T) + alignment - 1) / alignment * alignment;
+        T* p = static_cast<T*>(std::aligned_alloc(alignment, bytes));
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+
+    int numRows;
+    int numCols;
+    int64_t ld;
+    std::unique_ptr<T[], Free> buffer;
+};
+
+#endif // MATRIX_HPP
@@ -23,21 +23,29 @@
 #include <random>
 #include <omp.h> // Include the OpenMP header
 #include <chrono>
+#include "Matrix.hpp"
+#include "Gemm.hpp"
+#include "Strassen.hpp"
 
 using namespace std;
 using namespace std::chrono;
 
+// All kernels take and return Matrix<T> (contiguous, 64-byte aligned rows) for
+// T = int32_t, int64_t, float or double; the recursive ones split their
+// operands into quadrants with block() views instead of copying them.
+
 // 1. Basic Matrix Multiplication
 // Function to multiply two matrices
-vector<vector<int>> multiplyMatrices(const vector<vector<int>> &matrix1, const vector<vector<int>> &matrix2)
+template <typename T>
+Matrix<T> multiplyMatrices(const Matrix<T> &matrix1, const Matrix<T> &matrix2)
 {
     if (matrix1.empty() || matrix2.empty())
         return {};
 
-    int rows1 = matrix1.size();
-    int cols1 = matrix1[0].size();
-    int rows2 = matrix2.size();
-    int cols2 = matrix2[0].size();
+    int rows1 = matrix1.rows();
+    int cols1 = matrix1.cols();
+    int rows2 = matrix2.rows();
+    int cols2 = matrix2.cols();
 
     // Check if multiplication is possible
     if (cols1 != rows2)
@@ -46,7 +54,7 @@ vector<vector<int>> multiplyMatrices(const vector<vector<int>> &matrix1, const v
     }
 
     // Initialize the result matrix with 0s
-    vector<vector<int>> result(rows1, vector<int>(cols2, 0));
+    Matrix<T> result(rows1, cols2);
 
     // Perform multiplication
     for (int i = 0; i < rows1; i++)
@@ -55,7 +63,7 @@ vector<vector<int>> multiplyMatrices(const vector<vector<int>> &matrix1, const v
         {
             for (int k = 0; k < cols1; k++)
             {
-                result[i][j] += matrix1[i][k] * matrix2[k][j];
+                result(i, j) += matrix1(i, k) * matrix2(k, j);
             }
         }
     }
@@ -65,16 +73,17 @@ vector<vector<int>> multiplyMatrices(const vector<vector<int>> &matrix1, const v
 
 // 2. Cache Friendly
 // Function to multiply two matrices using loop tiling
-vector<vector<int>> multiplyMatricesCacheFriendly(const vector<vector<int>> &matrix1, const vector<vector<int>> &matrix2)
+template <typename T>
+Matrix<T> multiplyMatricesCacheFriendly(const Matrix<T> &matrix1, const Matrix<T> &matrix2)
 {
     const int BLOCK_SIZE = 128; // Example block size, adjust based on system's cache
     if (matrix1.empty() || matrix2.empty())
         return {};
 
-    int rows1 = matrix1.size();
-    int cols1 = matrix1[0].size();
-    int rows2 = matrix2.size();
-    int cols2 = matrix2[0].size();
+    int rows1 = matrix1.rows();
+    int cols1 = matrix1.cols();
+    int rows2 = matrix2.rows();
+    int cols2 = matrix2.cols();
 
     // Check if multiplication is possible
     if (cols1 != rows2)
@@ -83,9 +92,10 @@ vector<vector<int>> multiplyMatricesCacheFriendly(const vector<vector<int>> &mat
     }
 
     // Initialize the result matrix with 0s
-    vector<vector<int>> result(rows1, vector<int>(cols2, 0));
+    Matrix<T> result(rows1, cols2);
 
     // Perform multiplication with loop tiling
+    // The innermost loop runs over contiguous rows of result and matrix2, so it vectorizes
 
     for (int k0 = 0; k0 < cols1; k0 += BLOCK_SIZE)
     {
@@ -95,11 +105,14 @@ vector<vector<int>> multiplyMatricesCacheFriendly(const vector<vector<int>> &mat
             {
                 for (int k = k0; k < min(k0 + BLOCK_SIZE, cols1); ++k)
                 {
+                    const T *rowB = matrix2.row(k);
                     for (int i = i0; i < min(i0 + BLOCK_SIZE, rows1); ++i)
                     {
+                        T a = matrix1(i, k);
+                        T *rowC = result.row(i);
                         for (int j = j0; j < min(j0 + BLOCK_SIZE, cols2); ++j)
                         {
-                            result[i][j] += matrix1[i][k] * matrix2[k][j];
+                            rowC[j] += a * rowB[j];
                         }
                     }
                 }
@@ -111,112 +124,22 @@ vector<vector<int>> multiplyMatricesCacheFriendly(const vector<vector<int>> &mat
 }
 
 // 3. Strassen's Algorithm
-// Function to add two matrices
-vector<vector<int>> add(const vector<vector<int>> &A, const vector<vector<int>> &B)
-{
-    int n = A.size();
-    vector<vector<int>> C(n, vector<int>(n, 0));
-    for (int i = 0; i < n; i++)
-    {
-        for (int j = 0; j < n; j++)
-        {
-            C[i][j] = A[i][j] + B[i][j];
-        }
-    }
-    return C;
-}
-
-// Function to subtract two matrices
-vector<vector<int>> subtract(const vector<vector<int>> &A, const vector<vector<int>> &B)
-{
-    int n = A.size();
-    vector<vector<int>> C(n, vector<int>(n, 0));
-    for (int i = 0; i < n; i++)
-    {
-        for (int j = 0; j < n; j++)
-        {
-            C[i][j] = A[i][j] - B[i][j];
-        }
-    }
-    return C;
-}
-
-// Strassen's algorithm for matrix multiplication
-vector<vector<int>> strassenMultiply(const vector<vector<int>> &A, const vector<vector<int>> &B)
-{
-    int n = A.size();
-    vector<vector<int>> C(n, vector<int>(n, 0));
-
-    // Base case: 1x1 matrix
-    if (n == 1)
-    {
-        C[0][0] = A[0][0] * B[0][0];
-        return C;
-    }
-
-    // Divide matrices into quarters
-    int k = n / 2;
-    vector<vector<int>> A11(k, vector<int>(k)), A12(k, vector<int>(k)),
-        A21(k, vector<int>(k)), A22(k, vector<int>(k)),
-        B11(k, vector<int>(k)), B12(k, vector<int>(k)),
-        B21(k, vector<int>(k)), B22(k, vector<int>(k));
-
-    for (int i = 0; i < k; i++)
-    {
-        for (int j = 0; j < k; j++)
-        {
-            A11[i][j] = A[i][j];
-            A12[i][j] = A[i][j + k];
-            A21[i][j] = A[i + k][j];
-            A22[i][j] = A[i + k][j + k];
-            B11[i][j] = B[i][j];
-            B12[i][j] = B[i][j + k];
-            B21[i][j] = B[i + k][j];
-            B22[i][j] = B[i + k][j + k];
-        }
-    }
-
-    // Recursively calculate the 7 products using Strassen's formula
-    auto P1 = strassenMultiply(A11, subtract(B12, B22));
-    auto P2 = strassenMultiply(add(A11, A12), B22);
-    auto P3 = strassenMultiply(add(A21, A22), B11);
-    auto P4 = strassenMultiply(A22, subtract(B21, B11));
-    auto P5 = strassenMultiply(add(A11, A22), add(B11, B22));
-    auto P6 = strassenMultiply(subtract(A12, A22), add(B21, B22));
-    auto P7 = strassenMultiply(subtract(A11, A21), add(B11, B12));
-
-    // Calculate the final quarters of the result matrix
-    auto C11 = add(subtract(add(P5, P4), P2), P6);
-    auto C12 = add(P1, P2);
-    auto C21 = add(P3, P4);
-    auto C22 = subtract(subtract(add(P1, P5), P3), P7);
-
-    // Combine the quarters into the final result matrix
-    for (int i = 0; i < k; i++)
-    {
-        for (int j = 0; j < k; j++)
-        {
-            C[i][j] = C11[i][j];
-            C[i][j + k] = C12[i][j];
-            C[i + k][j] = C21[i][j];
-            C[i + k][j + k] = C22[i][j];
-        }
-    }
-
-    return C;
-}
+// strassenMultiply (Strassen.hpp) is Strassen-Winograd on views with one
+// preallocated workspace, odd-size peeling, task-parallel top levels and the
+// packed gemm below a 512 cutoff
 
 // 4.  parallel basic matrix multiplication
 // Function to multiply two matrices in parallel using OpenMP
-vector<vector<int>> parallelMatrixMultiply(const vector<vector<int>> &matrix1, const vector<vector<int>> &matrix2)
+template <typename T>
+Matrix<T> parallelMatrixMultiply(const Matrix<T> &matrix1, const Matrix<T> &matrix2)
 {
     if (matrix1.empty() || matrix2.empty())
         return {};
 
-    int rows1 = matrix1.size();
-    int cols1 = matrix1[0].size();
-    int rows2 = matrix2.size();
-    int cols2 = matrix2[0].size();
+    int rows1 = matrix1.rows();
+    int cols1 = matrix1.cols();
+    int rows2 = matrix2.rows();
+    int cols2 = matrix2.cols();
 
     // Check if multiplication is possible
     if (cols1 != rows2)
@@ -224,18 +147,20 @@ vector<vector<int>> parallelMatrixMultiply(const vector<vector<int>> &matrix1, c
         throw invalid_argument("Matrices cannot be multiplied due to incompatible dimensions.");
     }
 
-    vector<vector<int>> result(rows1, vector<int>(cols2, 0));
+    Matrix<T> result(rows1, cols2);
 
-#pragma omp parallel for collapse(2) // Parallelize the outer two loops
+    // Each thread owns whole rows of the result, so no write needs an atomic
+#pragma omp parallel for schedule(static)
     for (int i = 0; i < rows1; i++)
     {
+        T *rowResult = result.row(i);
         for (int k = 0; k < cols1; k++)
         {
+            T a = matrix1(i, k);
+            const T *rowB = matrix2.row(k);
             for (int j = 0; j < cols2; j++)
             {
-
-#pragma omp atomic // Protects the write operation
-                result[i][j] += matrix1[i][k] * matrix2[k][j];
+                rowResult[j] += a * rowB[j];
             }
         }
     }
@@ -243,29 +168,35 @@ vector<vector<int>> parallelMatrixMultiply(const vector<vector<int>> &matrix1, c
     return result;
 }
 
-// 5. Cannon's algorithm for parallel matrix multiplication
-// Simple function to perform block-wise multiplication of two matrices
-vector<vector<int>> blockWiseMultiply(const vector<vector<int>> &A, const vector<vector<int>> &B)
+// 5. Block-wise (tiled) shared-memory matrix multiplication
+// The distributed algorithms this is sometimes confused with, SUMMA and
+// Cannon's, are summa() and cannon() in DistributedGemm.hpp
+template <typename T>
+Matrix<T> blockWiseMultiply(const Matrix<T> &A, const Matrix<T> &B)
 {
     const int BLOCK_SIZE = 64; // Adjust based on cache size
-    int n = A.size();
-    vector<vector<int>> C(n, vector<int>(n, 0));
+    int n = A.rows();
+    Matrix<T> C(n, n);
 
-#pragma omp parallel for collapse(2) shared(A, B, C)
-
-    for (int k0 = 0; k0 < n; k0 += BLOCK_SIZE)
+    // Threads split the (i0, j0) output tiles and each walks k0 over its own
+    // tile, so every C element is updated by exactly one thread
+#pragma omp parallel for collapse(2) schedule(static) shared(A, B, C)
+    for (int i0 = 0; i0 < n; i0 += BLOCK_SIZE)
     {
-        for (int i0 = 0; i0 < n; i0 += BLOCK_SIZE)
+        for (int j0 = 0; j0 < n; j0 += BLOCK_SIZE)
         {
-            for (int j0 = 0; j0 < n; j0 += BLOCK_SIZE)
+            for (int k0 = 0; k0 < n; k0 += BLOCK_SIZE)
             {
                 for (int i = i0; i < min(i0 + BLOCK_SIZE, n); ++i)
                 {
+                    T *rowC = C.row(i);
                     for (int k = k0; k < min(k0 + BLOCK_SIZE, n); ++k)
                     {
+                        T a = A(i, k);
+                        const T *rowB = B.row(k);
                         for (int j = j0; j < min(j0 + BLOCK_SIZE, n); ++j)
                         {
-                            C[i][j] += A[i][k] * B[k][j];
+                            rowC[j] += a * rowB[j];
                         }
                     }
                 }
@@ -277,136 +208,89 @@ vector<vector<int>> blockWiseMultiply(const vector<vector<int>> &A, const vector
 }
 
 // 6. matrix multiplication using the fork-join model in shared-memory parallelism
-// Helper function to create a submatrix
-vector<vector<int>> getSubmatrix(const vector<vector<int>> &matrix, int rowStart, int colStart, int size)
+// C += A * B by halving the largest of m, k and n. Splitting m or n gives two
+// products that write disjoint halves of C, so they run as tasks; splitting k
+// gives two products into the same C, so they run one after the other. Every
+// half is a view, nothing is allocated, any size works, and blocks of at most
+// FORK_JOIN_LEAF in every dimension go to the packed gemm.
+const int FORK_JOIN_LEAF = 128;
+
+template <typename T>
+void multiplyRecursive(ConstMatrixView<T> A, ConstMatrixView<T> B, MatrixView<T> C)
 {
-    vector<vector<int>> submatrix(size, vector<int>(size, 0));
-    for (int i = 0; i < size; ++i)
+    int m = A.rows(), k = A.cols(), n = B.cols();
+    if (m <= FORK_JOIN_LEAF && k <= FORK_JOIN_LEAF && n <= FORK_JOIN_LEAF)
     {
-        for (int j = 0; j < size; ++j)
-        {
-            submatrix[i][j] = matrix[rowStart + i][colStart + j];
-        }
+        gemm<T>(A, B, C, true);
     }
-    return submatrix;
-}
-
-// Helper function to add matrices A and B, store result in C
-void addMatrices(const vector<vector<int>> &A, const vector<vector<int>> &B, vector<vector<int>> &C, int size)
-{
-    for (int i = 0; i < size; ++i)
+    else if (m >= k && m >= n)
     {
-        for (int j = 0; j < size; ++j)
-        {
-            C[i][j] = A[i][j] + B[i][j];
-        }
+        int h = m / 2;
+#pragma omp task default(shared)
+        multiplyRecursive<T>(A.block(0, 0, h, k), B, C.block(0, 0, h, n));
+        multiplyRecursive<T>(A.block(h, 0, m - h, k), B, C.block(h, 0, m - h, n));
+#pragma omp taskwait
     }
-}
-
-// Recursive function to multiply matrices A and B, store result in C
-void multiplyRecursive(const vector<vector<int>> &A, const vector<vector<int>> &B, vector<vector<int>> &C, int size)
-{
-    if (size == 1)
+    else if (n >= k)
     {
-        C[0][0] = A[0][0] * B[0][0];
+        int h = n / 2;
+#pragma omp task default(shared)
+        multiplyRecursive<T>(A, B.block(0, 0, k, h), C.block(0, 0, m, h));
+        multiplyRecursive<T>(A, B.block(0, h, k, n - h), C.block(0, h, m, n - h));
+#pragma omp taskwait
     }
     else
     {
-        int newSize = size / 2;
-        vector<vector<int>> A11 = getSubmatrix(A, 0, 0, newSize);
-        vector<vector<int>> A12 = getSubmatrix(A, 0, newSize, newSize);
-        vector<vector<int>> A21 = getSubmatrix(A, newSize, 0, newSize);
-        vector<vector<int>> A22 = getSubmatrix(A, newSize, newSize, newSize);
-        vector<vector<int>> B11 = getSubmatrix(B, 0, 0, newSize);
-        vector<vector<int>> B12 = getSubmatrix(B, 0, newSize, newSize);
-        vector<vector<int>> B21 = getSubmatrix(B, newSize, 0, newSize);
-        vector<vector<int>> B22 = getSubmatrix(B, newSize, newSize, newSize);
-
-        vector<vector<int>> C11(newSize, vector<int>(newSize, 0));
-        vector<vector<int>> C12(newSize, vector<int>(newSize, 0));
-        vector<vector<int>> C21(newSize, vector<int>(newSize, 0));
-        vector<vector<int>> C22(newSize, vector<int>(newSize, 0));
-        vector<vector<int>> temp1(newSize, vector<int>(newSize, 0));
-        vector<vector<int>> temp2(newSize, vector<int>(newSize, 0));
-
-#pragma omp parallel sections
-        {
-#pragma omp section
-            {
-                multiplyRecursive(A11, B11, C11, newSize);
-                multiplyRecursive(A12, B21, temp1, newSize);
-                addMatrices(C11, temp1, C11, newSize);
-            }
-#pragma omp section
-            {
-                multiplyRecursive(A11, B12, C12, newSize);
-                multiplyRecursive(A12, B22, temp2, newSize);
-                addMatrices(C12, temp2, C12, newSize);
-            }
-#pragma omp section
-            {
-                multiplyRecursive(A21, B11, C21, newSize);
-                multiplyRecursive(A22, B21, temp1, newSize);
-                addMatrices(C21, temp1, C21, newSize);
-            }
-#pragma omp section
-            {
-                multiplyRecursive(A21, B12, C22, newSize);
-                multiplyRecursive(A22, B22, temp2, newSize);
-                addMatrices(C22, temp2, C22, newSize);
-            }
-        }
-
-        // Combine the results into C
-        for (int i = 0; i < newSize; ++i)
-        {
-            for (int j = 0; j < newSize; ++j)
-            {
-                C[i][j] = C11[i][j];
-                C[i][j + newSize] = C12[i][j];
-                C[i + newSize][j] = C21[i][j];
-                C[i + newSize][j + newSize] = C22[i][j];
-            }
-        }
+        int h = k / 2;
+        multiplyRecursive<T>(A.block(0, 0, m, h), B.block(0, 0, h, n), C);
+        multiplyRecursive<T>(A.block(0, h, m, k - h), B.block(h, 0, k - h, n), C);
     }
 }
 
-vector<vector<int>> sharedMemoryMultiply(const vector<vector<int>> &A, const vector<vector<int>> &B)
+template <typename T>
+Matrix<T> sharedMemoryMultiply(const Matrix<T> &A, const Matrix<T> &B)
 {
-    int n = A.size();                            // Assuming A and B are square and of equal size.
-    vector<vector<int>> C(n, vector<int>(n, 0)); // Initialize the result matrix.
-    multiplyRecursive(A, B, C, n);
+    if (A.cols() != B.rows())
+    {
+        throw invalid_argument("Matrices cannot be multiplied due to incompatible dimensions.");
+    }
+    Matrix<T> C(A.rows(), B.cols()); // Zero-initialized; the recursion accumulates into it
+#pragma omp parallel
+#pragma omp single
+    multiplyRecursive<T>(A, B, C);
     return C;
 }
 
 // Performance Test
 
 // Function to print a matrix
-void printMatrix(const vector<vector<int>> &matrix)
+template <typename T>
+void printMatrix(const Matrix<T> &matrix)
 {
-    for (const auto &row : matrix)
+    for (int i = 0; i < matrix.rows(); i++)
     {
-        for (int val : row)
+        for (int j = 0; j < matrix.cols(); j++)
         {
-            cout << val << " ";
+            cout << matrix(i, j) << " ";
         }
         cout << endl;
     }
 }
 
 // Function to generate a random matrix of given dimensions
-vector<vector<int>> generateRandomMatrix(int rows, int cols)
+template <typename T = int>
+Matrix<T> generateRandomMatrix(int rows, int cols)
 {
     random_device rd;                       // Obtain a random number from hardware
     mt19937 eng(rd());                      // Seed the generator
     uniform_int_distribution<> distr(0, 9); // Define the range
 
-    vector<vector<int>> matrix(rows, vector<int>(cols));
+    Matrix<T> matrix(rows, cols);
     for (int i = 0; i < rows; ++i)
     {
         for (int j = 0; j < cols; ++j)
         {
-            matrix[i][j] = distr(eng); // Assign random numbers
+            matrix(i, j) = (T)distr(eng); // Assign random numbers
         }
     }
     return matrix;
@@ -414,22 +298,22 @@ vector<vector<int>> generateRandomMatrix(int rows, int cols)
 
 // int main() {
 //     // Smaller matrices for initial test
-//     vector<vector<int>> matrix1 = {{1, 2, 3}, {4, 5, 6}};
-//     vector<vector<int>> matrix2 = {{7, 8}, {9, 10}, {11, 12}};
+//     Matrix<int> matrix1 = {{1, 2, 3}, {4, 5, 6}};
+//     Matrix<int> matrix2 = {{7, 8}, {9, 10}, {11, 12}};
 
 //     // Larger matrices for performance test
 //     int largeSize = 100; // Adjust this size based on your system's capability
-//     vector<vector<int>> largeMatrix1 = generateRandomMatrix(largeSize, largeSize);
-//     vector<vector<int>> largeMatrix2 = generateRandomMatrix(largeSize, largeSize);
+//     Matrix<int> largeMatrix1 = generateRandomMatrix(largeSize, largeSize);
+//     Matrix<int> largeMatrix2 = generateRandomMatrix(largeSize, largeSize);
 
 //     try {
-//         vector<vector<int>> result = multiplyMatricesCacheFriendly(matrix1, matrix2);
+//         Matrix<int> result = multiplyMatricesCacheFriendly(matrix1, matrix2);
 //         cout << "Result of small matrix multiplication:" << endl;
 //         printMatrix(result);
 
 //         // Uncomment the lines below to test with large matrices
 //         cout << "Multiplying large matrices..." << endl;
-//         vector<vector<int>> largeResult = multiplyMatricesCacheFriendly(largeMatrix1, largeMatrix2);
+//         Matrix<int> largeResult = multiplyMatricesCacheFriendly(largeMatrix1, largeMatrix2);
 //         cout << "Result of Large matrix multiplication:" << endl;
 //         printMatrix(largeResult);
 //         cout << "Done multiplying large matrices. Not displaying due to size." << endl;
@@ -447,8 +331,8 @@ vector<vector<int>> generateRandomMatrix(int rows, int cols)
 //     {
 //         cout << "Matrix size: " << size << "x" << size << endl;
 
-//         vector<vector<int>> A = generateRandomMatrix(size, size);
-//         vector<vector<int>> B = generateRandomMatrix(size, size);
+//         Matrix<int> A = generateRandomMatrix(size, size);
+//         Matrix<int> B = generateRandomMatrix(size, size);
 
 //         vector<pair<string, long long>> timings;
 
@@ -530,8 +414,8 @@ int main()
     {
         cout << "Matrix size: " << size << "x" << size << endl;
 
-        vector<vector<int>> A = generateRandomMatrix(size, size);
-        vector<vector<int>> B = generateRandomMatrix(size, size);
+        Matrix<int> A = generateRandomMatrix(size, size);
+        Matrix<int> B = generateRandomMatrix(size, size);
 
         // 1. Basic Matrix Multiplication
         auto start = high_resolution_clock::now();
@@ -557,7 +441,7 @@ int main()
         stop = high_resolution_clock::now();
         cout << "Parallel: " << duration_cast<milliseconds>(stop - start).count() << " ms\n";
 
-        // 5. Block-wise (Cannon's style) Matrix Multiplication
+        // 5. Block-wise (tiled) Matrix Multiplication
         start = high_resolution_clock::now();
         auto C5 = blockWiseMultiply(A, B);
         stop = high_resolution_clock::now();
@@ -569,13 +453,25 @@ int main()
         stop = high_resolution_clock::now();
         cout << "Fork-join model in shared-memory: " << duration_cast<milliseconds>(stop - start).count() << " ms\n";
 
+        // 7. Packed, register-blocked SIMD GEMM (Gemm.hpp)
+        start = high_resolution_clock::now();
+        auto C7 = gemm(A, B);
+        stop = high_resolution_clock::now();
+        cout << "Packed GEMM: " << duration_cast<milliseconds>(stop - start).count() << " ms\n";
+
+        // 8. Packed GEMM with threads owning 2-D tiles of C
+        start = high_resolution_clock::now();
+        auto C8 = gemmParallel(A, B);
+        stop = high_resolution_clock::now();
+        cout << "Parallel packed GEMM: " << duration_cast<milliseconds>(stop - start).count() << " ms\n";
+
         cout << endl;
     }
 
     return 0;
 }
 
-// g++ -fopenmp -march=native -ffast-math -fopt-info-vec -o MatrixMultiply MatrixMultiply.cpp -O3 && ./MatrixMultiply
+// g++ -std=c++17 -fopenmp -march=native -ffast-math -fopt-info-vec -o MatrixMultiply MatrixMultiply.cpp -O3 && ./MatrixMultiply
 // valgrind --tool=cachegrind ./MatrixMultiply
 
 // ==325== Cachegrind, a cache and branch-prediction profiler
@@ -26,7 +26,7 @@ def compile_and_run(executable, cpp_source):
     is_windows = sys.platform.startswith('win')
     
     # Adjust the compile and run commands for compatibility
-    compile_command = 'g++ -fopenmp -march=native -ffast-math -o {} {} -O3'.format(executable, cpp_source)
+    compile_command = 'g++ -std=c++17 -fopenmp -march=native -ffast-math -o {} {} -O3'.format(executable, cpp_source)
     subprocess.run(compile_command, shell=True, check=True)
 
     run_command = executable if is_windows else './{}'.format(executable)
@@ -47,6 +47,8 @@ patterns = {
     "Parallel": r"Parallel: (\d+) ms",
     "Block-wise": r"Block-wise: (\d+) ms",
     "Fork-join model in shared-memory": r"Fork-join model in shared-memory: (\d+) ms",
+    "Packed GEMM": r"Packed GEMM: (\d+) ms",
+    "Parallel packed GEMM": r"Parallel packed GEMM: (\d+) ms",
 }
 
 # Initialize data structure to hold execution times
@@ -0,0 +1,527 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// MixedGemm.hpp
+// Low-precision GEMM entry points with wide accumulation:
+//   gemm(int8 A, int8 B)         -> int32 C
+//   gemm(int16 A, int16 B)       -> int32 C
+//   gemm(bfloat16 A, bfloat16 B) -> float C
+//   gemm(float16 A, float16 B)   -> float C
+// The integer and bfloat16 paths use the packed GotoBLAS loops of Gemm.hpp
+// with dot-product micro-kernels. Each 32-bit lane multiplies a group of G
+// adjacent k values, so A is packed as one G-element word per row and k
+// group, and B as one word per column and k group:
+//   AVX-512 VNNI / AVX-VNNI  vpdpbusd   int8 x 4  -> int32 (G = 4)
+//   AVX-512BW / AVX2         vpmaddwd   int16 x 2 -> int32 (G = 2; int8 is
+//                                       sign-extended while packing)
+//   AVX-512 BF16             vdpbf16ps  bf16 x 2  -> fp32  (G = 2)
+// vpdpbusd multiplies unsigned by signed bytes, so A is packed as a + 128
+// and 128 * (column sums of B) is subtracted afterwards. Without those
+// instructions, and always for float16 (x86 has no fp16 dot product that
+// accumulates in fp32), the operands are widened to int32 or float (with F16C
+// when present) and multiplied by the plain gemm. mixedForcePath picks a path
+// for benchmarking.
+// Integer results are exact as long as the dot products fit in int32, e.g.
+// always for int8 with k < 2^17.
+
+#ifndef MIXED_GEMM_HPP
+#define MIXED_GEMM_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "Gemm.hpp"
+#include "HalfFloat.hpp"
+#include "Matrix.hpp"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+enum class MixedPath { Auto, Widen, Avx2Madd, Avx512Madd, AvxVnni, Avx512Vnni, Avx512Bf16 };
+
+namespace mixed_detail {
+
+typedef gemm_detail::VectorOf<int32_t, 32>::type Int256;
+typedef gemm_detail::VectorOf<int32_t, 64>::type Int512;
+typedef gemm_detail::VectorOf<float, 64>::type Float512;
+
+// Each Ops type names the accumulator vector, the operand vector (32-bit
+// words holding G packed values) and the dot-product step. dot is inline but
+// not always_inline: it only becomes inlinable once the generic kernel has
+// been inlined into the wrapper carrying the same target.
+#if defined(__x86_64__) || defined(__i386__)
+struct Avx512VnniOps {
+    typedef Int512 Acc;
+    typedef Int512 Word;
+    __attribute__((target("avx512f,avx512bw,avx512vnni"))) static inline void dot(Acc& c, const Word& a,
+                                                                                   const Word& b) {
+        c = (Acc)_mm512_dpbusd_epi32((__m512i)c, (__m512i)a, (__m512i)b);
+    }
+};
+
+struct AvxVnniOps {
+    typedef Int256 Acc;
+    typedef Int256 Word;
+    __attribute__((target("avx2,avxvnni"))) static inline void dot(Acc& c, const Word& a, const Word& b) {
+        c = (Acc)_mm256_dpbusd_avx_epi32((__m256i)c, (__m256i)a, (__m256i)b);
+    }
+};
+
+struct Avx512MaddOps {
+    typedef Int512 Acc;
+    typedef Int512 Word;
+    __attribute__((target("avx512f,avx512bw"))) static inline void dot(Acc& c, const Word& a, const Word& b) {
+        c += (Acc)_mm512_madd_epi16((__m512i)a, (__m512i)b);
+    }
+};
+
+struct Avx2MaddOps {
+    typedef Int256 Acc;
+    typedef Int256 Word;
+    __attribute__((target("avx2"))) static inline void dot(Acc& c, const Word& a, const Word& b) {
+        c += (Acc)_mm256_madd_epi16((__m256i)a, (__m256i)b);
+    }
+};
+
+struct Avx512Bf16Ops {
+    typedef Float512 Acc;
+    typedef Int512 Word;
+    __attribute__((target("avx512f,avx512bf16"))) static inline void dot(Acc& c, const Word& a, const Word& b) {
+        c = (Acc)_mm512_dpbf16_ps((__m512)c, (__m512bh)a, (__m512bh)b);
+    }
+};
+#endif
+
+// MR x NR tile of C += packed A sliver * packed B sliver over groups of k;
+// a holds MR words per group, b holds NR words per group
+template <typename Ops, int MR, int NV, typename Packed, typename Out>
+__attribute__((always_inline)) inline void dotKernel(int groups, const Packed* a, const Packed* b, Out* c,
+                                                     int64_t ldc, int mr, int nr) {
+    typedef typename Ops::Acc Acc;
+    typedef typename Ops::Word Word;
+    constexpr int lanes = sizeof(Word) / sizeof(int32_t);
+    constexpr int NR = NV * lanes;
+    const char* aBytes = reinterpret_cast<const char*>(a);
+    const char* bBytes = reinterpret_cast<const char*>(b);
+    Acc acc[MR][NV];
+#pragma GCC unroll 16
+    for (int i = 0; i < MR; i++) {
+#pragma GCC unroll 4
+        for (int v = 0; v < NV; v++) acc[i][v] = Acc{};
+    }
+    for (int p = 0; p < groups; p++) {
+        Word bv[NV];
+#pragma GCC unroll 4
+        for (int v = 0; v < NV; v++) std::memcpy(&bv[v], bBytes + ((size_t)p * NR + v * lanes) * 4, sizeof(Word));
+#pragma GCC unroll 16
+        for (int i = 0; i < MR; i++) {
+            int32_t word;
+            std::memcpy(&word, aBytes + ((size_t)p * MR + i) * 4, 4);
+            Word av = Word{} + word; // Broadcast
+#pragma GCC unroll 4
+            for (int v = 0; v < NV; v++) Ops::dot(acc[i][v], av, bv[v]);
+        }
+    }
+    if (mr == MR && nr == NR) {
+#pragma GCC unroll 16
+        for (int i = 0; i < MR; i++) {
+#pragma GCC unroll 4
+            for (int v = 0; v < NV; v++) {
+                Acc cv;
+                std::memcpy(&cv, c + i * ldc + v * lanes, sizeof(Acc));
+                cv += acc[i][v];
+                std::memcpy(c + i * ldc + v * lanes, &cv, sizeof(Acc));
+            }
+        }
+        return;
+    }
+    Out tile[MR][NR];
+    std::memcpy(tile, acc, sizeof(tile));
+    for (int i = 0; i < mr; i++) {
+        for (int j = 0; j < nr; j++) c[i * ldc + j] += tile[i][j];
+    }
+}
+
+template <typename Packed, typename Out>
+struct DotKernelInfo {
+    void (*kernel)(int, const Packed*, const Packed*, Out*, int64_t, int, int);
+    int mr;
+    int nr;
+};
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx512f,avx512bw,avx512vnni"))) inline void kernelAvx512Vnni(
+    int groups, const uint8_t* a, const uint8_t* b, int32_t* c, int64_t ldc, int mr, int nr) {
+    dotKernel<Avx512VnniOps, 12, 2>(groups, a, b, c, ldc, mr, nr);
+}
+__attribute__((target("avx2,avxvnni"))) inline void kernelAvxVnni(int groups, const uint8_t* a, const uint8_t* b,
+                                                                   int32_t* c, int64_t ldc, int mr, int nr) {
+    dotKernel<AvxVnniOps, 6, 2>(groups, a, b, c, ldc, mr, nr);
+}
+__attribute__((target("avx512f,avx512bw"))) inline void kernelAvx512Madd(int groups, const int16_t* a,
+                                                                          const int16_t* b, int32_t* c, int64_t ldc,
+                                                                          int mr, int nr) {
+    dotKernel<Avx512MaddOps, 12, 2>(groups, a, b, c, ldc, mr, nr);
+}
+__attribute__((target("avx2"))) inline void kernelAvx2Madd(int groups, const int16_t* a, const int16_t* b,
+                                                            int32_t* c, int64_t ldc, int mr, int nr) {
+    dotKernel<Avx2MaddOps, 6, 2>(groups, a, b, c, ldc, mr, nr);
+}
+__attribute__((target("avx512f,avx512bf16"))) inline void kernelAvx512Bf16(int groups, const uint16_t* a,
+                                                                            const uint16_t* b, float* c,
+                                                                            int64_t ldc, int mr, int nr) {
+    dotKernel<Avx512Bf16Ops, 12, 2>(groups, a, b, c, ldc, mr, nr);
+}
+#endif
+
+// mc x kc block of A as MR-tall slivers: for each group of G k values, MR
+// words of G converted values, zero padded past mc and kc
+template <int G, typename In, typename Packed, typename Convert>
+void packA(ConstMatrixView<In> A, int ic, int pc, int mc, int kc, int mr, Packed* out, Convert convert) {
+    const int groups = (kc + G - 1) / G;
+    for (int i0 = 0; i0 < mc; i0 += mr) {
+        const int height = std::min(mr, mc - i0);
+        for (int g = 0; g < groups; g++) {
+            for (int i = 0; i < mr; i++) {
+                for (int q = 0; q < G; q++) {
+                    const int p = g * G + q;
+                    *out++ = i < height && p < kc ? convert(A(ic + i0 + i, pc + p)) : Packed(0);
+                }
+            }
+        }
+    }
+}
+
+// kc x nc block of B as NR-wide slivers: for each group, NR words of G
+// values down one column
+template <int G, typename In, typename Packed, typename Convert>
+void packB(ConstMatrixView<In> B, int pc, int jc, int kc, int nc, int nr, Packed* out, Convert convert) {
+    const int groups = (kc + G - 1) / G;
+    for (int j0 = 0; j0 < nc; j0 += nr) {
+        const int width = std::min(nr, nc - j0);
+        for (int g = 0; g < groups; g++) {
+            for (int j = 0; j < nr; j++) {
+                for (int q = 0; q < G; q++) {
+                    const int p = g * G + q;
+                    *out++ = j < width && p < kc ? convert(B(pc + p, jc + j0 + j)) : Packed(0);
+                }
+            }
+        }
+    }
+}
+
+// C += A * B through a dot-product kernel, with Gemm.hpp's loop order; KC
+// is chosen so a B sliver stays near 16 KiB of L1 for every packed width
+template <int G, typename In, typename Packed, typename Out, typename ConvertA, typename ConvertB>
+void dotGemm(ConstMatrixView<In> A, ConstMatrixView<In> B, MatrixView<Out> C, DotKernelInfo<Packed, Out> info,
+             ConvertA convertA, ConvertB convertB) {
+    const int m = A.rows(), k = A.cols(), n = B.cols();
+    const int mr = info.mr, nr = info.nr;
+    const int mcMax = 192 / mr * mr, kcMax = 512 / (int)sizeof(Packed), ncMax = 4096 / nr * nr;
+    const int kcPadded = (std::min(kcMax, k) + G - 1) / G * G;
+    Packed* packedA = gemm_detail::packBuffer<Packed>(0, (size_t)std::min(mcMax, (m + mr - 1) / mr * mr) * kcPadded);
+    Packed* packedB = gemm_detail::packBuffer<Packed>(1, (size_t)std::min(ncMax, (n + nr - 1) / nr * nr) * kcPadded);
+
+    for (int jc = 0; jc < n; jc += ncMax) {
+        const int nc = std::min(ncMax, n - jc);
+        for (int pc = 0; pc < k; pc += kcMax) {
+            const int kc = std::min(kcMax, k - pc), groups = (kc + G - 1) / G;
+            packB<G>(B, pc, jc, kc, nc, nr, packedB, convertB);
+            for (int ic = 0; ic < m; ic += mcMax) {
+                const int mc = std::min(mcMax, m - ic);
+                packA<G>(A, ic, pc, mc, kc, mr, packedA, convertA);
+                for (int jr = 0; jr < nc; jr += nr) {
+                    const Packed* b = packedB + (size_t)jr * groups * G;
+                    for (int ir = 0; ir < mc; ir += mr) {
+                        info.kernel(groups, packedA + (size_t)ir * groups * G, b, &C(ic + ir, jc + jr), C.stride(),
+                                    std::min(mr, mc - ir), std::min(nr, nc - jr));
+                    }
+                }
+            }
+        }
+    }
+}
+
+// vpdpbusd's unsigned operand: A + 128 stored as a byte
+inline uint8_t offsetByte(int8_t a) { return (uint8_t)(a ^ 0x80); }
+inline uint8_t sameByte(int8_t b) { return (uint8_t)b; }
+
+// Undoes the +128 on A: C -= 128 * (sum over k of B(k, j))
+inline void subtractOffset(ConstMatrixView<int8_t> B, MatrixView<int32_t> C) {
+    std::vector<int32_t> columnSum(B.cols(), 0);
+    for (int p = 0; p < B.rows(); p++) {
+        const int8_t* b = B.row(p);
+        for (int j = 0; j < B.cols(); j++) columnSum[j] += b[j];
+    }
+    for (int i = 0; i < C.rows(); i++) {
+        int32_t* c = C.row(i);
+        for (int j = 0; j < C.cols(); j++) c[j] -= (int32_t)((uint32_t)columnSum[j] << 7);
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2,f16c"))) inline void float16ToFloatF16c(const float16* in, float* out, int count) {
+    int j = 0;
+    for (; j + 8 <= count; j += 8) {
+        __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + j));
+        _mm256_storeu_ps(out + j, _mm256_cvtph_ps(h));
+    }
+    for (; j < count; j++) out[j] = float(in[j]);
+}
+#endif
+
+inline bool hasF16c() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_cpu_supports("f16c") && __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+template <typename Wide, typename In>
+void widenRow(const In* in, Wide* out, int count) {
+    for (int j = 0; j < count; j++) out[j] = Wide(in[j]);
+}
+
+inline void widenRow(const float16* in, float* out, int count) {
+#if defined(__x86_64__) || defined(__i386__)
+    static const bool f16c = hasF16c();
+    if (f16c) {
+        float16ToFloatF16c(in, out, count);
+        return;
+    }
+#endif
+    for (int j = 0; j < count; j++) out[j] = float(in[j]);
+}
+
+template <typename Wide, typename In>
+Matrix<Wide> widen(ConstMatrixView<In> M) {
+    Matrix<Wide> wide = Matrix<Wide>::uninitialized(M.rows(), M.cols());
+    for (int i = 0; i < M.rows(); i++) widenRow(M.row(i), wide.row(i), M.cols());
+    return wide;
+}
+
+// Fallback: widen both operands and use the plain gemm of the wide type
+template <typename Wide, typename In>
+void widenGemm(ConstMatrixView<In> A, ConstMatrixView<In> B, MatrixView<Wide> C) {
+    Matrix<Wide> wideA = widen<Wide>(A), wideB = widen<Wide>(B);
+    gemm<Wide>(wideA, wideB, C, true);
+}
+
+inline bool supported(MixedPath path) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    switch (path) {
+    case MixedPath::Auto:
+    case MixedPath::Widen:
+        return true;
+    case MixedPath::Avx2Madd:
+        return __builtin_cpu_supports("avx2");
+    case MixedPath::Avx512Madd:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+    case MixedPath::AvxVnni:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("avxvnni");
+    case MixedPath::Avx512Vnni:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+               __builtin_cpu_supports("avx512vnni");
+    case MixedPath::Avx512Bf16:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bf16");
+    }
+    return false;
+#else
+    return path == MixedPath::Auto || path == MixedPath::Widen;
+#endif
+}
+
+// Paths implemented for each input type, preferred first
+template <typename In>
+std::vector<MixedPath> candidates() {
+    if (std::is_same<In, int8_t>::value) {
+        return {MixedPath::Avx512Vnni, MixedPath::AvxVnni, MixedPath::Avx512Madd, MixedPath::Avx2Madd,
+                MixedPath::Widen};
+    }
+    if (std::is_same<In, int16_t>::value) return {MixedPath::Avx512Madd, MixedPath::Avx2Madd, MixedPath::Widen};
+    // vdpbf16ps issues at under a third of the zmm FMA rate on Sapphire
+    // Rapids, so widening into the float kernel wins there; the dot-product
+    // path has to be forced
+    if (std::is_same<In, bfloat16>::value) return {MixedPath::Widen, MixedPath::Avx512Bf16};
+    return {MixedPath::Widen};
+}
+
+inline MixedPath& forcedPath() {
+    static MixedPath path = MixedPath::Auto;
+    return path;
+}
+
+} // namespace mixed_detail
+
+inline const char* mixedPathName(MixedPath path) {
+    switch (path) {
+    case MixedPath::Auto: return "auto";
+    case MixedPath::Widen: return "widen";
+    case MixedPath::Avx2Madd: return "AVX2 vpmaddwd";
+    case MixedPath::Avx512Madd: return "AVX-512BW vpmaddwd";
+    case MixedPath::AvxVnni: return "AVX-VNNI vpdpbusd";
+    case MixedPath::Avx512Vnni: return "AVX-512 VNNI vpdpbusd";
+    case MixedPath::Avx512Bf16: return "AVX-512 BF16 vdpbf16ps";
+    }
+    return "?";
+}
+
+// Path the mixed gemm for In takes: the forced one when it is implemented
+// for In and supported by the CPU, otherwise the first preferred that is
+template <typename In>
+MixedPath mixedPath() {
+    const std::vector<MixedPath> paths = mixed_detail::candidates<In>();
+    const MixedPath forced = mixed_detail::forcedPath();
+    if (forced != MixedPath::Auto && std::find(paths.begin(), paths.end(), forced) != paths.end() &&
+        mixed_detail::supported(forced)) {
+        return forced;
+    }
+    for (MixedPath path : paths) {
+        if (mixed_detail::supported(path)) return path;
+    }
+    return MixedPath::Widen;
+}
+
+// Every path available to In on this CPU, preferred first
+template <typename In>
+std::vector<MixedPath> mixedPaths() {
+    std::vector<MixedPath> available;
+    for (MixedPath path : mixed_detail::candidates<In>()) {
+        if (mixed_detail::supported(path)) available.push_back(path);
+    }
+    return available;
+}
+
+// Auto restores the preferred path
+inline void mixedForcePath(MixedPath path) { mixed_detail::forcedPath() = path; }
+
+namespace mixed_detail {
+
+template <typename In, typename Out>
+void checkShapes(ConstMatrixView<In> A, ConstMatrixView<In> B, MatrixView<Out> C) {
+    if (B.rows() != A.cols() || C.rows() != A.rows() || C.cols() != B.cols()) {
+        throw std::invalid_argument("gemm: incompatible dimensions");
+    }
+}
+
+} // namespace mixed_detail
+
+// C = A * B, or C += A * B when accumulate is set, accumulating in int32
+inline void gemm(ConstMatrixView<int8_t> A, ConstMatrixView<int8_t> B, MatrixView<int32_t> C,
+                 bool accumulate = false) {
+    mixed_detail::checkShapes(A, B, C);
+    if (!accumulate) C.fill(0);
+    if (C.rows() == 0 || C.cols() == 0 || A.cols() == 0) return;
+    using namespace mixed_detail;
+    auto widenByte = [](int8_t v) { return (int16_t)v; };
+    switch (mixedPath<int8_t>()) {
+#if defined(__x86_64__) || defined(__i386__)
+    case MixedPath::Avx512Vnni:
+        dotGemm<4>(A, B, C, DotKernelInfo<uint8_t, int32_t>{kernelAvx512Vnni, 12, 32}, offsetByte, sameByte);
+        subtractOffset(B, C);
+        break;
+    case MixedPath::AvxVnni:
+        dotGemm<4>(A, B, C, DotKernelInfo<uint8_t, int32_t>{kernelAvxVnni, 6, 16}, offsetByte, sameByte);
+        subtractOffset(B, C);
+        break;
+    case MixedPath::Avx512Madd:
+        dotGemm<2>(A, B, C, DotKernelInfo<int16_t, int32_t>{kernelAvx512Madd, 12, 32}, widenByte, widenByte);
+        break;
+    case MixedPath::Avx2Madd:
+        dotGemm<2>(A, B, C, DotKernelInfo<int16_t, int32_t>{kernelAvx2Madd, 6, 16}, widenByte, widenByte);
+        break;
+#endif
+    default:
+        widenGemm<int32_t>(A, B, C);
+    }
+}
+
+inline void gemm(ConstMatrixView<int16_t> A, ConstMatrixView<int16_t> B, MatrixView<int32_t> C,
+                 bool accumulate = false) {
+    mixed_detail::checkShapes(A, B, C);
+    if (!accumulate) C.fill(0);
+    if (C.rows() == 0 || C.cols() == 0 || A.cols() == 0) return;
+    using namespace mixed_detail;
+    auto same = [](int16_t v) { return v; };
+    switch (mixedPath<int16_t>()) {
+#if defined(__x86_64__) || defined(__i386__)
+    case MixedPath::Avx512Madd:
+        dotGemm<2>(A, B, C, DotKernelInfo<int16_t, int32_t>{kernelAvx512Madd, 12, 32}, same, same);
+        break;
+    case MixedPath::Avx2Madd:
+        dotGemm<2>(A, B, C, DotKernelInfo<int16_t, int32_t>{kernelAvx2Madd, 6, 16}, same, same);
+        break;
+#endif
+    default:
+        widenGemm<int32_t>(A, B, C);
+    }
+}
+
+// C = A * B, or C += A * B, with float products and accumulation
+inline void gemm(ConstMatrixView<bfloat16> A, ConstMatrixView<bfloat16> B, MatrixView<float> C,
+                 bool accumulate = false) {
+    mixed_detail::checkShapes(A, B, C);
+    if (!accumulate) C.fill(0.0f);
+    if (C.rows() == 0 || C.cols() == 0 || A.cols() == 0) return;
+    using namespace mixed_detail;
+#if defined(__x86_64__) || defined(__i386__)
+    if (mixedPath<bfloat16>() == MixedPath::Avx512Bf16) {
+        auto bits = [](bfloat16 v) { return v.bits; };
+        dotGemm<2>(A, B, C, DotKernelInfo<uint16_t, float>{kernelAvx512Bf16, 12, 32}, bits, bits);
+        return;
+    }
+#endif
+    widenGemm<float>(A, B, C);
+}
+
+inline void gemm(ConstMatrixView<float16> A, ConstMatrixView<float16> B, MatrixView<float> C,
+                 bool accumulate = false) {
+    mixed_detail::checkShapes(A, B, C);
+    if (!accumulate) C.fill(0.0f);
+    if (C.rows() == 0 || C.cols() == 0 || A.cols() == 0) return;
+    mixed_detail::widenGemm<float>(A, B, C);
+}
+
+inline Matrix<int32_t> gemm(const Matrix<int8_t>& A, const Matrix<int8_t>& B) {
+    Matrix<int32_t> C(A.rows(), B.cols());
+    gemm(A.view(), B.view(), C.view(), true);
+    return C;
+}
+inline Matrix<int32_t> gemm(const Matrix<int16_t>& A, const Matrix<int16_t>& B) {
+    Matrix<int32_t> C(A.rows(), B.cols());
+    gemm(A.view(), B.view(), C.view(), true);
+    return C;
+}
+inline Matrix<float> gemm(const Matrix<bfloat16>& A, const Matrix<bfloat16>& B) {
+    Matrix<float> C(A.rows(), B.cols());
+    gemm(A.view(), B.view(), C.view(), true);
+    return C;
+}
+inline Matrix<float> gemm(const Matrix<float16>& A, const Matrix<float16>& B) {
+    Matrix<float> C(A.rows(), B.cols());
+    gemm(A.view(), B.view(), C.view(), true);
+    return C;
+}
+
+#endif // MIXED_GEMM_HPP
@@ -0,0 +1,600 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// SparseMatrix.hpp
+// Sparse storage and kernels for matrices that are mostly zeros. Only the
+// nonzeros are stored, so memory and work scale with nnz rather than
+// rows * cols.
+//   CooMatrix: (row, column, value) triplets in any order, duplicates
+//              allowed. Cheap to build, and the input to the other two.
+//   CsrMatrix: row i's columns and values are at offsets[i] ..
+//              offsets[i + 1], sorted by column with no duplicates.
+//   CscMatrix: the same by columns, i.e. the CSR form of the transpose.
+// Kernels, all on CSR and parallelized with OpenMP:
+//   spmv    y = A * x. Rows are split so every thread gets an equal share
+//           of the nonzeros, not of the rows.
+//   spmm    C = A * B with B and C dense. Each nonzero scales a whole row
+//           of B, so the inner loop is a contiguous axpy.
+//   spgemm  C = A * B with all three sparse, by Gustavson's row-by-row
+//           method. Each thread merges the scaled rows of B into its own
+//           accumulator: a dense array of B.cols() values with a marker
+//           per column, or an open-addressing hash table sized for the row
+//           when B is too wide for that. Threads build their rows in
+//           private buffers, split by the row flop counts, and the rows are
+//           then copied into place behind one prefix sum.
+
+#ifndef SPARSE_MATRIX_HPP
+#define SPARSE_MATRIX_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "Matrix.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+template <typename T>
+class CooMatrix {
+public:
+    CooMatrix() : numRows(0), numCols(0) {}
+    CooMatrix(int rows, int cols) : numRows(rows), numCols(cols) {
+        if (rows < 0 || cols < 0) throw std::invalid_argument("CooMatrix: negative dimension");
+    }
+
+    // Appends A(row, col) += value; repeated positions are summed on conversion
+    void add(int row, int col, T value) {
+        if (row < 0 || row >= numRows || col < 0 || col >= numCols) {
+            throw std::out_of_range("CooMatrix: index out of range");
+        }
+        rowIndex.push_back(row);
+        colIndex.push_back(col);
+        vals.push_back(value);
+    }
+
+    void reserve(size_t count) {
+        rowIndex.reserve(count);
+        colIndex.reserve(count);
+        vals.reserve(count);
+    }
+
+    // Every nonzero of a dense matrix, in row order
+    static CooMatrix fromDense(ConstMatrixView<T> dense) {
+        CooMatrix coo(dense.rows(), dense.cols());
+        for (int i = 0; i < dense.rows(); i++) {
+            for (int j = 0; j < dense.cols(); j++) {
+                if (dense(i, j) != T(0)) coo.add(i, j, dense(i, j));
+            }
+        }
+        return coo;
+    }
+
+    Matrix<T> toDense() const {
+        Matrix<T> dense(numRows, numCols);
+        for (size_t e = 0; e < vals.size(); e++) dense(rowIndex[e], colIndex[e]) += vals[e];
+        return dense;
+    }
+
+    int rows() const { return numRows; }
+    int cols() const { return numCols; }
+    int64_t nonZeros() const { return (int64_t)vals.size(); }
+    const std::vector<int32_t>& rowIndices() const { return rowIndex; }
+    const std::vector<int32_t>& colIndices() const { return colIndex; }
+    const std::vector<T>& values() const { return vals; }
+
+private:
+    int numRows, numCols;
+    std::vector<int32_t> rowIndex, colIndex;
+    std::vector<T> vals;
+};
+
+namespace sparse_detail {
+
+// Compressed form of triplets grouped by major index: offsets has
+// numMajor + 1 entries, and each group is sorted by minor index with
+// duplicates summed
+template <typename T>
+struct Compressed {
+    std::vector<int64_t> offsets;
+    std::vector<int32_t> indices;
+    std::vector<T> values;
+};
+
+template <typename T>
+Compressed<T> compress(int numMajor, const std::vector<int32_t>& major, const std::vector<int32_t>& minor,
+                       const std::vector<T>& values) {
+    // Counting sort by major index, stable in the input order
+    std::vector<int64_t> start(numMajor + 1, 0);
+    for (int32_t m : major) start[m + 1]++;
+    std::partial_sum(start.begin(), start.end(), start.begin());
+    std::vector<std::pair<int32_t, T>> entries(values.size());
+    std::vector<int64_t> next(start.begin(), start.end() - 1);
+    for (size_t e = 0; e < values.size(); e++) entries[next[major[e]]++] = {minor[e], values[e]};
+
+    Compressed<T> out;
+    out.offsets.assign(numMajor + 1, 0);
+    out.indices.reserve(entries.size());
+    out.values.reserve(entries.size());
+    for (int m = 0; m < numMajor; m++) {
+        auto first = entries.begin() + start[m], last = entries.begin() + start[m + 1];
+        std::stable_sort(first, last, [](const std::pair<int32_t, T>& a, const std::pair<int32_t, T>& b) {
+            return a.first < b.first;
+        });
+        for (auto it = first; it != last; ++it) {
+            if (out.indices.size() > (size_t)out.offsets[m] && out.indices.back() == it->first) {
+                out.values.back() += it->second;
+            } else {
+                out.indices.push_back(it->first);
+                out.values.push_back(it->second);
+            }
+        }
+        out.offsets[m + 1] = (int64_t)out.indices.size();
+    }
+    return out;
+}
+
+// Transposes a compressed matrix of numMajor groups over numMinor indices;
+// a counting sort keeps each output group sorted
+template <typename T>
+Compressed<T> transpose(int numMajor, int numMinor, const std::vector<int64_t>& offsets,
+                        const std::vector<int32_t>& indices, const std::vector<T>& values) {
+    Compressed<T> out;
+    out.offsets.assign(numMinor + 1, 0);
+    for (int32_t m : indices) out.offsets[m + 1]++;
+    std::partial_sum(out.offsets.begin(), out.offsets.end(), out.offsets.begin());
+    out.indices.resize(indices.size());
+    out.values.resize(values.size());
+    std::vector<int64_t> next(out.offsets.begin(), out.offsets.end() - 1);
+    for (int m = 0; m < numMajor; m++) {
+        for (int64_t e = offsets[m]; e < offsets[m + 1]; e++) {
+            const int64_t at = next[indices[e]]++;
+            out.indices[at] = m;
+            out.values[at] = values[e];
+        }
+    }
+    return out;
+}
+
+// Checks offsets and indices handed to a constructor
+inline void validate(int numMajor, int numMinor, const std::vector<int64_t>& offsets,
+                     const std::vector<int32_t>& indices, size_t numValues, const char* what) {
+    if (numMajor < 0 || numMinor < 0 || offsets.size() != (size_t)numMajor + 1 || offsets[0] != 0 ||
+        (size_t)offsets.back() != indices.size() || indices.size() != numValues) {
+        throw std::invalid_argument(what);
+    }
+    for (int m = 0; m < numMajor; m++) {
+        if (offsets[m + 1] < offsets[m]) throw std::invalid_argument(what);
+        for (int64_t e = offsets[m]; e < offsets[m + 1]; e++) {
+            if (indices[e] < 0 || indices[e] >= numMinor || (e > offsets[m] && indices[e] <= indices[e - 1])) {
+                throw std::invalid_argument(what);
+            }
+        }
+    }
+}
+
+inline int threadCount(int threads) {
+#ifdef _OPENMP
+    return threads > 0 ? threads : omp_get_max_threads();
+#else
+    (void)threads;
+    return 1;
+#endif
+}
+
+// Runs body(part) for every part in [0, parts) on a team of up to parts
+// threads. OpenMP may grant fewer (nested regions, OMP_THREAD_LIMIT), so
+// the parts are dealt out by stride rather than one per thread number.
+template <typename Body>
+void forEachPart(int parts, Body body) {
+#ifdef _OPENMP
+#pragma omp parallel num_threads(parts)
+    {
+        for (int part = omp_get_thread_num(); part < parts; part += omp_get_num_threads()) body(part);
+    }
+#else
+    for (int part = 0; part < parts; part++) body(part);
+#endif
+}
+
+// First row of part t when rows are split into parts with equal shares of
+// the prefix sums in cost (cost[i] = work before row i, cost.size() = rows + 1)
+inline int splitRow(const std::vector<int64_t>& cost, int t, int parts) {
+    const int64_t target = (int64_t)((double)cost.back() * t / parts);
+    return (int)(std::lower_bound(cost.begin(), cost.end(), target) - cost.begin());
+}
+
+} // namespace sparse_detail
+
+template <typename T>
+class CscMatrix;
+
+template <typename T>
+class CsrMatrix {
+public:
+    CsrMatrix() : numRows(0), numCols(0), rowOffsets(1, 0) {}
+
+    // Takes ownership of prebuilt arrays; columns must be sorted and unique per row
+    CsrMatrix(int rows, int cols, std::vector<int64_t> offsets, std::vector<int32_t> columns, std::vector<T> values)
+        : numRows(rows), numCols(cols), rowOffsets(std::move(offsets)), columnIndex(std::move(columns)),
+          vals(std::move(values)) {
+        sparse_detail::validate(rows, cols, rowOffsets, columnIndex, vals.size(), "CsrMatrix: malformed arrays");
+    }
+
+    static CsrMatrix fromCoo(const CooMatrix<T>& coo) {
+        auto c = sparse_detail::compress(coo.rows(), coo.rowIndices(), coo.colIndices(), coo.values());
+        return CsrMatrix(coo.rows(), coo.cols(), std::move(c));
+    }
+
+    static CsrMatrix fromDense(ConstMatrixView<T> dense) { return fromCoo(CooMatrix<T>::fromDense(dense)); }
+
+    static CsrMatrix fromCsc(const CscMatrix<T>& csc) {
+        auto c = sparse_detail::transpose(csc.cols(), csc.rows(), csc.offsets(), csc.indices(), csc.values());
+        return CsrMatrix(csc.rows(), csc.cols(), std::move(c));
+    }
+
+    CooMatrix<T> toCoo() const {
+        CooMatrix<T> coo(numRows, numCols);
+        coo.reserve(vals.size());
+        for (int i = 0; i < numRows; i++) {
+            for (int64_t e = rowOffsets[i]; e < rowOffsets[i + 1]; e++) coo.add(i, columnIndex[e], vals[e]);
+        }
+        return coo;
+    }
+
+    Matrix<T> toDense() const {
+        Matrix<T> dense(numRows, numCols);
+        for (int i = 0; i < numRows; i++) {
+            for (int64_t e = rowOffsets[i]; e < rowOffsets[i + 1]; e++) dense(i, columnIndex[e]) = vals[e];
+        }
+        return dense;
+    }
+
+    int rows() const { return numRows; }
+    int cols() const { return numCols; }
+    int64_t nonZeros() const { return (int64_t)vals.size(); }
+    const std::vector<int64_t>& offsets() const { return rowOffsets; }
+    const std::vector<int32_t>& indices() const { return columnIndex; }
+    const std::vector<T>& values() const { return vals; }
+
+private:
+    CsrMatrix(int rows, int cols, sparse_detail::Compressed<T> c)
+        : numRows(rows), numCols(cols), rowOffsets(std::move(c.offsets)), columnIndex(std::move(c.indices)),
+          vals(std::move(c.values)) {}
+
+    int numRows, numCols;
+    std::vector<int64_t> rowOffsets;
+    std::vector<int32_t> columnIndex;
+    std::vector<T> vals;
+};
+
+template <typename T>
+class CscMatrix {
+public:
+    CscMatrix() : numRows(0), numCols(0), colOffsets(1, 0) {}
+
+    // Takes ownership of prebuilt arrays; rows must be sorted and unique per column
+    CscMatrix(int rows, int cols, std::vector<int64_t> offsets, std::vector<int32_t> rowIndices, std::vector<T> values)
+        : numRows(rows), numCols(cols), colOffsets(std::move(offsets)), rowIndex(std::move(rowIndices)),
+          vals(std::move(values)) {
+        sparse_detail::validate(cols, rows, colOffsets, rowIndex, vals.size(), "CscMatrix: malformed arrays");
+    }
+
+    static CscMatrix fromCoo(const CooMatrix<T>& coo) {
+        auto c = sparse_detail::compress(coo.cols(), coo.colIndices(), coo.rowIndices(), coo.values());
+        return CscMatrix(coo.rows(), coo.cols(), std::move(c));
+    }
+
+    static CscMatrix fromDense(ConstMatrixView<T> dense) { return fromCoo(CooMatrix<T>::fromDense(dense)); }
+
+    static CscMatrix fromCsr(const CsrMatrix<T>& csr) {
+        auto c = sparse_detail::transpose(csr.rows(), csr.cols(), csr.offsets(), csr.indices(), csr.values());
+        return CscMatrix(csr.rows(), csr.cols(), std::move(c));
+    }
+
+    CooMatrix<T> toCoo() const {
+        CooMatrix<T> coo(numRows, numCols);
+        coo.reserve(vals.size());
+        for (int j = 0; j < numCols; j++) {
+            for (int64_t e = colOffsets[j]; e < colOffsets[j + 1]; e++) coo.add(rowIndex[e], j, vals[e]);
+        }
+        return coo;
+    }
+
+    Matrix<T> toDense() const {
+        Matrix<T> dense(numRows, numCols);
+        for (int j = 0; j < numCols; j++) {
+            for (int64_t e = colOffsets[j]; e < colOffsets[j + 1]; e++) dense(rowIndex[e], j) = vals[e];
+        }
+        return dense;
+    }
+
+    int rows() const { return numRows; }
+    int cols() const { return numCols; }
+    int64_t nonZeros() const { return (int64_t)vals.size(); }
+    const std::vector<int64_t>& offsets() const { return colOffsets; }
+    const std::vector<int32_t>& indices() const { return rowIndex; }
+    const std::vector<T>& values() const { return vals; }
+
+private:
+    CscMatrix(int rows, int cols, sparse_detail::Compressed<T> c)
+        : numRows(rows), numCols(cols), colOffsets(std::move(c.offsets)), rowIndex(std::move(c.indices)),
+          vals(std::move(c.values)) {}
+
+    int numRows, numCols;
+    std::vector<int64_t> colOffsets;
+    std::vector<int32_t> rowIndex;
+    std::vector<T> vals;
+};
+
+// y = A * x, with x of A.cols() and y of A.rows() elements. threads <= 0
+// means omp_get_max_threads(); without OpenMP this runs serially.
+template <typename T>
+void spmv(const CsrMatrix<T>& A, const T* x, T* y, int threads = 0) {
+    const int64_t* offsets = A.offsets().data();
+    const int32_t* columns = A.indices().data();
+    const T* values = A.values().data();
+    const int parts = std::max(1, std::min(sparse_detail::threadCount(threads), A.rows()));
+    sparse_detail::forEachPart(parts, [&](int t) {
+        const int first = t == 0 ? 0 : sparse_detail::splitRow(A.offsets(), t, parts);
+        const int last = t + 1 == parts ? A.rows() : sparse_detail::splitRow(A.offsets(), t + 1, parts);
+        for (int i = first; i < last; i++) {
+            T sum = T(0);
+            for (int64_t e = offsets[i]; e < offsets[i + 1]; e++) sum += values[e] * x[columns[e]];
+            y[i] = sum;
+        }
+    });
+}
+
+template <typename T>
+std::vector<T> spmv(const CsrMatrix<T>& A, const std::vector<T>& x, int threads = 0) {
+    if ((int64_t)x.size() != A.cols()) throw std::invalid_argument("spmv: incompatible dimensions");
+    std::vector<T> y(A.rows());
+    spmv(A, x.data(), y.data(), threads);
+    return y;
+}
+
+// C = A * B, or C += A * B when accumulate is set, for dense B and C
+template <typename T>
+void spmm(const CsrMatrix<T>& A, ConstMatrixView<T> B, MatrixView<T> C, bool accumulate = false,
+          int threads = 0) {
+    if (B.rows() != A.cols() || C.rows() != A.rows() || C.cols() != B.cols()) {
+        throw std::invalid_argument("spmm: incompatible dimensions");
+    }
+    const int64_t* offsets = A.offsets().data();
+    const int32_t* columns = A.indices().data();
+    const T* values = A.values().data();
+    const int n = B.cols();
+    const int parts = std::max(1, std::min(sparse_detail::threadCount(threads), A.rows()));
+    sparse_detail::forEachPart(parts, [&](int t) {
+        const int first = t == 0 ? 0 : sparse_detail::splitRow(A.offsets(), t, parts);
+        const int last = t + 1 == parts ? A.rows() : sparse_detail::splitRow(A.offsets(), t + 1, parts);
+        for (int i = first; i < last; i++) {
+            T* c = C.row(i);
+            if (!accumulate) std::fill(c, c + n, T(0));
+            for (int64_t e = offsets[i]; e < offsets[i + 1]; e++) {
+                const T a = values[e];
+                const T* b = B.row(columns[e]);
+                for (int j = 0; j < n; j++) c[j] += a * b[j];
+            }
+        }
+    });
+}
+
+template <typename T>
+Matrix<T> spmm(const CsrMatrix<T>& A, const Matrix<T>& B, int threads = 0) {
+    if (B.rows() != A.cols()) throw std::invalid_argument("spmm: incompatible dimensions");
+    Matrix<T> C = Matrix<T>::uninitialized(A.rows(), B.cols());
+    spmm(A, B.view(), C.view(), false, threads);
+    return C;
+}
+
+enum class SpgemmAccumulator { Auto, Dense, Hash };
+
+namespace sparse_detail {
+
+// Dense accumulator: a value and a marker per column of B. The marker holds
+// the last row that touched the column, so nothing is cleared between rows.
+template <typename T>
+class DenseAccumulator {
+public:
+    explicit DenseAccumulator(int cols) : sums(cols), owner(cols, -1) {}
+
+    void begin(int row, int64_t) {
+        current = row;
+        touched.clear();
+    }
+    void add(int32_t col, T value) {
+        if (owner[col] != current) {
+            owner[col] = current;
+            sums[col] = value;
+            touched.push_back(col);
+        } else {
+            sums[col] += value;
+        }
+    }
+    // Appends the row sorted by column: sorting the touched columns costs
+    // about log2(touched) steps each, so a row touching more than an eighth
+    // of the columns is read back by scanning the markers instead
+    void flush(std::vector<int32_t>& columns, std::vector<T>& values) {
+        if (touched.size() * 8 >= sums.size()) {
+            for (int32_t col = 0; col < (int32_t)sums.size(); col++) {
+                if (owner[col] == current) {
+                    columns.push_back(col);
+                    values.push_back(sums[col]);
+                }
+            }
+            return;
+        }
+        std::sort(touched.begin(), touched.end());
+        for (int32_t col : touched) {
+            columns.push_back(col);
+            values.push_back(sums[col]);
+        }
+    }
+
+private:
+    std::vector<T> sums;
+    std::vector<int32_t> owner, touched;
+    int current = -1;
+};
+
+// Hash accumulator: open addressing with linear probing, resized per row to
+// a power of two at least twice the row's flop count, so it stays in cache
+// however wide B is
+template <typename T>
+class HashAccumulator {
+public:
+    void begin(int, int64_t flops) {
+        size_t capacity = 16;
+        while (capacity < 2 * (size_t)flops) capacity *= 2;
+        if (keys.size() < capacity) {
+            keys.assign(capacity, -1);
+            sums.resize(capacity);
+        }
+        mask = capacity - 1;
+        used.clear();
+    }
+    void add(int32_t col, T value) {
+        size_t slot = ((uint32_t)col * 2654435761u) & mask;
+        while (keys[slot] != col) {
+            if (keys[slot] == -1) {
+                keys[slot] = col;
+                sums[slot] = value;
+                used.push_back(slot);
+                return;
+            }
+            slot = (slot + 1) & mask;
+        }
+        sums[slot] += value;
+    }
+    // Appends the row sorted by column and empties the used slots
+    void flush(std::vector<int32_t>& columns, std::vector<T>& values) {
+        entries.clear();
+        for (size_t slot : used) {
+            entries.push_back({keys[slot], sums[slot]});
+            keys[slot] = -1;
+        }
+        std::sort(entries.begin(), entries.end(),
+                  [](const std::pair<int32_t, T>& a, const std::pair<int32_t, T>& b) { return a.first < b.first; });
+        for (const auto& entry : entries) {
+            columns.push_back(entry.first);
+            values.push_back(entry.second);
+        }
+    }
+
+private:
+    std::vector<int32_t> keys;
+    std::vector<T> sums;
+    std::vector<size_t> used;
+    std::vector<std::pair<int32_t, T>> entries;
+    size_t mask = 0;
+};
+
+// Rows [first, last) of A * B into one thread's buffers; counts[i] gets the
+// length of row i
+template <typename T, typename Accumulator>
+void gustavson(const CsrMatrix<T>& A, const CsrMatrix<T>& B, const std::vector<int64_t>& flops, int first,
+               int last, Accumulator& acc, std::vector<int32_t>& columns, std::vector<T>& values,
+               std::vector<int64_t>& counts) {
+    const std::vector<int64_t>& aOffsets = A.offsets();
+    const std::vector<int32_t>& aColumns = A.indices();
+    const std::vector<T>& aValues = A.values();
+    const std::vector<int64_t>& bOffsets = B.offsets();
+    const std::vector<int32_t>& bColumns = B.indices();
+    const std::vector<T>& bValues = B.values();
+    for (int i = first; i < last; i++) {
+        const size_t before = columns.size();
+        acc.begin(i, flops[i + 1] - flops[i]);
+        for (int64_t e = aOffsets[i]; e < aOffsets[i + 1]; e++) {
+            const int32_t k = aColumns[e];
+            const T a = aValues[e];
+            for (int64_t f = bOffsets[k]; f < bOffsets[k + 1]; f++) acc.add(bColumns[f], a * bValues[f]);
+        }
+        acc.flush(columns, values);
+        counts[i] = (int64_t)(columns.size() - before);
+    }
+}
+
+} // namespace sparse_detail
+
+// C = A * B with all three in CSR. Auto takes the dense accumulator while a
+// value and a marker per column of B fit in 2 MiB per thread, and the hash
+// accumulator beyond that. Explicit zeros from cancellation are kept.
+template <typename T>
+CsrMatrix<T> spgemm(const CsrMatrix<T>& A, const CsrMatrix<T>& B, int threads = 0,
+                    SpgemmAccumulator accumulator = SpgemmAccumulator::Auto) {
+    if (B.rows() != A.cols()) throw std::invalid_argument("spgemm: incompatible dimensions");
+    const int m = A.rows();
+    if (accumulator == SpgemmAccumulator::Auto) {
+        const size_t denseBytes = (size_t)B.cols() * (sizeof(T) + sizeof(int32_t));
+        accumulator = denseBytes <= ((size_t)2 << 20) ? SpgemmAccumulator::Dense : SpgemmAccumulator::Hash;
+    }
+
+    // Prefix sums of the multiply-adds per row, and of the bound they and
+    // B.cols() put on the row's length
+    std::vector<int64_t> flops(m + 1, 0), bound(m + 1, 0);
+    for (int i = 0; i < m; i++) {
+        int64_t work = 0;
+        for (int64_t e = A.offsets()[i]; e < A.offsets()[i + 1]; e++) {
+            const int32_t k = A.indices()[e];
+            work += B.offsets()[k + 1] - B.offsets()[k];
+        }
+        flops[i + 1] = flops[i] + work;
+        bound[i + 1] = bound[i] + std::min<int64_t>(work, B.cols());
+    }
+
+    const int parts = std::max(1, std::min(sparse_detail::threadCount(threads), m));
+    std::vector<std::vector<int32_t>> partColumns(parts);
+    std::vector<std::vector<T>> partValues(parts);
+    std::vector<int> bounds(parts + 1);
+    for (int t = 1; t < parts; t++) bounds[t] = sparse_detail::splitRow(flops, t, parts);
+    bounds[parts] = m;
+    std::vector<int64_t> offsets(m + 1, 0);
+
+    sparse_detail::forEachPart(parts, [&](int t) {
+        // Reserving the bound keeps the buffers from being copied as they grow
+        partColumns[t].reserve(bound[bounds[t + 1]] - bound[bounds[t]]);
+        partValues[t].reserve(bound[bounds[t + 1]] - bound[bounds[t]]);
+        if (accumulator == SpgemmAccumulator::Dense) {
+            sparse_detail::DenseAccumulator<T> acc(B.cols());
+            sparse_detail::gustavson(A, B, flops, bounds[t], bounds[t + 1], acc, partColumns[t], partValues[t],
+                                     offsets);
+        } else {
+            sparse_detail::HashAccumulator<T> acc;
+            sparse_detail::gustavson(A, B, flops, bounds[t], bounds[t + 1], acc, partColumns[t], partValues[t],
+                                     offsets);
+        }
+    });
+
+    // offsets held row lengths shifted by one; the prefix sum places each part
+    std::rotate(offsets.begin(), offsets.end() - 1, offsets.end());
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<int32_t> columns(offsets[m]);
+    std::vector<T> values(offsets[m]);
+    sparse_detail::forEachPart(parts, [&](int t) {
+        std::copy(partColumns[t].begin(), partColumns[t].end(), columns.begin() + offsets[bounds[t]]);
+        std::copy(partValues[t].begin(), partValues[t].end(), values.begin() + offsets[bounds[t]]);
+    });
+    return CsrMatrix<T>(A.rows(), B.cols(), std::move(offsets), std::move(columns), std::move(values));
+}
+
+#endif // SPARSE_MATRIX_HPP
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// Strassen.hpp
+// Strassen-Winograd multiplication: each level does 7 half-size products
+// and 15 additions instead of 8 products, recursing until a dimension reaches
+// the cutoff and finishing with the packed gemm from Gemm.hpp. Every
+// quadrant is a view and every temporary comes from one workspace sized by
+// strassenWorkspaceSize up front, so the recursion never allocates.
+//   Odd sizes: the even leading part recurses and the last column, the last
+//   row and the rank-1 term of the last k are computed directly (dynamic
+//   peeling), so any m x k by k x n shape works.
+//   Sequential levels use the schedule of Douglas et al., which needs only
+//   two temporaries, X (m/2 x max(k, n)/2) and Y (k/2 x n/2), and uses the
+//   quadrants of C as scratch.
+//   The top parallelDepth levels instead form S1..S4 and T1..T4, run the 7
+//   products as OpenMP tasks, each in its own slice of the workspace, and
+//   then combine them.
+
+#ifndef STRASSEN_HPP
+#define STRASSEN_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include "Gemm.hpp"
+#include "Matrix.hpp"
+
+struct StrassenOptions {
+    int cutoff = 512;       // Leaf gemm once any dimension is at most this
+    int parallelDepth = -1; // Levels whose products run as tasks; -1 picks from the thread count
+};
+
+namespace strassen_detail {
+
+// Elements of a rows x cols temporary with cache-line aligned rows
+template <typename T>
+size_t elements(int rows, int cols) {
+    return (size_t)rows * Matrix<T>::paddedStride(cols);
+}
+
+// Bump allocator over a caller-provided slice of the workspace
+template <typename T>
+class Arena {
+public:
+    Arena(T* base, size_t size) : base(base), size(size), used(0) {}
+
+    // rows x cols view whose stride fits strideCols columns
+    MatrixView<T> take(int rows, int cols, int strideCols) {
+        const int64_t ld = Matrix<T>::paddedStride(strideCols);
+        T* p = raw((size_t)rows * ld);
+        return MatrixView<T>(p, rows, cols, ld);
+    }
+    Arena slice(size_t count) { return Arena(raw(count), count); }
+
+    size_t mark() const { return used; }
+    void release(size_t mark) { used = mark; }
+
+private:
+    T* raw(size_t count) {
+        if (used + count > size) throw std::logic_error("strassen: workspace too small");
+        T* p = base + used;
+        used += count;
+        return p;
+    }
+
+    T* base;
+    size_t size;
+    size_t used;
+};
+
+// C = A + B and C = A - B; C may be A or B
+template <typename T>
+void add(MatrixView<T> C, ConstMatrixView<T> A, ConstMatrixView<T> B) {
+    for (int i = 0; i < C.rows(); i++) {
+        const T* a = A.row(i);
+        const T* b = B.row(i);
+        T* c = C.row(i);
+        for (int j = 0; j < C.cols(); j++) c[j] = a[j] + b[j];
+    }
+}
+
+template <typename T>
+void sub(MatrixView<T> C, ConstMatrixView<T> A, ConstMatrixView<T> B) {
+    for (int i = 0; i < C.rows(); i++) {
+        const T* a = A.row(i);
+        const T* b = B.row(i);
+        T* c = C.row(i);
+        for (int j = 0; j < C.cols(); j++) c[j] = a[j] - b[j];
+    }
+}
+
+// Completes C = A * B when only its m2 x n2 leading block holds the product
+// of the m2 x k2 and k2 x n2 leading blocks: adds the rank-1 term of the
+// last k, and computes the last column and the last row outright
+template <typename T>
+void peel(ConstMatrixView<T> A, ConstMatrixView<T> B, MatrixView<T> C, int m2, int k2, int n2) {
+    const int m = A.rows(), k = A.cols(), n = B.cols();
+    if (k2 < k) {
+        const T* b = B.row(k - 1);
+        for (int i = 0; i < m2; i++) {
+            const T a = A(i, k - 1);
+            T* c = C.row(i);
+            for (int j = 0; j < n2; j++) c[j] += a * b[j];
+        }
+    }
+    if (n2 < n) {
+        for (int i = 0; i < m; i++) {
+            T sum = T(0);
+            for (int p = 0; p < k; p++) sum += A(i, p) * B(p, n - 1);
+            C(i, n - 1) = sum;
+        }
+    }
+    if (m2 < m) {
+        T* c = C.row(m - 1);
+        std::fill(c, c + n2, T(0));
+        for (int p = 0; p < k; p++) {
+            const T a = A(m - 1, p);
+            const T* b = B.row(p);
+            for (int j = 0; j < n2; j++) c[j] += a * b[j];
+        }
+    }
+}
+
+inline bool isLeaf(int m, int k, int n, const StrassenOptions& options) {
+    return std::min(m, std::min(k, n)) <= std::max(1, options.cutoff);
+}
+
+// Workspace multiply() takes for an m x k by k x n product entered at depth
+template <typename T>
+size_t workspaceSize(int m, int k, int n, const StrassenOptions& options, int depth) {
+    if (isLeaf(m, k, n, options)) return 0;
+    const int hm = m / 2, hk = k / 2, hn = n / 2;
+    const size_t below = workspaceSize<T>(hm, hk, hn, options, depth + 1);
+    if (depth < options.parallelDepth) {
+        return 4 * elements<T>(hm, hk) + 4 * elements<T>(hk, hn) + 7 * elements<T>(hm, hn) + 7 * below;
+    }
+    return elements<T>(hm, std::max(hk, hn)) + elements<T>(hk, hn) + below;
+}
+
+template <typename T>
+void multiply(ConstMatrixView<T> A, ConstMatrixView<T> B, MatrixView<T> C, Arena<T>& ws,
+              const StrassenOptions& options, int depth);
+
+// C = A * B for even dimensions with two temporaries:
+//   P1 = A11 B11  P2 = A12 B21  P3 = S4 B22  P4 = A22 T4
+//   P5 = S1 T1    P6 = S2 T2    P7 = S3 T3
+//   C11 = P1 + P2, C12 = P1 + P6 + P5 + P3
+//   C21 = P1 + P6 + P7 - P4, C22 = P1 + P6 + P7 + P5
+template <typename T>
+void winogradSequential(ConstMatrixView<T> A, ConstMatrixView<T> B, MatrixView<T> C, Arena<T>& ws,
+                        const StrassenOptions& options, int depth) {
+    const int hm = A.rows() / 2, hk = A.cols() / 2, hn = B.cols() / 2;
+    ConstMatrixView<T> A11 = A.block(0, 0, hm, hk), A12 = A.block(0, hk, hm, hk),
+                       A21 = A.block(hm, 0, hm, hk), A22 = A.block(hm, hk, hm, hk),
+                       B11 = B.block(0, 0, hk, hn), B12 = B.block(0, hn, hk, hn),
+                       B21 = B.block(hk, 0, hk, hn), B22 = B.block(hk, hn, hk, hn);
+    MatrixView<T> C11 = C.block(0, 0, hm, hn), C12 = C.block(0, hn, hm, hn),
+                  C21 = C.block(hm, 0, hm, hn), C22 = C.block(hm, hn, hm, hn);
+
+    const size_t mark = ws.mark();
+    MatrixView<T> X = ws.take(hm, hk, std::max(hk, hn));
+    MatrixView<T> Xn(X.data(), hm, hn, X.stride()); // X reused for an hm x hn product
+    MatrixView<T> Y = ws.take(hk, hn, hn);
+
+    sub<T>(X, A11, A21); // S3
+    sub<T>(Y, B22, B12); // T3
+    multiply<T>(X, Y, C21, ws, options, depth + 1); // P7
+    add<T>(X, A21, A22); // S1
+    sub<T>(Y, B12, B11); // T1
+    multiply<T>(X, Y, C22, ws, options, depth + 1); // P5
+    sub<T>(X, X, A11); // S2
+    sub<T>(Y, B22, Y); // T2
+    multiply<T>(X, Y, C12, ws, options, depth + 1); // P6
+    sub<T>(X, A12, X); // S4
+    multiply<T>(X, B22, C11, ws, options, depth + 1); // P3
+    multiply<T>(A11, B11, Xn, ws, options, depth + 1); // P1
+    add<T>(C12, Xn, C12); // U2 = P1 + P6
+    add<T>(C21, C12, C21); // U3 = U2 + P7
+    add<T>(C12, C12, C22); // U4 = U2 + P5
+    add<T>(C22, C21, C22); // C22 = U3 + P5
+    add<T>(C12, C12, C11); // C12 = U4 + P3
+    sub<T>(Y, Y, B21); // T4
+    multiply<T>(A22, Y, C11, ws, options, depth + 1); // P4
+    sub<T>(C21, C21, C11); // C21 = U3 - P4
+    multiply<T>(A12, B21, C11, ws, options, depth + 1); // P2
+    add<T>(C11, Xn, C11); // C11 = P1 + P2
+    ws.release(mark);
+}
+
+// Same products with every operand in its own temporary, so the seven
+// multiplies are independent tasks
+template <typename T>
+void winogradParallel(ConstMatrixView<T> A, ConstMatrixView<T> B, MatrixView<T> C, Arena<T>& ws,
+                      const StrassenOptions& options, int depth) {
+    const int hm = A.rows() / 2, hk = A.cols() / 2, hn = B.cols() / 2;
+    ConstMatrixView<T> A11 = A.block(0, 0, hm, hk), A12 = A.block(0, hk, hm, hk),
+                       A21 = A.block(hm, 0, hm, hk), A22 = A.block(hm, hk, hm, hk),
+                       B11 = B.block(0, 0, hk, hn), B12 = B.block(0, hn, hk, hn),
+                       B21 = B.block(hk, 0, hk, hn), B22 = B.block(hk, hn, hk, hn);
+
+    const size_t mark = ws.mark();
+    MatrixView<T> S[4], Tm[4], P[7];
+    for (int i = 0; i < 4; i++) S[i] = ws.take(hm, hk, hk);
+    for (int i = 0; i < 4; i++) Tm[i] = ws.take(hk, hn, hn);
+    for (int i = 0; i < 7; i++) P[i] = ws.take(hm, hn, hn);
+    add<T>(S[0], A21, A22); // S1
+    sub<T>(S[1], S[0], A11); // S2
+    sub<T>(S[2], A11, A21); // S3
+    sub<T>(S[3], A12, S[1]); // S4
+    sub<T>(Tm[0], B12, B11); // T1
+    sub<T>(Tm[1], B22, Tm[0]); // T2
+    sub<T>(Tm[2], B22, B12); // T3
+    sub<T>(Tm[3], Tm[1], B21); // T4
+
+    const ConstMatrixView<T> lhs[7] = {A11, A12, S[3], A22, S[0], S[1], S[2]};
+    const ConstMatrixView<T> rhs[7] = {B11, B21, B22, Tm[3], Tm[0], Tm[1], Tm[2]};
+    const size_t below = workspaceSize<T>(hm, hk, hn, options, depth + 1);
+    for (int i = 0; i < 7; i++) {
+        Arena<T> child = ws.slice(below);
+#pragma omp task default(shared) firstprivate(i, child)
+        multiply<T>(lhs[i], rhs[i], P[i], child, options, depth + 1);
+    }
+#pragma omp taskwait
+
+    MatrixView<T> C11 = C.block(0, 0, hm, hn), C12 = C.block(0, hn, hm, hn),
+                  C21 = C.block(hm, 0, hm, hn), C22 = C.block(hm, hn, hm, hn);
+    add<T>(C11, P[0], P[1]); // P1 + P2
+    add<T>(P[5], P[0], P[5]); // U2 = P1 + P6
+    add<T>(P[6], P[5], P[6]); // U3 = U2 + P7
+    add<T>(C22, P[6], P[4]); // U3 + P5
+    sub<T>(C21, P[6], P[3]); // U3 - P4
+    add<T>(P[5], P[5], P[4]); // U4 = U2 + P5
+    add<T>(C12, P[5], P[2]); // U4 + P3
+    ws.release(mark);
+}
+
+template <typename T>
+void multiply(ConstMatrixView<T> A, ConstMatrixView<T> B, MatrixView<T> C, Arena<T>& ws,
+              const StrassenOptions& options, int depth) {
+    const int m = A.rows(), k = A.cols(), n = B.cols();
+    if (isLeaf(m, k, n, options)) {
+        gemm<T>(A, B, C);
+        return;
+    }
+    const int m2 = m & ~1, k2 = k & ~1, n2 = n & ~1;
+    ConstMatrixView<T> A2 = A.block(0, 0, m2, k2), B2 = B.block(0, 0, k2, n2);
+    MatrixView<T> C2 = C.block(0, 0, m2, n2);
+    if (depth < options.parallelDepth) {
+        winogradParallel<T>(A2, B2, C2, ws, options, depth);
+    } else {
+        winogradSequential<T>(A2, B2, C2, ws, options, depth);
+    }
+    peel<T>(A, B, C, m2, k2, n2);
+}
+
+// parallelDepth -1 becomes the fewest task levels giving every thread a product
+inline StrassenOptions resolve(StrassenOptions options) {
+    if (options.parallelDepth < 0) {
+#ifdef _OPENMP
+        const int threads = omp_get_max_threads();
+#else
+        const int threads = 1;
+#endif
+        options.parallelDepth = 0;
+        for (int tasks = 1; tasks < threads && options.parallelDepth < 3; tasks *= 7) options.parallelDepth++;
+    }
+    return options;
+}
+
+} // namespace strassen_detail
+
+// Elements of workspace strassenMultiply needs for an m x k by k x n product
+template <typename T>
+size_t strassenWorkspaceSize(int m, int k, int n, const StrassenOptions& options = {}) {
+    return strassen_detail::workspaceSize<T>(m, k, n, strassen_detail::resolve(options), 0);
+}
+
+// C = A * B using a caller-provided workspace of at least
+// strassenWorkspaceSize elements. C must not overlap A or B.
+template <typename T>
+void strassenMultiply(ConstMatrixView<T> A, ConstMatrixView<T> B, MatrixView<T> C, T* workspace,
+                      size_t workspaceSize, StrassenOptions options = {}) {
+    if (B.rows() != A.cols() || C.rows() != A.rows() || C.cols() != B.cols()) {
+        throw std::invalid_argument("strassenMultiply: incompatible dimensions");
+    }
+    options = strassen_detail::resolve(options);
+    if (workspaceSize < strassen_detail::workspaceSize<T>(A.rows(), A.cols(), B.cols(), options, 0)) {
+        throw std::invalid_argument("strassenMultiply: workspace too small");
+    }
+    strassen_detail::Arena<T> ws(workspace, workspaceSize);
+    if (options.parallelDepth > 0) {
+#pragma omp parallel
+#pragma omp single
+        strassen_detail::multiply<T>(A, B, C, ws, options, 0);
+    } else {
+        strassen_detail::multiply<T>(A, B, C, ws, options, 0);
+    }
+}
+
+template <typename T>
+Matrix<T> strassenMultiply(const Matrix<T>& A, const Matrix<T>& B, StrassenOptions options = {}) {
+    if (A.cols() != B.rows()) throw std::invalid_argument("strassenMultiply: incompatible dimensions");
+    options = strassen_detail::resolve(options);
+    Matrix<T> C(A.rows(), B.cols());
+    const size_t size = strassenWorkspaceSize<T>(A.rows(), A.cols(), B.cols(), options);
+    auto workspace = gemm_detail::alignedBuffer<T>(size);
+    strassenMultiply<T>(A, B, C.view(), workspace.get(), size, options);
+    return C;
+}
+
+#endif // STRASSEN_HPP
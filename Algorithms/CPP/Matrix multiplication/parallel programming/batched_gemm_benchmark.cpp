@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "BatchedGemm.hpp"
+
+using namespace std;
+using namespace std::chrono;
+
+// Triple loop allocating its result, as multiplyMatrices in MatrixMultiply.cpp
+template <typename T>
+Matrix<T> naive(const Matrix<T>& A, const Matrix<T>& B) {
+    Matrix<T> C(A.rows(), B.cols());
+    for (int i = 0; i < A.rows(); i++) {
+        for (int j = 0; j < B.cols(); j++) {
+            for (int k = 0; k < A.cols(); k++) C(i, j) += A(i, k) * B(k, j);
+        }
+    }
+    return C;
+}
+
+template <typename T>
+vector<T> randomValues(size_t count, mt19937& rng) {
+    vector<T> values(count);
+    for (T& v : values) v = T((int)(rng() % 19) - 9); // Small integers: exact in every type
+    return values;
+}
+
+template <typename T>
+Matrix<T> matrixAt(const vector<T>& values, size_t offset, int rows, int cols) {
+    Matrix<T> m(rows, cols);
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) m(i, j) = values[offset + (size_t)i * cols + j];
+    }
+    return m;
+}
+
+// Every product of a strided batch, with and without accumulation, serial
+// and split across threads, against the triple loop
+template <typename T, int M, int K, int N>
+bool checkStrided(GemmIsa isa, const char* type) {
+    gemmForceIsa(isa);
+    mt19937 rng(M * 10000 + K * 100 + N);
+    const size_t count = 37;
+    vector<T> A = randomValues<T>(count * M * K, rng), B = randomValues<T>(count * K * N, rng);
+    vector<T> initial = randomValues<T>(count * M * N, rng);
+    for (int threads : {1, 4}) {
+        vector<T> C(count * M * N), D = initial;
+        gemmBatched<M, K, N>(A.data(), B.data(), C.data(), count, false, threads);
+        gemmBatched<M, K, N>(A.data(), B.data(), D.data(), count, true, threads);
+        for (size_t b = 0; b < count; b++) {
+            Matrix<T> expected = naive(matrixAt(A, b * M * K, M, K), matrixAt(B, b * K * N, K, N));
+            Matrix<T> before = matrixAt(initial, b * M * N, M, N);
+            for (int i = 0; i < M; i++) {
+                for (int j = 0; j < N; j++) {
+                    const size_t at = b * M * N + (size_t)i * N + j;
+                    if (C[at] != expected(i, j) || D[at] != before(i, j) + expected(i, j)) {
+                        cout << "Test failed: " << gemmIsaName(isa) << " " << type << " " << M << "x" << K << "x"
+                             << N << " product " << b << endl;
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool checkMatrices(int m, int k, int n, const char* type) {
+    mt19937 rng(m + k + n);
+    vector<Matrix<T>> A, B, C;
+    for (int b = 0; b < 21; b++) {
+        A.push_back(matrixAt(randomValues<T>((size_t)m * k, rng), 0, m, k));
+        B.push_back(matrixAt(randomValues<T>((size_t)k * n, rng), 0, k, n));
+        C.emplace_back(m, n);
+    }
+    gemmBatched(A, B, C);
+    for (int b = 0; b < 21; b++) {
+        if (C[b] != naive(A[b], B[b])) {
+            cout << "Test failed: " << type << " batch of Matrix " << m << "x" << k << "x" << n << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool checkAll(GemmIsa isa, const char* type) {
+    bool ok = checkStrided<T, 1, 1, 1>(isa, type) && checkStrided<T, 4, 4, 4>(isa, type) &&
+              checkStrided<T, 8, 8, 8>(isa, type) && checkStrided<T, 16, 16, 16>(isa, type) &&
+              checkStrided<T, 32, 32, 32>(isa, type) && checkStrided<T, 3, 5, 7>(isa, type) &&
+              checkStrided<T, 13, 6, 12>(isa, type) && checkStrided<T, 20, 9, 40>(isa, type) &&
+              checkMatrices<T>(4, 4, 4, type) && checkMatrices<T>(32, 32, 32, type) &&
+              checkMatrices<T>(5, 3, 6, type) && checkMatrices<T>(4, 0, 4, type);
+    if (ok) cout << "Test passed: " << gemmIsaName(isa) << " " << type << endl;
+    return ok;
+}
+
+// Rates three ways over the same batch, sized to stay in L2 and swept
+// repeatedly: a fresh Matrix and triple loop per pair, the packed gemm per
+// pair, and one gemmBatched call per sweep
+template <typename T, int S>
+void benchmark(const char* type) {
+    const size_t count = std::max<size_t>(1, (1 << 19) / (3 * S * S * sizeof(T)));
+    const int sweeps = (int)std::max<size_t>(1, ((size_t)1 << 26) / (count * S * S * S));
+    mt19937 rng(S);
+    vector<T> A = randomValues<T>(count * S * S, rng), B = randomValues<T>(count * S * S, rng);
+    vector<T> C(count * S * S);
+    vector<Matrix<T>> As, Bs;
+    for (size_t b = 0; b < count; b++) {
+        As.push_back(matrixAt(A, b * S * S, S, S));
+        Bs.push_back(matrixAt(B, b * S * S, S, S));
+    }
+    auto time = [&](auto&& f) {
+        auto start = steady_clock::now();
+        for (int r = 0; r < sweeps; r++) f();
+        return duration<double>(steady_clock::now() - start).count();
+    };
+    T sink = 0;
+    const double perPair = time([&] {
+        for (size_t b = 0; b < count; b++) sink += naive(As[b], Bs[b])(0, 0);
+    });
+    const double packed = time([&] {
+        for (size_t b = 0; b < count; b++) sink += gemm(As[b], Bs[b])(0, 0);
+    });
+    const double batched = time([&] { gemmBatched<S, S, S>(A.data(), B.data(), C.data(), count, false, 1); });
+    volatile T keep = sink + C[0];
+    (void)keep;
+    const double flops = 2.0 * S * S * S * count * sweeps / 1e9;
+    cout << "  " << type << " " << S << "x" << S << ": triple loop " << flops / perPair << " GFLOPS, packed gemm "
+         << flops / packed << ", batched " << flops / batched << " (" << perPair / batched << "x the triple loop)"
+         << endl;
+}
+
+template <typename T>
+void benchmarkAll(const char* type) {
+    benchmark<T, 4>(type);
+    benchmark<T, 8>(type);
+    benchmark<T, 16>(type);
+    benchmark<T, 32>(type);
+}
+
+int main() {
+    GemmIsa best = gemmIsa();
+    bool ok = true;
+    for (GemmIsa isa : {GemmIsa::SSE2, GemmIsa::AVX2, GemmIsa::AVX512}) {
+        if (isa > best) break;
+        ok &= checkAll<float>(isa, "float") && checkAll<double>(isa, "double") && checkAll<int32_t>(isa, "int32") &&
+              checkAll<int64_t>(isa, "int64");
+    }
+    gemmForceIsa(best);
+    cout << "Square batches, one thread, " << gemmIsaName(best) << ":" << endl;
+    benchmarkAll<float>("float");
+    benchmarkAll<double>("double");
+    return ok ? 0 : 1;
+}
+
+// Compile with: g++ -std=c++17 -O3 -march=x86-64 -fopenmp batched_gemm_benchmark.cpp -o batched_gemm_benchmark
+// The base -march is deliberate: the wider kernels are selected at run time.
+// Run with: ./batched_gemm_benchmark
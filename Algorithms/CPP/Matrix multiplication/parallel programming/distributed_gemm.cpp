@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mpi.h>
+#include "DistributedGemm.hpp"
+
+using namespace std;
+
+// Small integers, so every product and sum is exact in every type
+template <typename T>
+T valueA(int i, int j) { return T((i * 7 + j * 3) % 11 - 5); }
+template <typename T>
+T valueB(int i, int j) { return T((i * 5 + j * 13) % 9 - 4); }
+
+// Distributed products of the generated operands, gathered on rank 0 and
+// compared with the local gemm; shapes cover partial blocks, more processes
+// than blocks and operands with a single block
+template <typename T>
+bool check(const ProcessGrid& grid, const char* type) {
+    const int shapes[][4] = {{1, 1, 1, 4}, {37, 53, 29, 4}, {64, 64, 64, 16}, {300, 250, 190, 32}, {70, 400, 90, 64}};
+    bool ok = true;
+    for (const auto& s : shapes) {
+        DistributedMatrix<T> A(grid, s[0], s[1], s[3]), B(grid, s[1], s[2], s[3]);
+        A.generate(valueA<T>);
+        B.generate(valueB<T>);
+        Matrix<T> expected;
+        if (grid.rank() == 0) {
+            Matrix<T> fullA(s[0], s[1]), fullB(s[1], s[2]);
+            for (int i = 0; i < s[0]; i++) {
+                for (int j = 0; j < s[1]; j++) fullA(i, j) = valueA<T>(i, j);
+            }
+            for (int i = 0; i < s[1]; i++) {
+                for (int j = 0; j < s[2]; j++) fullB(i, j) = valueB<T>(i, j);
+            }
+            expected = gemm(fullA, fullB);
+        }
+        DistributedMatrix<T> C(grid, s[0], s[2], s[3]);
+        summa(A, B, C);
+        Matrix<T> result = C.gather(0);
+        if (grid.rank() == 0 && result != expected) {
+            cout << "Test failed: SUMMA " << type << " " << s[0] << "x" << s[1] << "x" << s[2] << endl;
+            ok = false;
+        }
+        if (grid.rows() == grid.cols()) {
+            DistributedMatrix<T> D(grid, s[0], s[2], s[3]);
+            D.scatter(expected, 0); // Cannon accumulates onto the scattered product: D = 2 * A * B
+            cannon(A, B, D);
+            result = D.gather(0);
+            if (grid.rank() == 0) {
+                for (int i = 0; i < s[0]; i++) {
+                    for (int j = 0; j < s[2]; j++) expected(i, j) *= 2;
+                }
+                if (result != expected) {
+                    cout << "Test failed: Cannon " << type << " " << s[0] << "x" << s[1] << "x" << s[2] << endl;
+                    ok = false;
+                }
+            }
+        }
+    }
+    if (grid.rank() == 0 && ok) cout << "Test passed: " << type << endl;
+    return ok;
+}
+
+// Seconds for the slowest rank
+template <typename F>
+double timed(F run) {
+    MPI_Barrier(MPI_COMM_WORLD);
+    double start = MPI_Wtime();
+    run();
+    double elapsed = MPI_Wtime() - start, slowest;
+    MPI_Reduce(&elapsed, &slowest, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    return slowest;
+}
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    {
+        ProcessGrid grid(MPI_COMM_WORLD);
+        const int n = argc >= 2 ? atoi(argv[1]) : 2048;
+        const int nb = argc >= 3 ? atoi(argv[2]) : 128;
+        if (grid.rank() == 0) {
+            cout << "Process grid " << grid.rows() << " x " << grid.cols() << ", local gemm " << gemmIsaName(gemmIsa())
+                 << endl;
+        }
+        bool ok = check<double>(grid, "double") & check<int64_t>(grid, "int64");
+
+        // Operands are generated in place, so n can exceed what one rank could hold
+        DistributedMatrix<double> A(grid, n, n, nb), B(grid, n, n, nb), C(grid, n, n, nb);
+        A.generate(valueA<double>);
+        B.generate(valueB<double>);
+        double seconds = timed([&] { summa(A, B, C); });
+        if (grid.rank() == 0) {
+            cout << "SUMMA " << n << "x" << n << ", block " << nb << ": " << seconds << " s, "
+                 << 2.0 * n * n * n / seconds / 1e9 << " GFLOP/s" << endl;
+        }
+        if (grid.rows() == grid.cols()) {
+            seconds = timed([&] { cannon(A, B, C); });
+            if (grid.rank() == 0) {
+                cout << "Cannon " << n << "x" << n << ", block " << nb << ": " << seconds << " s, "
+                     << 2.0 * n * n * n / seconds / 1e9 << " GFLOP/s" << endl;
+            }
+        }
+        int allOk, mine = ok ? 1 : 0;
+        MPI_Allreduce(&mine, &allOk, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+        ok = allOk;
+        if (!ok) {
+            MPI_Finalize();
+            return 1;
+        }
+    }
+    MPI_Finalize();
+    return 0;
+}
+
+// Compile with: mpicxx -std=c++17 -O3 -march=x86-64 distributed_gemm.cpp -o distributed_gemm
+// Run with: mpirun -n 4 ./distributed_gemm [size [block size]]   (also -n 9, -n 16; -n 6 runs SUMMA only)
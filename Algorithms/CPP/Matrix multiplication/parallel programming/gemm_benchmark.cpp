@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include "Gemm.hpp"
+#include "Strassen.hpp"
+
+using namespace std;
+using namespace std::chrono;
+
+namespace peak_detail {
+
+// Independent multiply-add chains on registers only: the FLOP rate one core
+// can sustain with this vector width, the ceiling gemm is measured against
+template <typename T, int VB>
+__attribute__((always_inline)) inline double run(long iterations) {
+    typedef typename gemm_detail::VectorOf<T, VB>::type V;
+    constexpr int chains = 12;
+    V acc[chains], x = V{} + T(1.0000001), y = V{} + T(0.9999999);
+    for (int c = 0; c < chains; c++) acc[c] = V{} + T(c);
+    auto start = steady_clock::now();
+    for (long it = 0; it < iterations; it++) {
+        for (int c = 0; c < chains; c++) acc[c] = acc[c] * x + y;
+    }
+    double seconds = duration<double>(steady_clock::now() - start).count();
+    T sink = 0;
+    for (int c = 0; c < chains; c++) sink += acc[c][0];
+    volatile T keep = sink;
+    (void)keep;
+    return 2.0 * chains * (VB / sizeof(T)) * iterations / seconds / 1e9;
+}
+
+template <typename T>
+double sse2(long iterations) { return run<T, 16>(iterations); }
+#if defined(__x86_64__) || defined(__i386__)
+template <typename T>
+__attribute__((target("avx2,fma"))) double avx2(long iterations) { return run<T, 32>(iterations); }
+template <typename T>
+__attribute__((target("avx512f,avx512dq,fma"))) double avx512(long iterations) { return run<T, 64>(iterations); }
+#endif
+
+} // namespace peak_detail
+
+template <typename T>
+double peakGflops(GemmIsa isa) {
+    const long iterations = 50000000;
+#if defined(__x86_64__) || defined(__i386__)
+    if (isa == GemmIsa::AVX512) return peak_detail::avx512<T>(iterations);
+    if (isa == GemmIsa::AVX2) return peak_detail::avx2<T>(iterations);
+#endif
+    return peak_detail::sse2<T>(iterations);
+}
+
+template <typename T>
+Matrix<T> randomMatrix(int rows, int cols, mt19937& rng) {
+    Matrix<T> m(rows, cols);
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) m(i, j) = T((int)(rng() % 19) - 9); // Small integers: exact in every type
+    }
+    return m;
+}
+
+template <typename T>
+Matrix<T> naive(const Matrix<T>& A, const Matrix<T>& B) {
+    Matrix<T> C(A.rows(), B.cols());
+    for (int i = 0; i < A.rows(); i++) {
+        for (int k = 0; k < A.cols(); k++) {
+            for (int j = 0; j < B.cols(); j++) C(i, j) += A(i, k) * B(k, j);
+        }
+    }
+    return C;
+}
+
+// Odd shapes cross every edge case: partial MR/NR tiles and several KC/MC/NC blocks
+template <typename T>
+bool checkShapes(GemmIsa isa, const char* type) {
+    gemmForceIsa(isa);
+    mt19937 rng(7);
+    GemmBlocking small;
+    small.mc = 40;
+    small.kc = 37;
+    small.nc = 96;
+    const int shapes[][3] = {{1, 1, 1}, {5, 3, 7}, {13, 29, 33}, {97, 65, 130}, {200, 300, 100}};
+    for (const auto& s : shapes) {
+        Matrix<T> A = randomMatrix<T>(s[0], s[1], rng), B = randomMatrix<T>(s[1], s[2], rng);
+        Matrix<T> expected = naive(A, B);
+        Matrix<T> C(s[0], s[2]);
+        gemm<T>(A, B, C.view(), false, small);
+        if (C != expected || gemm(A, B) != expected) {
+            cout << "Test failed: " << gemmIsaName(isa) << " " << type << " " << s[0] << "x" << s[1] << "x" << s[2]
+                 << endl;
+            return false;
+        }
+    }
+    // Accumulating into a view of a larger matrix leaves the rest untouched
+    Matrix<T> A = randomMatrix<T>(20, 30, rng), B = randomMatrix<T>(30, 25, rng), big = randomMatrix<T>(40, 40, rng);
+    Matrix<T> before = big, product = naive(A, B);
+    gemm<T>(A, B, big.block(3, 5, 20, 25), true);
+    for (int i = 0; i < 40; i++) {
+        for (int j = 0; j < 40; j++) {
+            bool inside = i >= 3 && i < 23 && j >= 5 && j < 30;
+            if (big(i, j) != before(i, j) + (inside ? product(i - 3, j - 5) : T(0))) {
+                cout << "Test failed: " << gemmIsaName(isa) << " " << type << " accumulate into a block" << endl;
+                return false;
+            }
+        }
+    }
+    cout << "Test passed: " << gemmIsaName(isa) << " " << type << endl;
+    return true;
+}
+
+// Every thread count and grid shape must give the serial result bit for bit:
+// each element sees the same KC blocks in the same order either way
+template <typename T>
+bool checkParallel(GemmIsa isa, const char* type) {
+    gemmForceIsa(isa);
+    mt19937 rng(11);
+    const int shapes[][3] = {{1, 1, 1}, {3, 50, 500}, {500, 40, 3}, {97, 65, 130}, {250, 300, 260}};
+    for (const auto& s : shapes) {
+        Matrix<T> A = randomMatrix<T>(s[0], s[1], rng), B = randomMatrix<T>(s[1], s[2], rng);
+        Matrix<T> expected = gemm(A, B);
+        for (int threads : {1, 2, 3, 4, 6, 7, 16}) {
+            Matrix<T> base = randomMatrix<T>(s[0], s[2], rng), C = base;
+            gemmParallel<T>(A, B, C.view(), true, threads);
+            for (int i = 0; i < s[0]; i++) {
+                for (int j = 0; j < s[2]; j++) base(i, j) += expected(i, j);
+            }
+            if (gemmParallel(A, B, threads) != expected || C != base) {
+                cout << "Test failed: parallel " << gemmIsaName(isa) << " " << type << " " << s[0] << "x" << s[1]
+                     << "x" << s[2] << " on " << threads << " threads" << endl;
+                return false;
+            }
+        }
+    }
+    // Called from inside a parallel region the nested team has one thread,
+    // which must still cover every rectangle
+    Matrix<T> A = randomMatrix<T>(256, 256, rng), B = randomMatrix<T>(256, 256, rng);
+    Matrix<T> expected = gemm(A, B), nested;
+#pragma omp parallel num_threads(2)
+#pragma omp single
+    nested = gemmParallel(A, B, 4);
+    if (nested != expected) {
+        cout << "Test failed: parallel " << gemmIsaName(isa) << " " << type << " called from a parallel region"
+             << endl;
+        return false;
+    }
+    cout << "Test passed: parallel " << gemmIsaName(isa) << " " << type << endl;
+    return true;
+}
+
+// Strassen-Winograd against the naive product on odd and rectangular shapes,
+// with cutoffs small enough to reach peeling at several depths and both the
+// sequential and the task-parallel schedule
+template <typename T>
+bool checkStrassen(const char* type) {
+    mt19937 rng(13);
+    const int shapes[][3] = {{1, 1, 1}, {2, 2, 2}, {3, 5, 7}, {17, 16, 15}, {65, 63, 67}, {100, 33, 250}};
+    for (const auto& s : shapes) {
+        Matrix<T> A = randomMatrix<T>(s[0], s[1], rng), B = randomMatrix<T>(s[1], s[2], rng);
+        Matrix<T> expected = naive(A, B);
+        for (int cutoff : {1, 4, 16, 512}) {
+            for (int depth : {0, 1, 2}) {
+                StrassenOptions options;
+                options.cutoff = cutoff;
+                options.parallelDepth = depth;
+                if (strassenMultiply(A, B, options) != expected) {
+                    cout << "Test failed: Strassen " << type << " " << s[0] << "x" << s[1] << "x" << s[2]
+                         << " cutoff " << cutoff << " depth " << depth << endl;
+                    return false;
+                }
+            }
+        }
+    }
+    cout << "Test passed: Strassen " << type << endl;
+    return true;
+}
+
+// One level of Strassen-Winograd per halving above the cutoff, timed against
+// the plain packed gemm with the workspace allocated once outside the loop
+template <typename T>
+void strassenComparison(const char* type, int maxSize) {
+    mt19937 rng(2);
+    for (int n = 1024; n <= maxSize; n *= 2) {
+        Matrix<T> A = randomMatrix<T>(n, n, rng), B = randomMatrix<T>(n, n, rng), C(n, n);
+        const size_t size = strassenWorkspaceSize<T>(n, n, n);
+        auto workspace = gemm_detail::alignedBuffer<T>(size);
+        gemmParallel<T>(A, B, C.view());
+        auto start = steady_clock::now();
+        gemmParallel<T>(A, B, C.view());
+        double gemmSeconds = duration<double>(steady_clock::now() - start).count();
+        strassenMultiply<T>(A, B, C.view(), workspace.get(), size);
+        start = steady_clock::now();
+        strassenMultiply<T>(A, B, C.view(), workspace.get(), size);
+        double strassenSeconds = duration<double>(steady_clock::now() - start).count();
+        cout << "  " << type << " " << n << "x" << n << ": gemm " << gemmSeconds << " s, Strassen-Winograd "
+             << strassenSeconds << " s (workspace " << size * sizeof(T) / (1 << 20) << " MiB)" << endl;
+    }
+}
+
+template <typename T>
+void benchmark(GemmIsa isa, const char* type, int maxSize) {
+    gemmForceIsa(isa);
+    double peak = peakGflops<T>(isa);
+    cout << gemmIsaName(isa) << " " << type << ": single-core FMA peak " << peak << " GFLOP/s" << endl;
+    mt19937 rng(1);
+    for (int n = 256; n <= maxSize; n *= 2) {
+        Matrix<T> A = randomMatrix<T>(n, n, rng), B = randomMatrix<T>(n, n, rng), C(n, n);
+        gemm<T>(A, B, C.view()); // Warm up
+        int repeats = max(1, (int)(2e9 / (2.0 * n * n * n)));
+        auto start = steady_clock::now();
+        for (int r = 0; r < repeats; r++) gemm<T>(A, B, C.view());
+        double seconds = duration<double>(steady_clock::now() - start).count() / repeats;
+        double gflops = 2.0 * n * n * n / seconds / 1e9;
+        cout << "  " << n << "x" << n << ": " << gflops << " GFLOP/s, " << 100 * gflops / peak << "% of peak" << endl;
+    }
+}
+
+// Rows written by the same static, spread-bound schedule gemmParallel uses,
+// so the pages of A start on the nodes of the threads that pack them
+template <typename T>
+Matrix<T> firstTouchMatrix(int n) {
+    Matrix<T> m = Matrix<T>::uninitialized(n, n);
+#pragma omp parallel for schedule(static) proc_bind(spread)
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) m(i, j) = T((i * 31 + j * 17) % 19 - 9);
+    }
+    return m;
+}
+
+// Strong scaling of one n x n product from 1 thread up to all of them
+template <typename T>
+void scaling(const char* type, int n) {
+#ifdef _OPENMP
+    const int maxThreads = omp_get_max_threads();
+#else
+    const int maxThreads = 1;
+#endif
+    Matrix<T> A = firstTouchMatrix<T>(n), B = firstTouchMatrix<T>(n);
+    cout << gemmIsaName(gemmIsa()) << " " << type << " " << n << "x" << n << " scaling:" << endl;
+    double base = 0;
+    for (int threads = 1;; threads = min(2 * threads, maxThreads)) {
+        Matrix<T> C = gemmParallel(A, B, threads); // Warm up and first touch of C
+        auto start = steady_clock::now();
+        gemmParallel<T>(A, B, C.view(), false, threads);
+        double seconds = duration<double>(steady_clock::now() - start).count();
+        double gflops = 2.0 * n * n * n / seconds / 1e9;
+        if (threads == 1) base = gflops;
+        GemmGrid grid = gemmGrid(threads, n, n);
+        cout << "  " << threads << " threads (" << grid.rows << "x" << grid.cols << " grid): " << gflops
+             << " GFLOP/s, speedup " << gflops / base << ", efficiency " << 100 * gflops / base / threads << "%"
+             << endl;
+        if (threads == maxThreads) break;
+    }
+}
+
+int main(int argc, char** argv) {
+    int maxSize = argc >= 2 ? atoi(argv[1]) : 2048;
+    GemmIsa best = gemmIsa();
+    cout << "Detected " << gemmIsaName(best) << endl;
+
+    bool ok = true;
+    for (GemmIsa isa : {GemmIsa::SSE2, GemmIsa::AVX2, GemmIsa::AVX512}) {
+        if (isa > best) break;
+        ok &= checkShapes<float>(isa, "float") && checkShapes<double>(isa, "double") &&
+              checkShapes<int32_t>(isa, "int32") && checkShapes<int64_t>(isa, "int64") &&
+              checkParallel<float>(isa, "float") && checkParallel<int64_t>(isa, "int64");
+    }
+    gemmForceIsa(best);
+    ok &= checkStrassen<double>("double") && checkStrassen<int64_t>("int64");
+    for (GemmIsa isa : {GemmIsa::SSE2, GemmIsa::AVX2, GemmIsa::AVX512}) {
+        if (isa > best) break;
+        benchmark<float>(isa, "float", maxSize);
+        benchmark<double>(isa, "double", maxSize);
+    }
+    gemmForceIsa(best);
+    scaling<float>("float", maxSize);
+    scaling<double>("double", maxSize);
+    cout << "Strassen-Winograd vs packed gemm:" << endl;
+    strassenComparison<float>("float", maxSize);
+    strassenComparison<double>("double", maxSize);
+    return ok ? 0 : 1;
+}
+
+// Compile with: g++ -std=c++17 -O3 -march=x86-64 -fopenmp gemm_benchmark.cpp -o gemm_benchmark
+// The base -march is deliberate: the wider kernels are selected at run time.
+// Run with: OMP_PLACES=cores ./gemm_benchmark [max size]
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <utility>
+#include "MixedGemm.hpp"
+
+using namespace std;
+using namespace std::chrono;
+
+// Reference with 64-bit sums
+template <typename In>
+Matrix<int32_t> reference(const Matrix<In>& A, const Matrix<In>& B) {
+    Matrix<int32_t> C(A.rows(), B.cols());
+    for (int i = 0; i < A.rows(); i++) {
+        for (int j = 0; j < B.cols(); j++) {
+            int64_t sum = 0;
+            for (int k = 0; k < A.cols(); k++) sum += (int64_t)A(i, k) * B(k, j);
+            C(i, j) = (int32_t)sum;
+        }
+    }
+    return C;
+}
+
+template <typename Half>
+Matrix<float> halfReference(const Matrix<Half>& A, const Matrix<Half>& B) {
+    Matrix<float> C(A.rows(), B.cols());
+    for (int i = 0; i < A.rows(); i++) {
+        for (int j = 0; j < B.cols(); j++) {
+            double sum = 0;
+            for (int k = 0; k < A.cols(); k++) sum += double(float(A(i, k))) * double(float(B(k, j)));
+            C(i, j) = (float)sum;
+        }
+    }
+    return C;
+}
+Matrix<float> reference(const Matrix<bfloat16>& A, const Matrix<bfloat16>& B) { return halfReference(A, B); }
+Matrix<float> reference(const Matrix<float16>& A, const Matrix<float16>& B) { return halfReference(A, B); }
+
+template <typename In>
+In randomValue(mt19937& rng, int range) {
+    return In((int)(rng() % (2 * range + 1)) - range);
+}
+template <>
+bfloat16 randomValue<bfloat16>(mt19937& rng, int range) {
+    return bfloat16((float)((int)(rng() % (2 * range + 1)) - range));
+}
+template <>
+float16 randomValue<float16>(mt19937& rng, int range) {
+    return float16((float)((int)(rng() % (2 * range + 1)) - range));
+}
+
+template <typename In>
+Matrix<In> randomMatrix(int rows, int cols, mt19937& rng, int range) {
+    Matrix<In> m = Matrix<In>::uninitialized(rows, cols);
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) m(i, j) = randomValue<In>(rng, range);
+    }
+    return m;
+}
+
+// Shapes cross partial tiles, k not a multiple of the group size and several
+// KC blocks. int8 uses its full range, int16 a range whose sums fit int32,
+// and the half floats small integers, whose products and sums are exact.
+template <typename In>
+bool checkPath(MixedPath path, const char* type, int range) {
+    mixedForcePath(path);
+    mt19937 rng(5);
+    const int shapes[][3] = {{1, 1, 1}, {5, 3, 7}, {13, 29, 33}, {50, 1100, 40}, {200, 130, 300}};
+    for (const auto& s : shapes) {
+        Matrix<In> A = randomMatrix<In>(s[0], s[1], rng, range), B = randomMatrix<In>(s[1], s[2], rng, range);
+        auto expected = reference(A, B);
+        if (gemm(A, B) != expected) {
+            cout << "Test failed: " << mixedPathName(path) << " " << type << " " << s[0] << "x" << s[1] << "x" << s[2]
+                 << endl;
+            return false;
+        }
+    }
+    // Accumulating into a block of a larger matrix leaves the rest untouched
+    Matrix<In> A = randomMatrix<In>(20, 30, rng, range), B = randomMatrix<In>(30, 25, rng, range);
+    auto product = reference(A, B);
+    auto big = reference(randomMatrix<In>(40, 8, rng, 3), randomMatrix<In>(8, 40, rng, 3));
+    auto before = big;
+    gemm(A.view(), B.view(), big.block(3, 5, 20, 25), true);
+    for (int i = 0; i < 40; i++) {
+        for (int j = 0; j < 40; j++) {
+            bool inside = i >= 3 && i < 23 && j >= 5 && j < 30;
+            if (big(i, j) != before(i, j) + (inside ? product(i - 3, j - 5) : 0)) {
+                cout << "Test failed: " << mixedPathName(path) << " " << type << " accumulate into a block" << endl;
+                return false;
+            }
+        }
+    }
+    cout << "Test passed: " << mixedPathName(path) << " " << type << endl;
+    return true;
+}
+
+template <typename In>
+bool checkAllPaths(const char* type, int range) {
+    bool ok = true;
+    for (MixedPath path : mixedPaths<In>()) ok &= checkPath<In>(path, type, range);
+    mixedForcePath(MixedPath::Auto);
+    return ok;
+}
+
+// Every float16 survives the trip through float; rounding ties go to even
+bool checkConversions() {
+    for (uint32_t h = 0; h < 0x10000; h++) {
+        const float f = float16::toFloat((uint16_t)h);
+        const bool nan = (h & 0x7c00) == 0x7c00 && (h & 0x3ff);
+        if (nan ? !std::isnan(f) || !std::isnan(float(float16(f))) : float16::fromFloat(f) != h) {
+            cout << "Test failed: float16 round trip of 0x" << hex << h << dec << endl;
+            return false;
+        }
+    }
+    struct Case {
+        float value;
+        uint16_t half, brain;
+    };
+    const Case cases[] = {
+        {1.0f, 0x3c00, 0x3f80},
+        {-2.5f, 0xc100, 0xc020},
+        {1.0f + 1.0f / 2048, 0x3c00, 0x3f80}, // Halfway between float16 1 and its successor: even
+        {1.0f + 3.0f / 2048, 0x3c02, 0x3f80},
+        {1.0f + 1.0f / 256, 0x3c04, 0x3f80},  // Halfway for bfloat16: even
+        {1.0f + 3.0f / 256, 0x3c0c, 0x3f82},
+        {65504.0f, 0x7bff, 0x4780},
+        {65520.0f, 0x7c00, 0x4780},           // Rounds past the largest float16
+        {5.9604644775390625e-8f, 0x0001, 0x3380}, // Smallest float16 subnormal
+        {2.9802322387695312e-8f, 0x0000, 0x3300}, // Half of it ties to zero
+        {1e-3f, 0x1419, 0x3a83},
+    };
+    for (const Case& c : cases) {
+        if (float16::fromFloat(c.value) != c.half || bfloat16::fromFloat(c.value) != c.brain) {
+            cout << "Test failed: rounding " << c.value << endl;
+            return false;
+        }
+    }
+    cout << "Test passed: float16 round trips and rounding" << endl;
+    return true;
+}
+
+// Multiply-adds per second, counting 2 operations per multiply-add
+template <typename In>
+double gops(int n, int repeats) {
+    mt19937 rng(1);
+    Matrix<In> A = randomMatrix<In>(n, n, rng, 100), B = randomMatrix<In>(n, n, rng, 100);
+    auto C = gemm(A, B);
+    auto start = steady_clock::now();
+    for (int r = 0; r < repeats; r++) gemm(as_const(A).view(), as_const(B).view(), C.view());
+    double seconds = duration<double>(steady_clock::now() - start).count();
+    return 2.0 * n * n * n * repeats / seconds / 1e9;
+}
+
+template <typename In>
+void benchmark(const char* type, int n, double floatGops) {
+    for (MixedPath path : mixedPaths<In>()) {
+        mixedForcePath(path);
+        double rate = gops<In>(n, 3);
+        cout << "  " << type << " " << mixedPathName(path) << ": " << rate << " GOPS (" << rate / floatGops
+             << "x float)" << endl;
+    }
+    mixedForcePath(MixedPath::Auto);
+}
+
+int main(int argc, char** argv) {
+    int n = argc >= 2 ? atoi(argv[1]) : 1024;
+    bool ok = checkConversions();
+    ok &= checkAllPaths<int8_t>("int8", 128) && checkAllPaths<int16_t>("int16", 1000) &&
+          checkAllPaths<bfloat16>("bfloat16", 16) && checkAllPaths<float16>("float16", 16);
+
+    double floatGops = gops<float>(n, 3);
+    cout << n << "x" << n << "x" << n << ", one thread; float gemm (" << gemmIsaName(gemmIsa())
+         << "): " << floatGops << " GOPS" << endl;
+    benchmark<int8_t>("int8", n, floatGops);
+    benchmark<int16_t>("int16", n, floatGops);
+    benchmark<bfloat16>("bfloat16", n, floatGops);
+    benchmark<float16>("float16", n, floatGops);
+    return ok ? 0 : 1;
+}
+
+// Compile with: g++ -std=c++17 -O3 -march=x86-64 mixed_gemm_benchmark.cpp -o mixed_gemm_benchmark
+// The base -march is deliberate: the dot-product kernels are selected at run time.
+// Run with: ./mixed_gemm_benchmark [size]
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "Gemm.hpp"
+#include "SparseMatrix.hpp"
+
+using namespace std;
+using namespace std::chrono;
+
+// Random m x n matrix with about density * m * n small-integer nonzeros,
+// added in random order and with some positions repeated
+template <typename T>
+CooMatrix<T> randomSparse(int m, int n, double density, mt19937& rng) {
+    CooMatrix<T> coo(m, n);
+    const int64_t count = (int64_t)(density * m * n);
+    coo.reserve(count);
+    for (int64_t e = 0; e < count; e++) coo.add(rng() % m, rng() % n, T((int)(rng() % 9) + 1));
+    return coo;
+}
+
+template <typename T>
+Matrix<T> randomDense(int m, int n, mt19937& rng) {
+    Matrix<T> dense(m, n);
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < n; j++) dense(i, j) = T((int)(rng() % 19) - 9);
+    }
+    return dense;
+}
+
+bool checkConversions() {
+    CooMatrix<double> coo(4, 5);
+    coo.add(2, 3, 1.0);
+    coo.add(0, 4, 2.0);
+    coo.add(2, 1, 3.0);
+    coo.add(2, 3, 4.0); // Duplicate: summed
+    coo.add(3, 0, 5.0);
+    const Matrix<double> expected = {{0, 0, 0, 0, 2}, {0, 0, 0, 0, 0}, {0, 3, 0, 5, 0}, {5, 0, 0, 0, 0}};
+    CsrMatrix<double> csr = CsrMatrix<double>::fromCoo(coo);
+    CscMatrix<double> csc = CscMatrix<double>::fromCoo(coo);
+    const bool layout = csr.offsets() == vector<int64_t>{0, 1, 1, 3, 4} &&
+                        csr.indices() == vector<int32_t>{4, 1, 3, 0} && csc.offsets() == vector<int64_t>{0, 1, 2, 2, 3, 4} &&
+                        csc.indices() == vector<int32_t>{3, 2, 2, 0};
+    bool ok = layout && coo.toDense() == expected && csr.toDense() == expected && csc.toDense() == expected &&
+              CsrMatrix<double>::fromCsc(csc).toDense() == expected &&
+              CscMatrix<double>::fromCsr(csr).toDense() == expected &&
+              CsrMatrix<double>::fromCoo(csc.toCoo()).toDense() == expected &&
+              CscMatrix<double>::fromCoo(csr.toCoo()).toDense() == expected &&
+              CsrMatrix<double>::fromDense(expected).nonZeros() == 4;
+
+    // Larger random round trips through every format
+    mt19937 rng(1);
+    for (double density : {0.0, 0.01, 0.3}) {
+        CooMatrix<int64_t> random = randomSparse<int64_t>(70, 40, density, rng);
+        Matrix<int64_t> dense = random.toDense();
+        CsrMatrix<int64_t> r = CsrMatrix<int64_t>::fromCoo(random);
+        ok &= r.toDense() == dense && CscMatrix<int64_t>::fromCsr(r).toDense() == dense &&
+              CsrMatrix<int64_t>::fromCsc(CscMatrix<int64_t>::fromCoo(random)).toDense() == dense &&
+              CsrMatrix<int64_t>::fromDense(dense).toDense() == dense;
+    }
+
+    // Malformed arrays are rejected
+    int rejected = 0;
+    auto expectThrow = [&](auto&& f) {
+        try {
+            f();
+        } catch (const std::exception&) {
+            rejected++;
+        }
+    };
+    expectThrow([] { CsrMatrix<double>(2, 2, {0, 1}, {0}, {1.0}); });           // Too few offsets
+    expectThrow([] { CsrMatrix<double>(2, 2, {0, 2, 2}, {1, 0}, {1.0, 1.0}); }); // Unsorted row
+    expectThrow([] { CsrMatrix<double>(2, 2, {0, 1, 1}, {2}, {1.0}); });        // Column out of range
+    expectThrow([] { CooMatrix<double>(2, 2).add(2, 0, 1.0); });
+    ok &= rejected == 4;
+    cout << (ok ? "Test passed" : "Test failed") << ": COO, CSR and CSC conversions" << endl;
+    return ok;
+}
+
+// spmv, spmm and spgemm against the dense product, for empty and tall,
+// wide and square shapes, several thread counts and both accumulators
+bool checkKernels() {
+    mt19937 rng(2);
+    const int shapes[][3] = {{0, 5, 3}, {1, 1, 1}, {37, 50, 23}, {200, 90, 150}, {64, 700, 64}};
+    for (const auto& s : shapes) {
+        for (double density : {0.0, 0.02, 0.2}) {
+            CooMatrix<double> a = randomSparse<double>(s[0], s[1], density, rng);
+            CooMatrix<double> b = randomSparse<double>(s[1], s[2], density, rng);
+            CsrMatrix<double> A = CsrMatrix<double>::fromCoo(a), B = CsrMatrix<double>::fromCoo(b);
+            Matrix<double> denseA = a.toDense(), denseB = b.toDense(), X = randomDense<double>(s[1], 9, rng);
+            Matrix<double> expected = gemm(denseA, denseB), expectedX = gemm(denseA, X);
+            vector<double> x(s[1]);
+            for (int j = 0; j < s[1]; j++) x[j] = X(j, 0);
+            for (int threads : {1, 3, 4}) {
+                vector<double> y = spmv(A, x, threads);
+                bool ok = y.size() == (size_t)s[0];
+                for (int i = 0; i < s[0] && ok; i++) ok = y[i] == expectedX(i, 0);
+                Matrix<double> C = randomDense<double>(s[0], 9, rng), before = C;
+                spmm<double>(A, X, C.view(), true, threads);
+                for (int i = 0; i < s[0] && ok; i++) {
+                    for (int j = 0; j < 9 && ok; j++) ok = C(i, j) == before(i, j) + expectedX(i, j);
+                }
+                ok &= spmm(A, X, threads) == expectedX;
+                for (SpgemmAccumulator acc : {SpgemmAccumulator::Dense, SpgemmAccumulator::Hash}) {
+                    CsrMatrix<double> product = spgemm(A, B, threads, acc);
+                    ok &= product.toDense() == expected;
+                    for (double v : product.values()) ok &= v != 0.0; // Positive entries never cancel
+                }
+                if (!ok) {
+                    cout << "Test failed: " << s[0] << "x" << s[1] << "x" << s[2] << " at density " << density
+                         << " on " << threads << " threads" << endl;
+                    return false;
+                }
+            }
+        }
+    }
+    // Called from inside a parallel region the nested team has one thread,
+    // which must still cover every row range
+    CooMatrix<double> a = randomSparse<double>(300, 200, 0.05, rng), b = randomSparse<double>(200, 100, 0.05, rng);
+    CsrMatrix<double> A = CsrMatrix<double>::fromCoo(a), B = CsrMatrix<double>::fromCoo(b);
+    Matrix<double> X = randomDense<double>(200, 9, rng), expectedX = gemm(a.toDense(), X);
+    Matrix<double> expected = gemm(a.toDense(), b.toDense());
+    vector<double> x(200);
+    for (int j = 0; j < 200; j++) x[j] = X(j, 0);
+    bool ok = true;
+#pragma omp parallel num_threads(2)
+#pragma omp single
+    {
+        vector<double> y = spmv(A, x, 4);
+        for (int i = 0; i < 300; i++) ok &= y[i] == expectedX(i, 0);
+        ok &= spmm(A, X, 4) == expectedX;
+        for (SpgemmAccumulator acc : {SpgemmAccumulator::Dense, SpgemmAccumulator::Hash}) {
+            ok &= spgemm(A, B, 4, acc).toDense() == expected;
+        }
+    }
+    if (!ok) {
+        cout << "Test failed: sparse kernels called from a parallel region" << endl;
+        return false;
+    }
+    cout << "Test passed: spmv, spmm and spgemm" << endl;
+    return true;
+}
+
+template <typename F>
+double elapsed(F&& f) {
+    auto start = steady_clock::now();
+    f();
+    return duration<double>(steady_clock::now() - start).count();
+}
+
+// y = A * x over every element, the dense counterpart of spmv
+template <typename T>
+void denseMatVec(const Matrix<T>& A, const vector<T>& x, vector<T>& y) {
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < A.rows(); i++) {
+        const T* a = A.row(i);
+        T sum = T(0);
+        for (int j = 0; j < A.cols(); j++) sum += a[j] * x[j];
+        y[i] = sum;
+    }
+}
+
+// Times each sparse kernel and its dense counterpart on the same n x n
+// matrix over a range of densities, and reports where dense starts to win
+void densitySweep(int n) {
+    const int width = 64; // Columns of the dense operand of spmm
+    mt19937 rng(3);
+    Matrix<float> X = randomDense<float>(n, width, rng);
+    vector<float> x(n, 1.0f), y(n);
+
+    cout << "n = " << n << ", times in ms (sparse / dense), spmm against an n x " << width << " dense matrix:"
+         << endl;
+    double crossover[3] = {0, 0, 0};
+    for (double density : {0.0005, 0.001, 0.005, 0.01, 0.02, 0.05, 0.1, 0.2, 0.5}) {
+        CsrMatrix<float> A = CsrMatrix<float>::fromCoo(randomSparse<float>(n, n, density, rng));
+        Matrix<float> denseA = A.toDense();
+
+        const double spmvTime = elapsed([&] {
+            for (int r = 0; r < 10; r++) spmv(A, x.data(), y.data());
+        }) / 10;
+        const double mvTime = elapsed([&] {
+            for (int r = 0; r < 10; r++) denseMatVec(denseA, x, y);
+        }) / 10;
+        Matrix<float> C = Matrix<float>::uninitialized(n, width);
+        const double spmmTime = elapsed([&] { spmm<float>(A, X, C.view()); });
+        const double mmTime = elapsed([&] { gemmParallel<float>(denseA, X, C.view()); });
+        CsrMatrix<float> product;
+        const double spgemmTime = elapsed([&] { product = spgemm(A, A); });
+        Matrix<float> denseC = Matrix<float>::uninitialized(n, n);
+        const double gemmTime = elapsed([&] { gemmParallel<float>(denseA, denseA, denseC.view()); });
+
+        const double sparseBytes = (double)A.nonZeros() * (sizeof(float) + sizeof(int32_t)) + (n + 1) * 8.0;
+        cout << "  density " << density << " (" << A.nonZeros() << " nonzeros, " << (double)n * n * 4 / sparseBytes
+             << "x smaller than dense): spmv " << spmvTime * 1e3 << " / " << mvTime * 1e3 << ", spmm "
+             << spmmTime * 1e3 << " / " << mmTime * 1e3 << ", spgemm " << spgemmTime * 1e3 << " / " << gemmTime * 1e3
+             << " (" << product.nonZeros() << " nonzeros)" << endl;
+        const double ratios[3] = {spmvTime / mvTime, spmmTime / mmTime, spgemmTime / gemmTime};
+        for (int kernel = 0; kernel < 3; kernel++) {
+            if (crossover[kernel] == 0 && ratios[kernel] > 1) crossover[kernel] = density;
+        }
+    }
+    const char* names[3] = {"spmv", "spmm", "spgemm"};
+    for (int kernel = 0; kernel < 3; kernel++) {
+        cout << "  " << names[kernel] << ": ";
+        if (crossover[kernel] == 0) {
+            cout << "sparse wins at every density swept" << endl;
+        } else {
+            cout << "dense wins from density " << crossover[kernel] << endl;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    int n = argc >= 2 ? atoi(argv[1]) : 1024;
+    bool ok = checkConversions() && checkKernels();
+    densitySweep(n);
+    return ok ? 0 : 1;
+}
+
+// Compile with: g++ -std=c++17 -O3 -march=x86-64 -fopenmp sparse_benchmark.cpp -o sparse_benchmark
+// Run with: OMP_PLACES=cores ./sparse_benchmark [size]
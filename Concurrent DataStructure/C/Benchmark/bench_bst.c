@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+
+// Benchmarks the fine-grained locking BST; see bench_harness.h.
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_harness.h"
+#include "../Bst/fgl_bst.h"
+
+static void* bst_create(int key_range) {
+    (void)key_range;
+    struct Tree* tree = (struct Tree*)malloc(sizeof(struct Tree));
+    if (!tree) {
+        perror("malloc failed");
+        exit(EXIT_FAILURE);
+    }
+    tree->root = NULL;
+    pthread_mutex_init(&tree->mutex, NULL);
+    return tree;
+}
+
+static void bst_destroy_subtree(struct Node* node) {
+    if (node == NULL) {
+        return;
+    }
+    bst_destroy_subtree(node->left);
+    bst_destroy_subtree(node->right);
+    destroyNode(node);
+}
+
+static void bst_destroy(void* ds) {
+    struct Tree* tree = (struct Tree*)ds;
+    bst_destroy_subtree(tree->root);
+    pthread_mutex_destroy(&tree->mutex);
+    free(tree);
+}
+
+// insert() reports nothing; it counts as taken
+static int bst_insert(void* ds, int key) { insert((struct Tree*)ds, key); return 1; }
+static int bst_remove(void* ds, int key) { return delete((struct Tree*)ds, key); }
+static int bst_search(void* ds, int key) { return search((struct Tree*)ds, key); }
+
+static const BenchOps trees[] = {
+    {"fgl_bst", bst_create, bst_destroy, bst_insert, bst_remove, bst_search},
+};
+
+int main(int argc, char** argv) {
+    return bench_main(argc, argv, trees, (int)(sizeof(trees) / sizeof(trees[0])));
+}
+
+// Compile with: gcc bench_bst.c bench_harness.c ../Bst/fgl_bst.c -o bench_bst -pthread -O3
+// Run with: ./bench_bst --keys 65536 --mix 25:25 > bst.csv
@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+
+#define _GNU_SOURCE // pthread_setaffinity_np, CPU_SET
+#include <getopt.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "bench_harness.h"
+
+// One cache line per thread so counting does not add false sharing to the results
+typedef struct {
+    _Alignas(64) unsigned long ops;
+    unsigned long insert_ok;
+    unsigned long remove_ok;
+    unsigned long search_hit;
+    struct timespec begin; // Taken by the worker right after the start barrier
+    struct timespec end;   // and right after its last operation
+} BenchCounters;
+
+typedef struct {
+    const BenchOps* ops;
+    const BenchConfig* cfg;
+    void* ds;
+    int thread_id;
+    int insert_cut; // Draws in [0, insert_cut) insert, [insert_cut, remove_cut) remove
+    int remove_cut;
+    pthread_barrier_t* start;
+    BenchCounters* counters;
+} BenchWorker;
+
+// xorshift64*: cheap enough not to show up next to the measured operations
+static inline uint64_t bench_next(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static void bench_pin(int thread_id) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 1) {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(thread_id % cpus, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        fprintf(stderr, "warning: could not pin thread %d\n", thread_id);
+    }
+}
+
+static void* bench_worker(void* arg) {
+    BenchWorker* w = (BenchWorker*)arg;
+    const BenchOps* ops = w->ops;
+    BenchCounters local = {0};
+    uint64_t seed = 0x9E3779B97F4A7C15ULL * (uint64_t)(w->thread_id + 1);
+
+    if (w->cfg->pin) {
+        bench_pin(w->thread_id);
+    }
+    pthread_barrier_wait(w->start);
+    clock_gettime(CLOCK_MONOTONIC, &local.begin);
+
+    for (long i = 0; i < w->cfg->ops_per_thread; i++) {
+        uint64_t r = bench_next(&seed);
+        int draw = (int)(r % 100);
+        int key = (int)((r >> 32) % (uint64_t)w->cfg->key_range);
+        if (draw < w->insert_cut) {
+            local.insert_ok += ops->insert(w->ds, key) != 0;
+        } else if (draw < w->remove_cut) {
+            local.remove_ok += ops->remove(w->ds, key) != 0;
+        } else {
+            local.search_hit += ops->search(w->ds, key) != 0;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &local.end);
+    local.ops = (unsigned long)w->cfg->ops_per_thread;
+    *w->counters = local; // Single write at the end keeps the loop free of shared stores
+    return NULL;
+}
+
+// Inserts cfg->prefill distinct keys spread over the key range in shuffled order,
+// so ordered structures do not degenerate during prefill
+static void bench_prefill(const BenchOps* ops, void* ds, const BenchConfig* cfg) {
+    if (cfg->prefill <= 0) {
+        return;
+    }
+    int* keys = (int*)malloc((size_t)cfg->prefill * sizeof(int));
+    if (!keys) {
+        perror("malloc failed");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < cfg->prefill; i++) {
+        keys[i] = (int)((long)i * cfg->key_range / cfg->prefill);
+    }
+    uint64_t seed = 42;
+    for (int i = cfg->prefill - 1; i > 0; i--) {
+        int j = (int)(bench_next(&seed) % (uint64_t)(i + 1));
+        int tmp = keys[i];
+        keys[i] = keys[j];
+        keys[j] = tmp;
+    }
+    for (int i = 0; i < cfg->prefill; i++) {
+        ops->insert(ds, keys[i]);
+    }
+    free(keys);
+}
+
+static int bench_selected(const BenchConfig* cfg, const char* name) {
+    if (cfg->only == NULL) {
+        return 1;
+    }
+    size_t len = strlen(name);
+    const char* p = cfg->only;
+    while (*p) {
+        const char* end = strchr(p, ',');
+        size_t n = end ? (size_t)(end - p) : strlen(p);
+        if (n == len && strncmp(p, name, len) == 0) {
+            return 1;
+        }
+        if (!end) {
+            break;
+        }
+        p = end + 1;
+    }
+    return 0;
+}
+
+static int bench_before(const struct timespec* a, const struct timespec* b) {
+    return a->tv_sec < b->tv_sec || (a->tv_sec == b->tv_sec && a->tv_nsec < b->tv_nsec);
+}
+
+static void bench_run(const BenchOps* ops, const BenchConfig* cfg, int threads, int repeat) {
+    pthread_t tids[BENCH_MAX_THREADS];
+    BenchWorker workers[BENCH_MAX_THREADS];
+    BenchCounters* counters = (BenchCounters*)aligned_alloc(64, (size_t)threads * sizeof(BenchCounters));
+    if (!counters) {
+        perror("aligned_alloc failed");
+        exit(EXIT_FAILURE);
+    }
+
+    // Structures without lookups split the search share between insert and remove
+    int insert_pct = cfg->insert_pct;
+    int remove_pct = cfg->remove_pct;
+    if (ops->search == NULL) {
+        int search_pct = 100 - insert_pct - remove_pct;
+        insert_pct += search_pct / 2;
+        remove_pct = 100 - insert_pct;
+    }
+
+    void* ds = ops->create(cfg->key_range);
+    bench_prefill(ops, ds, cfg);
+
+    pthread_barrier_t start;
+    pthread_barrier_init(&start, NULL, (unsigned)threads + 1);
+    for (int t = 0; t < threads; t++) {
+        workers[t].ops = ops;
+        workers[t].cfg = cfg;
+        workers[t].ds = ds;
+        workers[t].thread_id = t;
+        workers[t].insert_cut = insert_pct;
+        workers[t].remove_cut = insert_pct + remove_pct;
+        workers[t].start = &start;
+        workers[t].counters = &counters[t];
+        if (pthread_create(&tids[t], NULL, bench_worker, &workers[t]) != 0) {
+            perror("Failed to create thread");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    pthread_barrier_wait(&start);
+    for (int t = 0; t < threads; t++) {
+        if (pthread_join(tids[t], NULL) != 0) {
+            perror("Failed to join thread");
+            exit(EXIT_FAILURE);
+        }
+    }
+    pthread_barrier_destroy(&start);
+
+    // The run spans the first worker starting to the last one finishing, as
+    // the workers saw it: main may be descheduled at the barrier and wake
+    // after the workers are already done
+    BenchCounters total = {0};
+    struct timespec begin = counters[0].begin, end = counters[0].end;
+    for (int t = 0; t < threads; t++) {
+        total.ops += counters[t].ops;
+        total.insert_ok += counters[t].insert_ok;
+        total.remove_ok += counters[t].remove_ok;
+        total.search_hit += counters[t].search_hit;
+        if (bench_before(&counters[t].begin, &begin)) {
+            begin = counters[t].begin;
+        }
+        if (bench_before(&end, &counters[t].end)) {
+            end = counters[t].end;
+        }
+    }
+    double seconds = (double)(end.tv_sec - begin.tv_sec) + (double)(end.tv_nsec - begin.tv_nsec) / 1e9;
+
+    printf("%s,%d,%d,%ld,%d,%d,%d,%d,%d,%.6f,%.3f,%lu,%lu,%lu\n",
+           ops->name, threads, repeat, cfg->ops_per_thread,
+           insert_pct, remove_pct, 100 - insert_pct - remove_pct,
+           cfg->key_range, cfg->pin, seconds, (double)total.ops / seconds / 1e6,
+           total.insert_ok, total.remove_ok, total.search_hit);
+    fflush(stdout);
+
+    ops->destroy(ds);
+    free(counters);
+}
+
+static void bench_usage(const char* prog, const BenchOps* targets, int count) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  -t, --threads LIST   thread counts, e.g. 1,2,4,8 (default 1,2,4,8)\n"
+            "  -n, --ops N          operations per thread (default 100000)\n"
+            "  -m, --mix I:R        insert and remove percentages, rest search (default 10:10)\n"
+            "  -k, --keys N         key range (default 1024)\n"
+            "  -p, --prefill N      keys inserted before timing (default keys / 2)\n"
+            "  -r, --repeat N       runs per configuration (default 3)\n"
+            "  -s, --structures L   comma-separated subset of:",
+            prog);
+    for (int i = 0; i < count; i++) {
+        fprintf(stderr, " %s", targets[i].name);
+    }
+    fprintf(stderr,
+            "\n"
+            "      --no-pin         leave thread placement to the scheduler\n"
+            "      --no-header      omit the CSV header row\n");
+}
+
+static int bench_parse_threads(BenchConfig* cfg, const char* list) {
+    cfg->thread_steps = 0;
+    const char* p = list;
+    while (*p) {
+        char* end;
+        long n = strtol(p, &end, 10);
+        if (end == p || n < 1 || n > BENCH_MAX_THREADS || cfg->thread_steps == BENCH_MAX_THREAD_STEPS) {
+            return 0;
+        }
+        cfg->threads[cfg->thread_steps++] = (int)n;
+        if (*end == '\0') {
+            break;
+        }
+        if (*end != ',') {
+            return 0;
+        }
+        p = end + 1;
+    }
+    return cfg->thread_steps > 0;
+}
+
+int bench_main(int argc, char** argv, const BenchOps* targets, int count) {
+    BenchConfig cfg = {
+        .threads = {1, 2, 4, 8},
+        .thread_steps = 4,
+        .ops_per_thread = 100000,
+        .insert_pct = 10,
+        .remove_pct = 10,
+        .key_range = 1024,
+        .prefill = -1,
+        .repeats = 3,
+        .pin = 1,
+        .header = 1,
+        .only = NULL,
+    };
+    static const struct option options[] = {
+        {"threads", required_argument, NULL, 't'},
+        {"ops", required_argument, NULL, 'n'},
+        {"mix", required_argument, NULL, 'm'},
+        {"keys", required_argument, NULL, 'k'},
+        {"prefill", required_argument, NULL, 'p'},
+        {"repeat", required_argument, NULL, 'r'},
+        {"structures", required_argument, NULL, 's'},
+        {"no-pin", no_argument, NULL, 'P'},
+        {"no-header", no_argument, NULL, 'H'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "t:n:m:k:p:r:s:h", options, NULL)) != -1) {
+        switch (opt) {
+            case 't':
+                if (!bench_parse_threads(&cfg, optarg)) {
+                    fprintf(stderr, "Invalid thread list: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'n':
+                cfg.ops_per_thread = atol(optarg);
+                break;
+            case 'm':
+                if (sscanf(optarg, "%d:%d", &cfg.insert_pct, &cfg.remove_pct) != 2 ||
+                    cfg.insert_pct < 0 || cfg.remove_pct < 0 || cfg.insert_pct + cfg.remove_pct > 100) {
+                    fprintf(stderr, "Invalid mix: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'k':
+                cfg.key_range = atoi(optarg);
+                break;
+            case 'p':
+                cfg.prefill = atoi(optarg);
+                break;
+            case 'r':
+                cfg.repeats = atoi(optarg);
+                break;
+            case 's':
+                cfg.only = optarg;
+                break;
+            case 'P':
+                cfg.pin = 0;
+                break;
+            case 'H':
+                cfg.header = 0;
+                break;
+            default:
+                bench_usage(argv[0], targets, count);
+                return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    if (cfg.ops_per_thread < 1 || cfg.key_range < 1 || cfg.repeats < 1) {
+        bench_usage(argv[0], targets, count);
+        return EXIT_FAILURE;
+    }
+    if (cfg.prefill < 0) {
+        cfg.prefill = cfg.key_range / 2;
+    } else if (cfg.prefill > cfg.key_range) {
+        cfg.prefill = cfg.key_range; // Prefill keys are distinct
+    }
+
+    if (cfg.header) {
+        printf("structure,threads,repeat,ops_per_thread,insert_pct,remove_pct,search_pct,"
+               "key_range,pinned,seconds,mops_per_sec,insert_ok,remove_ok,search_hit\n");
+    }
+    for (int i = 0; i < count; i++) {
+        if (!bench_selected(&cfg, targets[i].name)) {
+            continue;
+        }
+        for (int s = 0; s < cfg.thread_steps; s++) {
+            for (int r = 0; r < cfg.repeats; r++) {
+                bench_run(&targets[i], &cfg, cfg.threads[s], r);
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
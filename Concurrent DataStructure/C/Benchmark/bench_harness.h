@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// bench_harness.h
+// Shared driver for the C concurrent structure benchmarks. Each structure is
+// described by a BenchOps table; bench_main parses the command line, runs every
+// selected table at every thread count and prints one CSV row per run.
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#define BENCH_MAX_THREADS      128 // Largest thread count accepted on the command line
+#define BENCH_MAX_THREAD_STEPS 16  // Thread counts per --threads list
+
+// Operations a structure exposes to the harness. Keys lie in [0, key_range).
+// insert/remove/search return nonzero when the operation took effect or hit.
+typedef struct {
+    const char* name;
+    void* (*create)(int key_range);
+    void (*destroy)(void* ds);
+    int (*insert)(void* ds, int key);
+    int (*remove)(void* ds, int key); // Pop/dequeue for structures without keys
+    int (*search)(void* ds, int key); // NULL when the structure has no lookup
+} BenchOps;
+
+typedef struct {
+    int threads[BENCH_MAX_THREAD_STEPS];
+    int thread_steps;
+    long ops_per_thread;
+    int insert_pct;   // Remaining percentage after insert and remove goes to search
+    int remove_pct;
+    int key_range;
+    int prefill;      // Keys inserted before the timed phase
+    int repeats;
+    int pin;          // Pin worker i to online CPU i % ncpus
+    int header;       // Print the CSV header row
+    const char* only; // Comma-separated structure names, NULL for all
+} BenchConfig;
+
+// Runs the tables selected on the command line; returns the process exit status.
+int bench_main(int argc, char** argv, const BenchOps* targets, int count);
+
+#endif // BENCH_HARNESS_H
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+
+// Benchmarks the concurrent hash set and the cuckoo map against one chained
+// table behind a single mutex, the arrangement they replace; see bench_harness.h.
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_harness.h"
+#include "../Hash/concurrent_hash_set.h"
+#include "../Hash/cuckoo_map.h"
+#include "../../../DataStructure/C/hash/hash_probing.h"
+
+typedef struct {
+    pthread_mutex_t lock;
+    ListNode** buckets;
+    int bucket_count;
+} MutexHashSet;
+
+static void* mutex_create(int key_range) {
+    MutexHashSet* set = (MutexHashSet*)malloc(sizeof(MutexHashSet));
+    if (!set) {
+        perror("malloc failed");
+        exit(EXIT_FAILURE);
+    }
+    pthread_mutex_init(&set->lock, NULL);
+    set->bucket_count = key_range > 0 ? key_range : 1; // Sized up front, never resized
+    set->buckets = (ListNode**)calloc((size_t)set->bucket_count, sizeof(ListNode*));
+    if (!set->buckets) {
+        perror("calloc failed");
+        exit(EXIT_FAILURE);
+    }
+    return set;
+}
+
+static void mutex_destroy(void* ds) {
+    MutexHashSet* set = (MutexHashSet*)ds;
+    for (int b = 0; b < set->bucket_count; b++) {
+        chainBucketFree(set->buckets[b]);
+    }
+    free(set->buckets);
+    pthread_mutex_destroy(&set->lock);
+    free(set);
+}
+
+static int mutex_insert(void* ds, int key) {
+    MutexHashSet* set = (MutexHashSet*)ds;
+    pthread_mutex_lock(&set->lock);
+    ListNode** bucket = &set->buckets[hashFunction(key, set->bucket_count)];
+    int added = chainBucketSearch(*bucket, key) == NULL && chainBucketInsert(bucket, key);
+    pthread_mutex_unlock(&set->lock);
+    return added;
+}
+
+static int mutex_remove(void* ds, int key) {
+    MutexHashSet* set = (MutexHashSet*)ds;
+    pthread_mutex_lock(&set->lock);
+    int removed = chainBucketDelete(&set->buckets[hashFunction(key, set->bucket_count)], key);
+    pthread_mutex_unlock(&set->lock);
+    return removed;
+}
+
+static int mutex_search(void* ds, int key) {
+    MutexHashSet* set = (MutexHashSet*)ds;
+    pthread_mutex_lock(&set->lock);
+    int found = chainBucketSearch(set->buckets[hashFunction(key, set->bucket_count)], key) != NULL;
+    pthread_mutex_unlock(&set->lock);
+    return found;
+}
+
+// Both concurrent modes start small and grow on their own; the baseline is presized
+static void* striped_create(int key_range) { (void)key_range; return chs_create(CHS_STRIPED, 64); }
+static void* lock_free_create(int key_range) { (void)key_range; return chs_create(CHS_LOCK_FREE, 64); }
+static void chs_bench_destroy(void* ds) { chs_destroy((ConcurrentHashSet*)ds); }
+static int chs_bench_insert(void* ds, int key) { return chs_insert((ConcurrentHashSet*)ds, key); }
+static int chs_bench_remove(void* ds, int key) { return chs_remove((ConcurrentHashSet*)ds, key); }
+static int chs_bench_search(void* ds, int key) { return chs_contains((ConcurrentHashSet*)ds, key); }
+
+// The cuckoo map stores each key as its own value
+static void* cuckoo_create(int key_range) { (void)key_range; return cuckoo_map_create(64); }
+static void cuckoo_destroy(void* ds) { cuckoo_map_destroy((CuckooMap*)ds); }
+static int cuckoo_insert(void* ds, int key) { return cuckoo_map_insert((CuckooMap*)ds, key, key); }
+static int cuckoo_remove(void* ds, int key) { return cuckoo_map_erase((CuckooMap*)ds, key); }
+static int cuckoo_search(void* ds, int key) { return cuckoo_map_find((CuckooMap*)ds, key, NULL); }
+
+static const BenchOps sets[] = {
+    {"hash_global_mutex", mutex_create, mutex_destroy, mutex_insert, mutex_remove, mutex_search},
+    {"hash_striped", striped_create, chs_bench_destroy, chs_bench_insert, chs_bench_remove, chs_bench_search},
+    {"hash_lock_free", lock_free_create, chs_bench_destroy, chs_bench_insert, chs_bench_remove, chs_bench_search},
+    {"cuckoo_map", cuckoo_create, cuckoo_destroy, cuckoo_insert, cuckoo_remove, cuckoo_search},
+};
+
+int main(int argc, char** argv) {
+    return bench_main(argc, argv, sets, (int)(sizeof(sets) / sizeof(sets[0])));
+}
+
+// Compile with: gcc bench_hash.c bench_harness.c ../Hash/concurrent_hash_set.c ../Hash/cuckoo_map.c ../Reclamation/*.c -o bench_hash -pthread -O3
+// Run with: ./bench_hash --threads 1,8,32 --keys 1000000 --mix 5:5 > hash.csv
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+
+// Benchmarks the C linked lists under a common workload; see bench_harness.h.
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_harness.h"
+#include "../LinkedList/nl_linkedlist.h"
+#include "../LinkedList/cvm_linkedlist.h"
+#include "../LinkedList/lock_free_list.h"
+#include "../LinkedList/wait_free_list.h"
+
+static void* bench_alloc(size_t size) {
+    void* p = malloc(size);
+    if (!p) {
+        perror("malloc failed");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+// Naive locking: one mutex around the whole list
+static void* nl_create(int key_range) {
+    (void)key_range;
+    NL_LinkedList* list = (NL_LinkedList*)bench_alloc(sizeof(NL_LinkedList));
+    nl_list_init(list);
+    return list;
+}
+
+static void nl_destroy(void* ds) {
+    NL_LinkedList* list = (NL_LinkedList*)ds;
+    NL_Node* current = list->head;
+    while (current != NULL) {
+        NL_Node* next = current->next;
+        free(current);
+        current = next;
+    }
+    pthread_mutex_destroy(&list->lock);
+    free(list);
+}
+
+// The locking lists return nothing from insert/delete; those count as taken
+static int nl_insert(void* ds, int key) { nl_list_insert((NL_LinkedList*)ds, key); return 1; }
+static int nl_remove(void* ds, int key) { nl_list_delete((NL_LinkedList*)ds, key); return 1; }
+static int nl_search(void* ds, int key) { return nl_list_search((NL_LinkedList*)ds, key); }
+
+// Mutex plus condition variable
+static void* cvm_create(int key_range) {
+    (void)key_range;
+    CVM_LinkedList* list = (CVM_LinkedList*)bench_alloc(sizeof(CVM_LinkedList));
+    cvm_list_init(list);
+    return list;
+}
+
+static void cvm_destroy(void* ds) {
+    CVM_LinkedList* list = (CVM_LinkedList*)ds;
+    CVM_Node* current = list->head;
+    while (current != NULL) {
+        CVM_Node* next = current->next;
+        free(current);
+        current = next;
+    }
+    pthread_mutex_destroy(&list->lock);
+    pthread_cond_destroy(&list->cond);
+    free(list);
+}
+
+static int cvm_insert(void* ds, int key) { cvm_list_insert((CVM_LinkedList*)ds, key); return 1; }
+static int cvm_remove(void* ds, int key) { cvm_list_delete((CVM_LinkedList*)ds, key); return 1; }
+static int cvm_search(void* ds, int key) { return cvm_list_search((CVM_LinkedList*)ds, key); }
+
+// Lock-free list, one entry per reclamation scheme
+static void* lock_free_create(ReclaimMode mode) {
+    LockFreeList* list = (LockFreeList*)bench_alloc(sizeof(LockFreeList));
+    Lock_Free_list_init_mode(list, mode);
+    return list;
+}
+
+static void* lock_free_hp_create(int key_range) { (void)key_range; return lock_free_create(RECLAIM_HAZARD_POINTERS); }
+static void* lock_free_ebr_create(int key_range) { (void)key_range; return lock_free_create(RECLAIM_EPOCH); }
+
+static void lock_free_destroy(void* ds) {
+    Lock_Free_list_destroy((LockFreeList*)ds);
+    free(ds);
+}
+
+static int lock_free_insert(void* ds, int key) { Lock_Free_list_insert((LockFreeList*)ds, key); return 1; }
+static int lock_free_remove(void* ds, int key) { return Lock_Free_list_delete((LockFreeList*)ds, key); }
+static int lock_free_search(void* ds, int key) { return Lock_Free_list_search((LockFreeList*)ds, key); }
+
+// Wait-free ordered set, one entry per reclamation scheme
+static void* wait_free_create(ReclaimMode mode) {
+    WAIT_FREE_LockFreeList* list = (WAIT_FREE_LockFreeList*)bench_alloc(sizeof(WAIT_FREE_LockFreeList));
+    wait_free_list_init_mode(list, mode);
+    return list;
+}
+
+static void* wait_free_hp_create(int key_range) { (void)key_range; return wait_free_create(RECLAIM_HAZARD_POINTERS); }
+static void* wait_free_ebr_create(int key_range) { (void)key_range; return wait_free_create(RECLAIM_EPOCH); }
+
+static void wait_free_destroy(void* ds) {
+    wait_free_list_destroy((WAIT_FREE_LockFreeList*)ds);
+    free(ds);
+}
+
+static int wait_free_insert(void* ds, int key) { return wait_free_list_insert((WAIT_FREE_LockFreeList*)ds, key); }
+static int wait_free_remove(void* ds, int key) { return wait_free_list_delete((WAIT_FREE_LockFreeList*)ds, key); }
+static int wait_free_search(void* ds, int key) { return wait_free_list_search((WAIT_FREE_LockFreeList*)ds, key); }
+
+// fgl_list is not listed: fgl_list_insert swaps *head without holding any lock and
+// fgl_list_delete unlocks a new head it never locked, so it hangs or corrupts
+// itself under this workload instead of producing a number.
+static const BenchOps lists[] = {
+    {"nl_list", nl_create, nl_destroy, nl_insert, nl_remove, nl_search},
+    {"cvm_list", cvm_create, cvm_destroy, cvm_insert, cvm_remove, cvm_search},
+    {"lock_free_list_hp", lock_free_hp_create, lock_free_destroy, lock_free_insert, lock_free_remove, lock_free_search},
+    {"lock_free_list_ebr", lock_free_ebr_create, lock_free_destroy, lock_free_insert, lock_free_remove, lock_free_search},
+    {"wait_free_list_hp", wait_free_hp_create, wait_free_destroy, wait_free_insert, wait_free_remove, wait_free_search},
+    {"wait_free_list_ebr", wait_free_ebr_create, wait_free_destroy, wait_free_insert, wait_free_remove, wait_free_search},
+};
+
+int main(int argc, char** argv) {
+    return bench_main(argc, argv, lists, (int)(sizeof(lists) / sizeof(lists[0])));
+}
+
+// Compile with: gcc bench_lists.c bench_harness.c ../LinkedList/nl_linkedlist.c ../LinkedList/cvm_linkedlist.c ../LinkedList/lock_free_list.c ../LinkedList/wait_free_list.c ../Reclamation/*.c -o bench_lists -pthread -O3
+// Run with: ./bench_lists --threads 1,2,4,8 --ops 100000 --mix 10:10 > lists.csv
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+
+// Benchmarks the ring buffer through its non-blocking entry points, so a full or
+// empty buffer shows up as a failed operation instead of a parked thread; see
+// bench_harness.h. Capacity is --keys, prefill fills it to --prefill entries.
+// Build lockfree_ringbuffer.c with -DRING_BUFFER_QUIET or its tracing dominates.
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_harness.h"
+#include "../Queue/ring_buffer.h"
+
+static void* ring_create(int key_range) {
+    return initialize((size_t)key_range + 1); // One slot always stays empty
+}
+
+static void ring_destroy(void* ds) {
+    cleanupRingBuffer((RingBuffer*)ds);
+}
+
+static int ring_insert(void* ds, int key) {
+    return tryInsert((RingBuffer*)ds, key);
+}
+
+static int ring_remove(void* ds, int key) {
+    (void)key;
+    CoWData* data = tryRingBufferRemove((RingBuffer*)ds);
+    if (data == NULL) {
+        return 0;
+    }
+    free(data);
+    return 1;
+}
+
+static const BenchOps rings[] = {
+    {"ring_buffer", ring_create, ring_destroy, ring_insert, ring_remove, NULL},
+};
+
+int main(int argc, char** argv) {
+    return bench_main(argc, argv, rings, (int)(sizeof(rings) / sizeof(rings[0])));
+}
+
+// Compile with: gcc -DRING_BUFFER_QUIET bench_ring_buffer.c bench_harness.c ../Queue/lockfree_ringbuffer.c -o bench_ring_buffer -pthread -O3
+// Run with: ./bench_ring_buffer --mix 50:50 > ring_buffer.csv
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+
+// Benchmarks the Treiber stack under both reclamation schemes; see bench_harness.h.
+// Keys are ignored: insert pushes, remove pops, and the search share of --mix
+// is split between the two.
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_harness.h"
+#include "../Stack/wait_free_stack.h"
+
+static void* stack_create(ReclaimMode mode) {
+    WaitFreeStack* stack = (WaitFreeStack*)malloc(sizeof(WaitFreeStack));
+    if (!stack) {
+        perror("malloc failed");
+        exit(EXIT_FAILURE);
+    }
+    stack_init_mode(stack, mode);
+    return stack;
+}
+
+static void* stack_hp_create(int key_range) { (void)key_range; return stack_create(RECLAIM_HAZARD_POINTERS); }
+static void* stack_ebr_create(int key_range) { (void)key_range; return stack_create(RECLAIM_EPOCH); }
+
+static void stack_bench_destroy(void* ds) {
+    stack_destroy((WaitFreeStack*)ds);
+    free(ds);
+}
+
+static int stack_bench_push(void* ds, int key) {
+    stack_push((WaitFreeStack*)ds, key);
+    return 1;
+}
+
+static int stack_bench_pop(void* ds, int key) {
+    (void)key;
+    int value;
+    return stack_pop((WaitFreeStack*)ds, &value);
+}
+
+static const BenchOps stacks[] = {
+    {"wait_free_stack_hp", stack_hp_create, stack_bench_destroy, stack_bench_push, stack_bench_pop, NULL},
+    {"wait_free_stack_ebr", stack_ebr_create, stack_bench_destroy, stack_bench_push, stack_bench_pop, NULL},
+};
+
+int main(int argc, char** argv) {
+    return bench_main(argc, argv, stacks, (int)(sizeof(stacks) / sizeof(stacks[0])));
+}
+
+// Compile with: gcc bench_stack.c bench_harness.c ../Stack/wait_free_stack.c ../Reclamation/*.c -o bench_stack -pthread -O3
+// Run with: ./bench_stack --mix 50:50 > stack.csv
@@ -43,6 +43,18 @@ void unlockNode(struct Node* node) {
     pthread_mutex_unlock(&node->mutex);
 }
 
+// Every descent is lock-coupled: a child is locked before its parent is
+// released, and the tree mutex plays the parent's role for the root. A node
+// can only be unlinked by a thread holding its parent, so the child we are
+// about to lock cannot be freed underneath us.
+static void unlockParent(struct Tree* tree, struct Node* parent) {
+    if (parent != NULL) {
+        unlockNode(parent);
+    } else {
+        pthread_mutex_unlock(&tree->mutex);
+    }
+}
+
 void insert(struct Tree* tree, int value) {
     pthread_mutex_lock(&tree->mutex);
     if (tree->root == NULL) {
@@ -50,71 +62,52 @@ void insert(struct Tree* tree, int value) {
         pthread_mutex_unlock(&tree->mutex);
         return;
     }
-    pthread_mutex_unlock(&tree->mutex);
-
-    struct Node* parent = NULL;
     struct Node* current = tree->root;
-    while (current != NULL) {
-        lockNode(current);
-        if (parent != NULL) {
-            unlockNode(parent);
-        }
-        parent = current;
+    lockNode(current);
+    pthread_mutex_unlock(&tree->mutex);
 
-        if (value < current->value) {
-            current = current->left;
-        } else if (value > current->value) {
-            current = current->right;
-        } else {
-            // Value already exists, no insertion needed
-            unlockNode(parent);
-            return;
+    while (current->value != value) {
+        struct Node** link = (value < current->value) ? &current->left : &current->right;
+        if (*link == NULL) {
+            *link = createNode(value);
+            break;
         }
+        struct Node* next = *link;
+        lockNode(next);
+        unlockNode(current);
+        current = next;
     }
-
-    struct Node* newNode = createNode(value);
-    if (value < parent->value) {
-        parent->left = newNode;
-    } else {
-        parent->right = newNode;
-    }
-    unlockNode(parent);
+    // Either inserted below current or the value already exists
+    unlockNode(current);
 }
 
 bool delete(struct Tree* tree, int value) {
-    struct Node* parent = NULL;
-    struct Node* node = tree->root;
+    struct Node* parent = NULL; // NULL means the tree mutex is held instead
     struct Node** childLink = &(tree->root);
 
-    // Find the node to delete and its parent.
-    while (node != NULL) {
-        lockNode(node);
-        if (value < node->value) {
-            if (parent != NULL) {
-                unlockNode(parent);
-            }
-            parent = node;
-            childLink = &(node->left);
-            node = node->left;
-        } else if (value > node->value) {
-            if (parent != NULL) {
-                unlockNode(parent);
-            }
-            parent = node;
-            childLink = &(node->right);
-            node = node->right;
-        } else {
-            break; // Found the node to delete.
-        }
-    }
-
+    // Find the node to delete and its parent, holding both when we stop.
+    pthread_mutex_lock(&tree->mutex);
+    struct Node* node = tree->root;
     if (node == NULL) {
-        // Value not found.
-        if (parent != NULL) {
-            unlockNode(parent);
-        }
+        pthread_mutex_unlock(&tree->mutex);
         return false;
     }
+    lockNode(node);
+    while (node->value != value) {
+        struct Node** link = (value < node->value) ? &(node->left) : &(node->right);
+        if (*link == NULL) {
+            // Value not found.
+            unlockNode(node);
+            unlockParent(tree, parent);
+            return false;
+        }
+        struct Node* next = *link;
+        lockNode(next);
+        unlockParent(tree, parent);
+        parent = node;
+        childLink = link;
+        node = next;
+    }
 
     // Case 1: Deleting a node with no children or one child.
     if (node->left == NULL || node->right == NULL) {
@@ -124,9 +117,7 @@ bool delete(struct Tree* tree, int value) {
         *childLink = child;
 
         unlockNode(node);
-        if (parent != NULL) {
-            unlockNode(parent);
-        }
+        unlockParent(tree, parent);
         destroyNode(node);
     } else {
         // Case 2: Deleting a node with two children.
@@ -157,6 +148,7 @@ bool delete(struct Tree* tree, int value) {
         if (successorParent != node) {
             unlockNode(successorParent);
         }
+        unlockParent(tree, parent); // Still held from the search phase
         destroyNode(successor);
     }
 
@@ -165,23 +157,26 @@ bool delete(struct Tree* tree, int value) {
 
 
 bool search(struct Tree* tree, int value) {
+    pthread_mutex_lock(&tree->mutex);
     struct Node* current = tree->root;
-    while (current != NULL) {
-        lockNode(current);  // Lock the current node
-        if (value < current->value) {
-            struct Node* temp = current->left;
-            unlockNode(current);  // Unlock the current node before moving to the left child
-            current = temp;
-        } else if (value > current->value) {
-            struct Node* temp = current->right;
-            unlockNode(current);  // Unlock the current node before moving to the right child
-            current = temp;
-        } else {
-            unlockNode(current);  // Found the value, unlock the current node before returning
-            return true;  // Value found
+    if (current == NULL) {
+        pthread_mutex_unlock(&tree->mutex);
+        return false;
+    }
+    lockNode(current);
+    pthread_mutex_unlock(&tree->mutex);
+
+    while (current->value != value) {
+        struct Node* next = (value < current->value) ? current->left : current->right;
+        if (next == NULL) {
+            // The value was not found in the tree.
+            unlockNode(current);
+            return false;
         }
+        lockNode(next);  // Lock the child before letting go of the parent
+        unlockNode(current);
+        current = next;
     }
-    // The value was not found in the tree.
-    return false;
+    unlockNode(current);
+    return true;  // Value found
 }
-
@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "concurrent_hash_set.h"
+#include "../../../DataStructure/C/hash/hash_probing.h"
+
+#define CHS_MIN_CAPACITY 17
+
+#define CHS_KEY(k)       (((uint64_t)(uint32_t)(k) << 32) | CHS_SLOT_KEY)
+#define CHS_KEY_OF(v)    ((int)(uint32_t)((v) >> 32))
+#define CHS_IS_KEY(v)    (((v) & ~CHS_SLOT_FROZEN) > CHS_SLOT_TOMB)
+
+// Outcomes of one attempt against a single open addressing table
+enum {
+    CHS_ADDED,
+    CHS_PRESENT,
+    CHS_ABSENT,
+    CHS_REMOVED,
+    CHS_FULL,   // Over the load limit or out of probes: grow, then retry
+    CHS_FROZEN  // Ran into a migrating slot: help, then retry on the new table
+};
+
+static int chs_next_prime(long n) {
+    if (n < 3) {
+        return 3;
+    }
+    for (long candidate = n | 1;; candidate += 2) {
+        int prime = 1;
+        for (long d = 3; d * d <= candidate; d += 2) {
+            if (candidate % d == 0) {
+                prime = 0;
+                break;
+            }
+        }
+        if (prime) {
+            return (int)candidate;
+        }
+    }
+}
+
+// ---- Striped chaining ------------------------------------------------------
+
+// bucket_count is a multiple of CHS_STRIPES, so a key's bucket always belongs to
+// the stripe hashFunction(key, CHS_STRIPES) no matter how often the table grew
+static pthread_rwlock_t* chs_stripe_lock(ConcurrentHashSet* set, int key) {
+    return &set->stripes[hashFunction(key, CHS_STRIPES)].lock;
+}
+
+static void chs_striped_resize(ConcurrentHashSet* set, int seen_bucket_count) {
+    for (int i = 0; i < CHS_STRIPES; i++) {
+        pthread_rwlock_wrlock(&set->stripes[i].lock);
+    }
+    if (set->bucket_count == seen_bucket_count) { // Nobody grew it while we waited
+        int grown_count = seen_bucket_count * 2;
+        ListNode** grown = (ListNode**)calloc((size_t)grown_count, sizeof(ListNode*));
+        if (!grown) {
+            perror("calloc failed");
+            exit(EXIT_FAILURE);
+        }
+        for (int b = 0; b < seen_bucket_count; b++) {
+            ListNode* node = set->buckets[b];
+            while (node != NULL) { // Relink the existing nodes, no reallocation
+                ListNode* next = node->next;
+                int index = hashFunction(node->key, grown_count);
+                node->next = grown[index];
+                grown[index] = node;
+                node = next;
+            }
+        }
+        free(set->buckets);
+        set->buckets = grown;
+        set->bucket_count = grown_count;
+    }
+    for (int i = CHS_STRIPES - 1; i >= 0; i--) {
+        pthread_rwlock_unlock(&set->stripes[i].lock);
+    }
+}
+
+static int chs_striped_insert(ConcurrentHashSet* set, int key) {
+    pthread_rwlock_t* lock = chs_stripe_lock(set, key);
+    pthread_rwlock_wrlock(lock);
+    int bucket_count = set->bucket_count;
+    ListNode** bucket = &set->buckets[hashFunction(key, bucket_count)];
+    int added = 0;
+    if (chainBucketSearch(*bucket, key) == NULL) {
+        added = chainBucketInsert(bucket, key);
+    }
+    pthread_rwlock_unlock(lock);
+
+    if (added && atomic_fetch_add(&set->count, 1) + 1 > (long)bucket_count * CHS_CHAIN_LOAD) {
+        chs_striped_resize(set, bucket_count);
+    }
+    return added;
+}
+
+static int chs_striped_remove(ConcurrentHashSet* set, int key) {
+    pthread_rwlock_t* lock = chs_stripe_lock(set, key);
+    pthread_rwlock_wrlock(lock);
+    int removed = chainBucketDelete(&set->buckets[hashFunction(key, set->bucket_count)], key);
+    pthread_rwlock_unlock(lock);
+    if (removed) {
+        atomic_fetch_sub(&set->count, 1);
+    }
+    return removed;
+}
+
+static int chs_striped_contains(ConcurrentHashSet* set, int key) {
+    pthread_rwlock_t* lock = chs_stripe_lock(set, key);
+    pthread_rwlock_rdlock(lock);
+    int found = chainBucketSearch(set->buckets[hashFunction(key, set->bucket_count)], key) != NULL;
+    pthread_rwlock_unlock(lock);
+    return found;
+}
+
+// ---- Lock-free open addressing --------------------------------------------
+//
+// A slot only moves EMPTY -> key -> TOMBSTONE; tombstones are never reused, they
+// are dropped by the next migration. Every insert of a key therefore races for
+// the same first EMPTY slot of its probe sequence, which keeps keys unique
+// without locks. Migration freezes each slot with one fetch_or and copies live
+// keys into the next table; an operation that meets a frozen slot helps until
+// the new table is published and retries there.
+
+static CHS_OpenTable* chs_table_create(int capacity) {
+    CHS_OpenTable* t = (CHS_OpenTable*)malloc(sizeof(CHS_OpenTable) + (size_t)capacity * sizeof(_Atomic uint64_t));
+    if (!t) {
+        perror("malloc failed");
+        exit(EXIT_FAILURE);
+    }
+    t->capacity = capacity;
+    atomic_init(&t->used, 0);
+    atomic_init(&t->next, NULL);
+    atomic_init(&t->migrate_cursor, 0);
+    atomic_init(&t->migrated, 0);
+    for (int i = 0; i < capacity; i++) {
+        atomic_init(&t->slots[i], CHS_SLOT_EMPTY);
+    }
+    return t;
+}
+
+static int chs_table_insert(CHS_OpenTable* t, int key, int max_probes, int enforce_load) {
+    uint64_t want = CHS_KEY(key);
+    int limit = max_probes < t->capacity ? max_probes : t->capacity;
+    for (int i = 0; i < limit; i++) {
+        _Atomic uint64_t* slot = &t->slots[doubleHashing(key, i, t->capacity)];
+        uint64_t v = atomic_load(slot);
+        for (;;) {
+            if (v & CHS_SLOT_FROZEN) {
+                return CHS_FROZEN;
+            }
+            if (v == want) {
+                return CHS_PRESENT;
+            }
+            if (v != CHS_SLOT_EMPTY) {
+                break; // Another key or a tombstone: keep probing
+            }
+            if (enforce_load &&
+                (long)atomic_load_explicit(&t->used, memory_order_relaxed) * 100 >= (long)t->capacity * CHS_OPEN_LOAD_PCT) {
+                return CHS_FULL;
+            }
+            if (atomic_compare_exchange_strong(slot, &v, want)) {
+                atomic_fetch_add_explicit(&t->used, 1, memory_order_relaxed);
+                return CHS_ADDED;
+            }
+            // Lost the slot; v now holds what won, which may be this very key
+        }
+    }
+    return CHS_FULL;
+}
+
+static int chs_table_remove(CHS_OpenTable* t, int key) {
+    uint64_t want = CHS_KEY(key);
+    for (int i = 0; i < t->capacity; i++) {
+        _Atomic uint64_t* slot = &t->slots[doubleHashing(key, i, t->capacity)];
+        uint64_t v = atomic_load(slot);
+        for (;;) {
+            if (v & CHS_SLOT_FROZEN) {
+                return CHS_FROZEN;
+            }
+            if (v == CHS_SLOT_EMPTY) {
+                return CHS_ABSENT; // Inserts never skip an empty slot
+            }
+            if (v != want) {
+                break;
+            }
+            if (atomic_compare_exchange_strong(slot, &v, CHS_SLOT_TOMB)) {
+                return CHS_REMOVED;
+            }
+        }
+    }
+    return CHS_ABSENT;
+}
+
+static int chs_table_contains(CHS_OpenTable* t, int key) {
+    uint64_t want = CHS_KEY(key);
+    for (int i = 0; i < t->capacity; i++) {
+        uint64_t v = atomic_load(&t->slots[doubleHashing(key, i, t->capacity)]);
+        if (v & CHS_SLOT_FROZEN) {
+            return CHS_FROZEN; // A frozen copy may already be stale in the new table
+        }
+        if (v == CHS_SLOT_EMPTY) {
+            return CHS_ABSENT;
+        }
+        if (v == want) {
+            return CHS_PRESENT;
+        }
+    }
+    return CHS_ABSENT;
+}
+
+// Claims chunks of t until none are left, then waits for the chunks other threads
+// hold; the thread that copies the last slot publishes t->next and retires t.
+// Operations stay lock-free between migrations; during one they help, then wait.
+static void chs_migrate(ConcurrentHashSet* set, CHS_OpenTable* t) {
+    CHS_OpenTable* next = atomic_load(&t->next);
+    for (;;) {
+        long start = atomic_fetch_add(&t->migrate_cursor, CHS_MIGRATE_CHUNK);
+        if (start >= t->capacity) {
+            break;
+        }
+        long end = start + CHS_MIGRATE_CHUNK < t->capacity ? start + CHS_MIGRATE_CHUNK : t->capacity;
+        for (long s = start; s < end; s++) {
+            uint64_t v = atomic_fetch_or(&t->slots[s], CHS_SLOT_FROZEN);
+            if (CHS_IS_KEY(v) && chs_table_insert(next, CHS_KEY_OF(v), next->capacity, 0) == CHS_FULL) {
+                fprintf(stderr, "concurrent_hash_set: migration target is full\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        if (atomic_fetch_add(&t->migrated, end - start) + (end - start) == t->capacity) {
+            CHS_OpenTable* expected = t;
+            atomic_compare_exchange_strong(&set->table, &expected, next);
+            reclaim_retire(set->reclaim, t, free);
+            return;
+        }
+    }
+    while (atomic_load(&set->table) == t) {
+        sched_yield();
+    }
+}
+
+// Sizes the next table for the live keys at a quarter of its capacity, which
+// both grows a full table and compacts one that is mostly tombstones
+static void chs_start_resize(ConcurrentHashSet* set, CHS_OpenTable* t) {
+    if (atomic_load(&t->next) == NULL) {
+        long live = atomic_load(&set->count);
+        long wanted = (live + 1) * 2 * 100 / CHS_OPEN_LOAD_PCT;
+        CHS_OpenTable* fresh = chs_table_create(chs_next_prime(wanted > CHS_MIN_CAPACITY ? wanted : CHS_MIN_CAPACITY));
+        CHS_OpenTable* expected = NULL;
+        if (!atomic_compare_exchange_strong(&t->next, &expected, fresh)) {
+            free(fresh); // Another thread started this migration first
+        }
+    }
+    chs_migrate(set, t);
+}
+
+static int chs_open_insert(ConcurrentHashSet* set, int key) {
+    reclaim_enter(set->reclaim);
+    for (;;) {
+        CHS_OpenTable* t = atomic_load(&set->table);
+        int result = chs_table_insert(t, key, CHS_MAX_PROBES, 1);
+        if (result == CHS_ADDED || result == CHS_PRESENT) {
+            if (result == CHS_ADDED) {
+                atomic_fetch_add(&set->count, 1);
+            }
+            reclaim_exit(set->reclaim);
+            return result == CHS_ADDED;
+        }
+        if (result == CHS_FULL) {
+            chs_start_resize(set, t);
+        } else {
+            chs_migrate(set, t);
+        }
+    }
+}
+
+static int chs_open_remove(ConcurrentHashSet* set, int key) {
+    reclaim_enter(set->reclaim);
+    for (;;) {
+        CHS_OpenTable* t = atomic_load(&set->table);
+        int result = chs_table_remove(t, key);
+        if (result != CHS_FROZEN) {
+            if (result == CHS_REMOVED) {
+                atomic_fetch_sub(&set->count, 1);
+            }
+            reclaim_exit(set->reclaim);
+            return result == CHS_REMOVED;
+        }
+        chs_migrate(set, t);
+    }
+}
+
+static int chs_open_contains(ConcurrentHashSet* set, int key) {
+    reclaim_enter(set->reclaim);
+    for (;;) {
+        CHS_OpenTable* t = atomic_load(&set->table);
+        int result = chs_table_contains(t, key);
+        if (result != CHS_FROZEN) {
+            reclaim_exit(set->reclaim);
+            return result == CHS_PRESENT;
+        }
+        chs_migrate(set, t);
+    }
+}
+
+// ---- Public interface -----------------------------------------------------
+
+ConcurrentHashSet* chs_create(CHS_Mode mode, int initial_capacity) {
+    ConcurrentHashSet* set = (ConcurrentHashSet*)aligned_alloc(64, sizeof(ConcurrentHashSet));
+    if (!set) {
+        perror("aligned_alloc failed");
+        exit(EXIT_FAILURE);
+    }
+    set->mode = mode;
+    atomic_init(&set->count, 0);
+    set->buckets = NULL;
+    set->bucket_count = 0;
+    atomic_init(&set->table, NULL);
+    set->reclaim = NULL;
+
+    if (mode == CHS_STRIPED) {
+        for (int i = 0; i < CHS_STRIPES; i++) {
+            pthread_rwlock_init(&set->stripes[i].lock, NULL);
+        }
+        int wanted = initial_capacity / CHS_CHAIN_LOAD;
+        set->bucket_count = (wanted / CHS_STRIPES + 1) * CHS_STRIPES;
+        set->buckets = (ListNode**)calloc((size_t)set->bucket_count, sizeof(ListNode*));
+        if (!set->buckets) {
+            perror("calloc failed");
+            exit(EXIT_FAILURE);
+        }
+    } else {
+        long wanted = (long)initial_capacity * 100 / CHS_OPEN_LOAD_PCT;
+        atomic_init(&set->table, chs_table_create(chs_next_prime(wanted > CHS_MIN_CAPACITY ? wanted : CHS_MIN_CAPACITY)));
+        set->reclaim = reclaimer_create(RECLAIM_EPOCH, 0);
+    }
+    return set;
+}
+
+void chs_destroy(ConcurrentHashSet* set) {
+    if (set->mode == CHS_STRIPED) {
+        for (int b = 0; b < set->bucket_count; b++) {
+            chainBucketFree(set->buckets[b]);
+        }
+        free(set->buckets);
+        for (int i = 0; i < CHS_STRIPES; i++) {
+            pthread_rwlock_destroy(&set->stripes[i].lock);
+        }
+    } else {
+        free(atomic_load(&set->table));
+        reclaimer_destroy(set->reclaim); // Frees tables retired by migrations
+    }
+    free(set);
+}
+
+int chs_insert(ConcurrentHashSet* set, int key) {
+    return set->mode == CHS_STRIPED ? chs_striped_insert(set, key) : chs_open_insert(set, key);
+}
+
+int chs_remove(ConcurrentHashSet* set, int key) {
+    return set->mode == CHS_STRIPED ? chs_striped_remove(set, key) : chs_open_remove(set, key);
+}
+
+int chs_contains(ConcurrentHashSet* set, int key) {
+    return set->mode == CHS_STRIPED ? chs_striped_contains(set, key) : chs_open_contains(set, key);
+}
+
+long chs_size(ConcurrentHashSet* set) {
+    return atomic_load(&set->count);
+}
+
+const char* chs_mode_name(CHS_Mode mode) {
+    return mode == CHS_STRIPED ? "striped" : "lock_free";
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+
+// concurrent_hash_set.h
+// Concurrent set of ints with two interchangeable implementations:
+//   CHS_STRIPED   - separate chaining (chain_hash.h buckets) guarded by a fixed
+//                   array of reader-writer stripe locks; resize takes every stripe.
+//   CHS_LOCK_FREE - open addressing over atomic slots with tombstones, probed with
+//                   doubleHashing from hash_probing.h. Resize migrates the table in
+//                   chunks with every thread that runs into it helping.
+#ifndef CONCURRENT_HASH_SET_H
+#define CONCURRENT_HASH_SET_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include "../../../DataStructure/C/hash/chain_hash.h"
+#include "../Reclamation/reclaim.h"
+
+#define CHS_STRIPES         64   // Lock stripes; bucket counts stay multiples of this
+#define CHS_CHAIN_LOAD      4    // Average chain length that triggers a striped resize
+#define CHS_OPEN_LOAD_PCT   50   // Claimed slots (keys + tombstones) that trigger a migration
+#define CHS_MAX_PROBES      64   // Probes before an insert gives up and grows the table
+#define CHS_MIGRATE_CHUNK   1024 // Slots claimed per helper step during migration
+
+typedef enum {
+    CHS_STRIPED,
+    CHS_LOCK_FREE
+} CHS_Mode;
+
+typedef struct {
+    _Alignas(64) pthread_rwlock_t lock; // One cache line per stripe
+} CHS_Stripe;
+
+// Slot encoding: 0 empty, 1 tombstone, otherwise (key << 32) | CHS_SLOT_KEY.
+// CHS_SLOT_FROZEN is or-ed in by migration and makes the slot read-only.
+#define CHS_SLOT_EMPTY   ((uint64_t)0)
+#define CHS_SLOT_TOMB    ((uint64_t)1)
+#define CHS_SLOT_KEY     ((uint64_t)2)
+#define CHS_SLOT_FROZEN  ((uint64_t)4)
+
+typedef struct CHS_OpenTable {
+    int capacity; // Prime, so double hashing reaches every slot
+    _Atomic int used;
+    _Atomic(struct CHS_OpenTable*) next; // Set once a migration starts
+    _Atomic long migrate_cursor;
+    _Atomic long migrated;
+    _Atomic uint64_t slots[];
+} CHS_OpenTable;
+
+typedef struct {
+    CHS_Mode mode;
+    _Atomic long count; // Keys currently in the set
+
+    // CHS_STRIPED
+    CHS_Stripe stripes[CHS_STRIPES];
+    ListNode** buckets; // Replaced only while every stripe is write-locked
+    int bucket_count;
+
+    // CHS_LOCK_FREE
+    _Atomic(CHS_OpenTable*) table;
+    Reclaimer* reclaim; // Retired tables are freed once no operation can still read them
+} ConcurrentHashSet;
+
+ConcurrentHashSet* chs_create(CHS_Mode mode, int initial_capacity);
+void chs_destroy(ConcurrentHashSet* set);
+int chs_insert(ConcurrentHashSet* set, int key);   // 1 if added, 0 if already present
+int chs_remove(ConcurrentHashSet* set, int key);   // 1 if removed, 0 if absent
+int chs_contains(ConcurrentHashSet* set, int key);
+long chs_size(ConcurrentHashSet* set);
+const char* chs_mode_name(CHS_Mode mode);
+
+#endif // CONCURRENT_HASH_SET_H
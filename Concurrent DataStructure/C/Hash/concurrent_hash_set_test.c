@@ -0,0 +1,127 @@
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "concurrent_hash_set.h"
+
+#define NUM_THREADS 32 // The service shares one table across this many workers
+#define KEYS_PER_THREAD 2000
+#define CONTENDED_KEYS 64
+#define CONTENDED_OPERATIONS 20000
+
+ConcurrentHashSet* set;
+
+// Net successful inserts minus successful removes, per contended key
+atomic_int balance[CONTENDED_KEYS];
+
+// Private keys, negative ones included, starting from a tiny table so the
+// inserts drive many concurrent resizes
+void* private_routine(void* arg) {
+    int thread_id = *(int*)arg;
+    int base = (thread_id - NUM_THREADS / 2) * KEYS_PER_THREAD;
+    // Calls that change the set stay outside assert, which NDEBUG compiles out
+    for (int i = 0; i < KEYS_PER_THREAD; i++) {
+        int inserted = chs_insert(set, base + i);
+        int duplicate = chs_insert(set, base + i); // Duplicate is rejected
+        assert(inserted == 1 && duplicate == 0);
+        (void)inserted;
+        (void)duplicate;
+    }
+    for (int i = 0; i < KEYS_PER_THREAD; i++) {
+        assert(chs_contains(set, base + i) == 1);
+    }
+    for (int i = 0; i < KEYS_PER_THREAD; i += 2) {
+        int removed = chs_remove(set, base + i);
+        int removed_again = chs_remove(set, base + i); // Already gone
+        assert(removed == 1 && removed_again == 0);
+        (void)removed;
+        (void)removed_again;
+    }
+    for (int i = 0; i < KEYS_PER_THREAD; i++) {
+        assert(chs_contains(set, base + i) == (i % 2));
+    }
+    return NULL;
+}
+
+// Every thread fights over a few keys; each success is counted so the final
+// contents can be checked, and the tombstones force compacting migrations
+void* contended_routine(void* arg) {
+    unsigned int seed = (unsigned int)*(int*)arg;
+    for (int i = 0; i < CONTENDED_OPERATIONS; i++) {
+        int key = 1000000 + rand_r(&seed) % CONTENDED_KEYS;
+        switch (rand_r(&seed) % 3) {
+            case 0:
+                if (chs_insert(set, key)) {
+                    atomic_fetch_add(&balance[key - 1000000], 1);
+                }
+                break;
+            case 1:
+                if (chs_remove(set, key)) {
+                    atomic_fetch_sub(&balance[key - 1000000], 1);
+                }
+                break;
+            default:
+                chs_contains(set, key);
+                break;
+        }
+    }
+    return NULL;
+}
+
+void run_threads(void* (*routine)(void*)) {
+    pthread_t threads[NUM_THREADS];
+    int thread_ids[NUM_THREADS];
+    for (int i = 0; i < NUM_THREADS; i++) {
+        thread_ids[i] = i;
+        if (pthread_create(&threads[i], NULL, routine, &thread_ids[i]) != 0) {
+            perror("Failed to create thread");
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (int i = 0; i < NUM_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+}
+
+int run_suite(CHS_Mode mode) {
+    set = chs_create(mode, 8);
+    for (int key = 0; key < CONTENDED_KEYS; key++) {
+        atomic_store(&balance[key], 0);
+    }
+
+    run_threads(private_routine);
+    long expected = (long)NUM_THREADS * KEYS_PER_THREAD / 2;
+    if (chs_size(set) != expected) {
+        printf("Test failed (%s): size %ld, expected %ld.\n", chs_mode_name(mode), chs_size(set), expected);
+        return 0;
+    }
+    printf("Test passed (%s): private inserts and removes survive resizing.\n", chs_mode_name(mode));
+
+    run_threads(contended_routine);
+    for (int key = 0; key < CONTENDED_KEYS; key++) {
+        int present = atomic_load(&balance[key]);
+        if ((present != 0 && present != 1) || chs_contains(set, 1000000 + key) != present) {
+            printf("Test failed (%s): key %d has balance %d.\n", chs_mode_name(mode), 1000000 + key, present);
+            return 0;
+        }
+        expected += present;
+    }
+    if (chs_size(set) != expected) {
+        printf("Test failed (%s): size %ld, expected %ld.\n", chs_mode_name(mode), chs_size(set), expected);
+        return 0;
+    }
+    printf("Test passed (%s): contended inserts and removes are consistent.\n", chs_mode_name(mode));
+
+    chs_destroy(set);
+    return 1;
+}
+
+int main() {
+    if (!run_suite(CHS_STRIPED) || !run_suite(CHS_LOCK_FREE)) {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+// Compile with: gcc concurrent_hash_set_test.c concurrent_hash_set.c ../Reclamation/*.c -o concurrent_hash_set -pthread -O3
+// Run with: ./concurrent_hash_set
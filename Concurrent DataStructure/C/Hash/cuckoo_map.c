@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "cuckoo_map.h"
+
+#define CUCKOO_STRIPE(bucket) ((bucket) & (CUCKOO_LOCK_STRIPES - 1))
+
+// One BFS node: a bucket reached by moving `key` out of `slot` of its parent bucket
+typedef struct {
+    uint64_t bucket;
+    int parent;
+    int slot;
+    int32_t key;
+    int depth;
+} CuckooPathNode;
+
+// 64-bit finalizer; the low half picks the first bucket and the high half the
+// second. Stripes come from the low bits, which every table size keeps, so a
+// key's stripes are known before the table pointer is read.
+static inline uint64_t cuckoo_hash(int key) {
+    uint64_t x = (uint32_t)key;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+static inline uint64_t cuckoo_h1(uint64_t h) { return h & 0xFFFFFFFFULL; }
+static inline uint64_t cuckoo_h2(uint64_t h) { return h >> 32; }
+
+// The other candidate bucket of a key currently stored in `bucket`
+static inline uint64_t cuckoo_alt_bucket(const CuckooTable* t, int key, uint64_t bucket) {
+    uint64_t h = cuckoo_hash(key);
+    uint64_t b1 = cuckoo_h1(h) & t->mask;
+    return bucket == b1 ? cuckoo_h2(h) & t->mask : b1;
+}
+
+static inline void cuckoo_pause(void) {
+    sched_yield();
+}
+
+// ---- Stripe locks (version counters) ---------------------------------------
+
+static void cuckoo_lock(CuckooMap* map, uint64_t stripe) {
+    _Atomic uint32_t* version = &map->versions[stripe];
+    for (;;) {
+        uint32_t v = atomic_load_explicit(version, memory_order_relaxed);
+        if ((v & 1) == 0 &&
+            atomic_compare_exchange_weak_explicit(version, &v, v + 1, memory_order_acquire, memory_order_relaxed)) {
+            // Orders the odd version before the slot stores that follow
+            atomic_thread_fence(memory_order_release);
+            return;
+        }
+        cuckoo_pause();
+    }
+}
+
+static void cuckoo_unlock(CuckooMap* map, uint64_t stripe) {
+    atomic_fetch_add_explicit(&map->versions[stripe], 1, memory_order_release);
+}
+
+// Two stripes in ascending order, the same order cuckoo_grow takes all of them
+static void cuckoo_lock_two(CuckooMap* map, uint64_t s1, uint64_t s2) {
+    if (s1 == s2) {
+        cuckoo_lock(map, s1);
+    } else if (s1 < s2) {
+        cuckoo_lock(map, s1);
+        cuckoo_lock(map, s2);
+    } else {
+        cuckoo_lock(map, s2);
+        cuckoo_lock(map, s1);
+    }
+}
+
+static void cuckoo_unlock_two(CuckooMap* map, uint64_t s1, uint64_t s2) {
+    cuckoo_unlock(map, s1);
+    if (s1 != s2) {
+        cuckoo_unlock(map, s2);
+    }
+}
+
+// ---- Table primitives (caller holds the stripes or owns the table) ---------
+
+static CuckooTable* cuckoo_table_create(uint64_t bucket_count) {
+    size_t bytes = sizeof(CuckooTable) + bucket_count * sizeof(CuckooBucket);
+    bytes = (bytes + 63) & ~(size_t)63;
+    CuckooTable* t = (CuckooTable*)aligned_alloc(64, bytes);
+    if (!t) {
+        perror("aligned_alloc failed");
+        exit(EXIT_FAILURE);
+    }
+    t->mask = bucket_count - 1;
+    for (uint64_t b = 0; b < bucket_count; b++) {
+        atomic_init(&t->buckets[b].occupied, 0);
+        for (int s = 0; s < CUCKOO_SLOTS; s++) {
+            atomic_init(&t->buckets[b].keys[s], 0);
+            atomic_init(&t->buckets[b].values[s], 0);
+        }
+    }
+    return t;
+}
+
+// Slot holding key in bucket, or -1. Relaxed loads: readers validate with versions.
+static inline int cuckoo_bucket_find(CuckooBucket* bucket, int key) {
+    uint32_t occupied = atomic_load_explicit(&bucket->occupied, memory_order_relaxed);
+    for (int s = 0; s < CUCKOO_SLOTS; s++) {
+        if ((occupied & (1u << s)) && atomic_load_explicit(&bucket->keys[s], memory_order_relaxed) == key) {
+            return s;
+        }
+    }
+    return -1;
+}
+
+static inline int cuckoo_bucket_free_slot(CuckooBucket* bucket) {
+    uint32_t occupied = atomic_load_explicit(&bucket->occupied, memory_order_relaxed);
+    for (int s = 0; s < CUCKOO_SLOTS; s++) {
+        if (!(occupied & (1u << s))) {
+            return s;
+        }
+    }
+    return -1;
+}
+
+static inline void cuckoo_bucket_put(CuckooBucket* bucket, int slot, int key, int value) {
+    atomic_store_explicit(&bucket->keys[slot], key, memory_order_relaxed);
+    atomic_store_explicit(&bucket->values[slot], value, memory_order_relaxed);
+    atomic_fetch_or_explicit(&bucket->occupied, 1u << slot, memory_order_relaxed);
+}
+
+static inline void cuckoo_bucket_clear(CuckooBucket* bucket, int slot) {
+    atomic_fetch_and_explicit(&bucket->occupied, ~(1u << slot), memory_order_relaxed);
+}
+
+// Breadth-first search from b1 and b2 for the nearest bucket with a free slot.
+// Fills path[0..*length] root to leaf and the leaf's free slot; 0 if none found.
+static int cuckoo_search_path(CuckooTable* t, uint64_t b1, uint64_t b2,
+                              CuckooPathNode* path, int* length, int* free_slot) {
+    CuckooPathNode nodes[CUCKOO_BFS_MAX_NODES];
+    int head = 0, tail = 0;
+    nodes[tail++] = (CuckooPathNode){b1, -1, -1, 0, 0};
+    if (b2 != b1) {
+        nodes[tail++] = (CuckooPathNode){b2, -1, -1, 0, 0};
+    }
+    while (head < tail) {
+        int current = head++;
+        CuckooBucket* bucket = &t->buckets[nodes[current].bucket];
+        int slot = cuckoo_bucket_free_slot(bucket);
+        if (slot >= 0) {
+            int depth = nodes[current].depth;
+            for (int n = current; n >= 0; n = nodes[n].parent) {
+                path[nodes[n].depth] = nodes[n];
+            }
+            *length = depth;
+            *free_slot = slot;
+            return 1;
+        }
+        if (nodes[current].depth == CUCKOO_MAX_PATH) {
+            continue;
+        }
+        for (int s = 0; s < CUCKOO_SLOTS && tail < CUCKOO_BFS_MAX_NODES; s++) {
+            int32_t key = atomic_load_explicit(&bucket->keys[s], memory_order_relaxed);
+            uint64_t alt = cuckoo_alt_bucket(t, key, nodes[current].bucket);
+            if (alt != nodes[current].bucket) {
+                nodes[tail++] = (CuckooPathNode){alt, current, s, key, nodes[current].depth + 1};
+            }
+        }
+    }
+    return 0;
+}
+
+// Moves the key in from/from_slot to to/to_slot if both are still as the path
+// search saw them. Caller holds both stripes or owns the table.
+static int cuckoo_move(CuckooTable* t, uint64_t from, int from_slot, int32_t key, uint64_t to, int to_slot) {
+    CuckooBucket* src = &t->buckets[from];
+    CuckooBucket* dst = &t->buckets[to];
+    uint32_t src_occupied = atomic_load_explicit(&src->occupied, memory_order_relaxed);
+    uint32_t dst_occupied = atomic_load_explicit(&dst->occupied, memory_order_relaxed);
+    if (!(src_occupied & (1u << from_slot)) || (dst_occupied & (1u << to_slot)) ||
+        atomic_load_explicit(&src->keys[from_slot], memory_order_relaxed) != key) {
+        return 0;
+    }
+    cuckoo_bucket_put(dst, to_slot, key, atomic_load_explicit(&src->values[from_slot], memory_order_relaxed));
+    cuckoo_bucket_clear(src, from_slot);
+    return 1;
+}
+
+// Insert into a table nobody else can see; 0 when no displacement chain exists
+static int cuckoo_private_insert(CuckooTable* t, int key, int value) {
+    uint64_t h = cuckoo_hash(key);
+    uint64_t b1 = cuckoo_h1(h) & t->mask, b2 = cuckoo_h2(h) & t->mask;
+    CuckooPathNode path[CUCKOO_MAX_PATH + 1];
+    int length, free_slot;
+    if (!cuckoo_search_path(t, b1, b2, path, &length, &free_slot)) {
+        return 0;
+    }
+    for (int i = length; i > 0; i--) {
+        int to_slot = i == length ? free_slot : path[i + 1].slot;
+        cuckoo_move(t, path[i - 1].bucket, path[i].slot, path[i].key, path[i].bucket, to_slot);
+    }
+    int slot = length == 0 ? free_slot : path[1].slot;
+    cuckoo_bucket_put(&t->buckets[path[0].bucket], slot, key, value);
+    return 1;
+}
+
+// ---- Growth ----------------------------------------------------------------
+
+// Doubles the table unless another thread already replaced `seen`
+static void cuckoo_grow(CuckooMap* map, CuckooTable* seen) {
+    for (uint64_t s = 0; s < CUCKOO_LOCK_STRIPES; s++) {
+        cuckoo_lock(map, s);
+    }
+    CuckooTable* old = atomic_load(&map->table);
+    if (old == seen) {
+        uint64_t bucket_count = (old->mask + 1) * 2;
+        CuckooTable* grown;
+        for (;;) {
+            grown = cuckoo_table_create(bucket_count);
+            int complete = 1;
+            for (uint64_t b = 0; b <= old->mask && complete; b++) {
+                CuckooBucket* bucket = &old->buckets[b];
+                uint32_t occupied = atomic_load_explicit(&bucket->occupied, memory_order_relaxed);
+                for (int s = 0; s < CUCKOO_SLOTS && complete; s++) {
+                    if (occupied & (1u << s)) {
+                        complete = cuckoo_private_insert(grown,
+                                                         atomic_load_explicit(&bucket->keys[s], memory_order_relaxed),
+                                                         atomic_load_explicit(&bucket->values[s], memory_order_relaxed));
+                    }
+                }
+            }
+            if (complete) {
+                break;
+            }
+            free(grown); // Unlucky hash layout: try twice as many buckets
+            bucket_count *= 2;
+        }
+        atomic_store(&map->table, grown);
+        reclaim_retire(map->reclaim, old, free); // Optimistic readers may still be scanning it
+    }
+    for (uint64_t s = CUCKOO_LOCK_STRIPES; s-- > 0;) {
+        cuckoo_unlock(map, s);
+    }
+}
+
+// Runs one displacement chain toward b1/b2; 0 when the table has to grow
+static int cuckoo_make_room(CuckooMap* map, CuckooTable* t, uint64_t b1, uint64_t b2) {
+    CuckooPathNode path[CUCKOO_MAX_PATH + 1];
+    int length, free_slot;
+    if (!cuckoo_search_path(t, b1, b2, path, &length, &free_slot)) {
+        return 0;
+    }
+    // Move from the free end back toward the root so every key stays reachable
+    for (int i = length; i > 0; i--) {
+        uint64_t from = path[i - 1].bucket, to = path[i].bucket;
+        int to_slot = i == length ? free_slot : path[i + 1].slot;
+        cuckoo_lock_two(map, CUCKOO_STRIPE(from), CUCKOO_STRIPE(to));
+        int moved = atomic_load(&map->table) == t &&
+                    cuckoo_move(t, from, path[i].slot, path[i].key, to, to_slot);
+        cuckoo_unlock_two(map, CUCKOO_STRIPE(from), CUCKOO_STRIPE(to));
+        if (!moved) {
+            break; // The path went stale; the caller retries from scratch
+        }
+    }
+    return 1;
+}
+
+// ---- Public interface -------------------------------------------------------
+
+CuckooMap* cuckoo_map_create(long initial_capacity) {
+    CuckooMap* map = (CuckooMap*)malloc(sizeof(CuckooMap));
+    if (!map) {
+        perror("malloc failed");
+        exit(EXIT_FAILURE);
+    }
+    for (int s = 0; s < CUCKOO_LOCK_STRIPES; s++) {
+        atomic_init(&map->versions[s], 0);
+    }
+    uint64_t bucket_count = CUCKOO_LOCK_STRIPES;
+    while (bucket_count * CUCKOO_SLOTS < (uint64_t)initial_capacity * 2) { // Start at most half full
+        bucket_count *= 2;
+    }
+    atomic_init(&map->table, cuckoo_table_create(bucket_count));
+    atomic_init(&map->count, 0);
+    map->reclaim = reclaimer_create(RECLAIM_EPOCH, 0);
+    return map;
+}
+
+void cuckoo_map_destroy(CuckooMap* map) {
+    free(atomic_load(&map->table));
+    reclaimer_destroy(map->reclaim);
+    free(map);
+}
+
+int cuckoo_map_find(CuckooMap* map, int key, int* value) {
+    uint64_t h = cuckoo_hash(key);
+    uint64_t s1 = CUCKOO_STRIPE(cuckoo_h1(h)), s2 = CUCKOO_STRIPE(cuckoo_h2(h));
+    reclaim_enter(map->reclaim);
+    for (;;) {
+        uint32_t v1 = atomic_load_explicit(&map->versions[s1], memory_order_acquire);
+        uint32_t v2 = atomic_load_explicit(&map->versions[s2], memory_order_acquire);
+        if ((v1 | v2) & 1) {
+            cuckoo_pause(); // A writer holds one of the stripes
+            continue;
+        }
+        // Read after the versions: a table swapped in later bumps every version
+        CuckooTable* t = atomic_load_explicit(&map->table, memory_order_acquire);
+        int found = 0, result = 0;
+        CuckooBucket* bucket = &t->buckets[cuckoo_h1(h) & t->mask];
+        int slot = cuckoo_bucket_find(bucket, key);
+        if (slot < 0) {
+            bucket = &t->buckets[cuckoo_h2(h) & t->mask];
+            slot = cuckoo_bucket_find(bucket, key);
+        }
+        if (slot >= 0) {
+            found = 1;
+            result = atomic_load_explicit(&bucket->values[slot], memory_order_relaxed);
+        }
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&map->versions[s1], memory_order_relaxed) == v1 &&
+            atomic_load_explicit(&map->versions[s2], memory_order_relaxed) == v2) {
+            reclaim_exit(map->reclaim);
+            if (found && value != NULL) {
+                *value = result;
+            }
+            return found;
+        }
+    }
+}
+
+int cuckoo_map_insert(CuckooMap* map, int key, int value) {
+    uint64_t h = cuckoo_hash(key);
+    uint64_t s1 = CUCKOO_STRIPE(cuckoo_h1(h)), s2 = CUCKOO_STRIPE(cuckoo_h2(h));
+    reclaim_enter(map->reclaim);
+    for (;;) {
+        cuckoo_lock_two(map, s1, s2);
+        CuckooTable* t = atomic_load(&map->table); // Stable while the stripes are held
+        uint64_t b1 = cuckoo_h1(h) & t->mask, b2 = cuckoo_h2(h) & t->mask;
+        int added = -1;
+        CuckooBucket* bucket = &t->buckets[b1];
+        int slot = cuckoo_bucket_find(bucket, key);
+        if (slot < 0) {
+            bucket = &t->buckets[b2];
+            slot = cuckoo_bucket_find(bucket, key);
+        }
+        if (slot >= 0) {
+            atomic_store_explicit(&bucket->values[slot], value, memory_order_relaxed);
+            added = 0;
+        } else {
+            bucket = &t->buckets[b1];
+            slot = cuckoo_bucket_free_slot(bucket);
+            if (slot < 0) {
+                bucket = &t->buckets[b2];
+                slot = cuckoo_bucket_free_slot(bucket);
+            }
+            if (slot >= 0) {
+                cuckoo_bucket_put(bucket, slot, key, value);
+                added = 1;
+            }
+        }
+        cuckoo_unlock_two(map, s1, s2);
+
+        if (added >= 0) {
+            if (added) {
+                atomic_fetch_add(&map->count, 1);
+            }
+            reclaim_exit(map->reclaim);
+            return added;
+        }
+        // Both buckets full: free a slot along a cuckoo path, or grow
+        if (!cuckoo_make_room(map, t, b1, b2)) {
+            cuckoo_grow(map, t);
+        }
+    }
+}
+
+int cuckoo_map_erase(CuckooMap* map, int key) {
+    uint64_t h = cuckoo_hash(key);
+    uint64_t s1 = CUCKOO_STRIPE(cuckoo_h1(h)), s2 = CUCKOO_STRIPE(cuckoo_h2(h));
+    cuckoo_lock_two(map, s1, s2);
+    CuckooTable* t = atomic_load(&map->table);
+    CuckooBucket* bucket = &t->buckets[cuckoo_h1(h) & t->mask];
+    int slot = cuckoo_bucket_find(bucket, key);
+    if (slot < 0) {
+        bucket = &t->buckets[cuckoo_h2(h) & t->mask];
+        slot = cuckoo_bucket_find(bucket, key);
+    }
+    if (slot >= 0) {
+        cuckoo_bucket_clear(bucket, slot);
+    }
+    cuckoo_unlock_two(map, s1, s2);
+    if (slot >= 0) {
+        atomic_fetch_sub(&map->count, 1);
+    }
+    return slot >= 0;
+}
+
+long cuckoo_map_size(CuckooMap* map) {
+    return atomic_load(&map->count);
+}
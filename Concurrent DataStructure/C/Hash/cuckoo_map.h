@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+
+// cuckoo_map.h
+// Concurrent int -> int map built as a bucketized cuckoo hash (MemC3/libcuckoo
+// layout), the concurrent counterpart of DataStructure/C/hash/cuckoo_hash.c.
+// Each key has two candidate buckets of CUCKOO_SLOTS slots, one cache line each.
+//   - Lookups are optimistic: they read the version counters of the key's two
+//     lock stripes, scan both buckets and re-check the versions, retrying only
+//     if a writer touched either stripe. Readers store only to their own epoch
+//     record, never to the table or the counters.
+//   - Writers lock a stripe by making its version odd and release it by making
+//     it even again, so the counters double as the stripe locks.
+//   - When both buckets are full a breadth-first search finds the shortest chain
+//     of displacements to a free slot, which is then executed one locked move at
+//     a time from the free end back to the key's bucket.
+//   - When no chain exists within CUCKOO_MAX_PATH moves the table doubles under
+//     every stripe lock; the old array is reclaimed through the epoch scheme.
+#ifndef CUCKOO_MAP_H
+#define CUCKOO_MAP_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include "../Reclamation/reclaim.h"
+
+#define CUCKOO_SLOTS          4    // Set associativity; one 64-byte bucket
+#define CUCKOO_LOCK_STRIPES   2048 // Version counters / locks, a power of two
+#define CUCKOO_MAX_PATH       5    // Longest displacement chain before growing
+#define CUCKOO_BFS_MAX_NODES  512  // Buckets examined by one path search
+
+typedef struct {
+    _Alignas(64) _Atomic uint32_t occupied; // Bit s set when slot s holds an entry
+    _Atomic int32_t keys[CUCKOO_SLOTS];
+    _Atomic int32_t values[CUCKOO_SLOTS];
+} CuckooBucket;
+
+typedef struct {
+    uint64_t mask; // Bucket count - 1; bucket count is a power of two >= CUCKOO_LOCK_STRIPES
+    CuckooBucket buckets[];
+} CuckooTable;
+
+typedef struct {
+    _Atomic uint32_t versions[CUCKOO_LOCK_STRIPES];
+    _Atomic(CuckooTable*) table;
+    _Atomic long count;
+    Reclaimer* reclaim;
+} CuckooMap;
+
+CuckooMap* cuckoo_map_create(long initial_capacity);
+void cuckoo_map_destroy(CuckooMap* map);
+int cuckoo_map_insert(CuckooMap* map, int key, int value); // 1 if added, 0 if an existing value was replaced
+int cuckoo_map_find(CuckooMap* map, int key, int* value);  // 1 and *value if present
+int cuckoo_map_erase(CuckooMap* map, int key);             // 1 if removed
+long cuckoo_map_size(CuckooMap* map);
+
+#endif // CUCKOO_MAP_H
@@ -0,0 +1,105 @@
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "cuckoo_map.h"
+
+#define WRITER_THREADS 8
+#define READER_THREADS 8
+#define KEYS_PER_WRITER 40000
+#define STABLE_KEYS 4096
+
+CuckooMap* map;
+atomic_int writers_done;
+atomic_long reader_misses;
+
+// Each writer owns a key range; its inserts fill buckets, force cuckoo moves of
+// everybody's keys and grow the table several times
+void* writer_routine(void* arg) {
+    int base = (*(int*)arg + 1) * 1000000;
+    // Calls that change the map stay outside assert, which NDEBUG compiles out
+    for (int i = 0; i < KEYS_PER_WRITER; i++) {
+        int inserted = cuckoo_map_insert(map, base + i, i);
+        assert(inserted == 1);
+        (void)inserted;
+    }
+    for (int i = 0; i < KEYS_PER_WRITER; i++) {
+        int value = -1;
+        int found = cuckoo_map_find(map, base + i, &value);
+        assert(found == 1 && value == i);
+        int inserted = cuckoo_map_insert(map, base + i, -i); // Replaces the value
+        assert(inserted == 0);
+        (void)found;
+        (void)inserted;
+    }
+    for (int i = 0; i < KEYS_PER_WRITER; i += 2) {
+        int erased = cuckoo_map_erase(map, base + i);
+        int erased_again = cuckoo_map_erase(map, base + i);
+        assert(erased == 1 && erased_again == 0);
+        (void)erased;
+        (void)erased_again;
+    }
+    atomic_fetch_add(&writers_done, 1);
+    return NULL;
+}
+
+// Stable keys are never written after setup, so an optimistic read must always
+// find them with their value, however the writers shuffle the table around them
+void* reader_routine(void* arg) {
+    unsigned int seed = (unsigned int)*(int*)arg;
+    while (atomic_load(&writers_done) < WRITER_THREADS) {
+        int key = rand_r(&seed) % STABLE_KEYS;
+        int value = -1;
+        if (!cuckoo_map_find(map, key, &value) || value != key * 7) {
+            atomic_fetch_add(&reader_misses, 1);
+        }
+    }
+    return NULL;
+}
+
+int main() {
+    map = cuckoo_map_create(16);
+    for (int key = 0; key < STABLE_KEYS; key++) {
+        cuckoo_map_insert(map, key, key * 7);
+    }
+
+    pthread_t threads[WRITER_THREADS + READER_THREADS];
+    int ids[WRITER_THREADS + READER_THREADS];
+    for (int i = 0; i < WRITER_THREADS + READER_THREADS; i++) {
+        ids[i] = i;
+        void* (*routine)(void*) = i < WRITER_THREADS ? writer_routine : reader_routine;
+        if (pthread_create(&threads[i], NULL, routine, &ids[i]) != 0) {
+            perror("Failed to create thread");
+            return EXIT_FAILURE;
+        }
+    }
+    for (int i = 0; i < WRITER_THREADS + READER_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    if (atomic_load(&reader_misses) != 0) {
+        printf("Test failed: optimistic reads missed %ld stable keys.\n", atomic_load(&reader_misses));
+        return EXIT_FAILURE;
+    }
+    long expected = STABLE_KEYS + (long)WRITER_THREADS * KEYS_PER_WRITER / 2;
+    if (cuckoo_map_size(map) != expected) {
+        printf("Test failed: size %ld, expected %ld.\n", cuckoo_map_size(map), expected);
+        return EXIT_FAILURE;
+    }
+    for (int w = 0; w < WRITER_THREADS; w++) {
+        for (int i = 0; i < KEYS_PER_WRITER; i++) {
+            int value = 0;
+            int found = cuckoo_map_find(map, (w + 1) * 1000000 + i, &value);
+            if (found != (i % 2) || (found && value != -i)) {
+                printf("Test failed: key %d has the wrong state.\n", (w + 1) * 1000000 + i);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    printf("Test passed: %ld keys, no missed reads during displacement and growth.\n", cuckoo_map_size(map));
+    cuckoo_map_destroy(map);
+    return EXIT_SUCCESS;
+}
+
+// Compile with: gcc cuckoo_map_test.c cuckoo_map.c ../Reclamation/*.c -o cuckoo_map -pthread -O3
+// Run with: ./cuckoo_map
@@ -16,8 +16,30 @@
 //     atomic_uintptr_t head;
 // } LockFreeList;
 
+// Hazard slots: the node being examined and the node whose next led to it
+enum { LF_HP_PREV, LF_HP_CURR, LF_HAZARDS };
+
+#define LF_MARK ((uintptr_t)1)
+
 void Lock_Free_list_init(LockFreeList* list) {
+    Lock_Free_list_init_mode(list, RECLAIM_HAZARD_POINTERS);
+}
+
+void Lock_Free_list_init_mode(LockFreeList* list, ReclaimMode mode) {
     atomic_store(&list->head, (uintptr_t)NULL);
+    list->reclaim = reclaimer_create(mode, LF_HAZARDS);
+}
+
+void Lock_Free_list_destroy(LockFreeList* list) {
+    uintptr_t curr = atomic_load(&list->head);
+    while (curr != (uintptr_t)NULL) {
+        LOCK_FREE_Node* node = (LOCK_FREE_Node*)curr;
+        curr = atomic_load(&node->next) & ~LF_MARK;
+        free(node);
+    }
+    atomic_store(&list->head, (uintptr_t)NULL);
+    reclaimer_destroy(list->reclaim); // Frees the nodes unlinked but not yet reclaimed
+    list->reclaim = NULL;
 }
 
 LOCK_FREE_Node* Lock_Free_create_node(int data) {
@@ -33,55 +55,79 @@ LOCK_FREE_Node* Lock_Free_create_node(int data) {
 
 void Lock_Free_list_insert(LockFreeList* list, int data) {
     LOCK_FREE_Node* newNode = Lock_Free_create_node(data);
-    LOCK_FREE_Node* oldHead;
+    uintptr_t oldHead = atomic_load(&list->head);
     do {
-        oldHead = (LOCK_FREE_Node*)atomic_load(&list->head);
-        atomic_store(&newNode->next, (uintptr_t)oldHead);
-    } while (!atomic_compare_exchange_weak(&list->head, (uintptr_t*)&oldHead, (uintptr_t)newNode));
+        atomic_store(&newNode->next, oldHead);
+    } while (!atomic_compare_exchange_weak(&list->head, &oldHead, (uintptr_t)newNode));
 }
 
-
-int Lock_Free_list_delete(LockFreeList* list, int data) {
-    LOCK_FREE_Node* prev = NULL;
-    LOCK_FREE_Node* curr = (LOCK_FREE_Node*)atomic_load(&list->head);
-    LOCK_FREE_Node* next = NULL;
-
-    while (curr != NULL) {
-        next = (LOCK_FREE_Node*)atomic_load(&(curr->next));
-
-        if (curr->data == data) { // Found node to delete
-            if (prev == NULL) { // Head needs to be deleted
-                if (atomic_compare_exchange_weak(&list->head, (uintptr_t*)&curr, (uintptr_t)next)) {
-                    free(curr);
-                    return 1; // Success
-                }
-            } else if (atomic_compare_exchange_weak(&(prev->next), (uintptr_t*)&curr, (uintptr_t)next)) {
-                free(curr);
-                return 1; // Success
+// Returns the first unmarked node holding data (protected by LF_HP_CURR) and, in
+// *link, the field that points at it. Marked nodes met on the way are unlinked and
+// retired by whoever's CAS removes them, so each is retired exactly once.
+static LOCK_FREE_Node* Lock_Free_find(LockFreeList* list, int data, atomic_uintptr_t** link) {
+    Reclaimer* r = list->reclaim;
+retry:
+    *link = &list->head;
+    uintptr_t curr = atomic_load(*link);
+    while (curr != (uintptr_t)NULL) {
+        LOCK_FREE_Node* node = (LOCK_FREE_Node*)curr;
+        reclaim_protect(r, LF_HP_CURR, node);
+        if (atomic_load(*link) != curr) {
+            goto retry; // The predecessor changed or was marked
+        }
+        uintptr_t next = atomic_load(&node->next);
+        if (next & LF_MARK) {
+            uintptr_t expected = curr;
+            if (!atomic_compare_exchange_strong(*link, &expected, next & ~LF_MARK)) {
+                goto retry;
             }
-            // If CAS failed, start over
-            curr = (LOCK_FREE_Node*)atomic_load(&list->head);
-        } else {
-            prev = curr;
-            curr = next;
+            reclaim_retire(r, node, free);
+            curr = next & ~LF_MARK;
+            continue;
         }
+        if (node->data == data) {
+            return node;
+        }
+        reclaim_protect(r, LF_HP_PREV, node);
+        *link = &node->next;
+        curr = next;
     }
-
-    return 0; // Not found or failed
+    return NULL;
 }
 
-int Lock_Free_list_search(LockFreeList* list, int data) {
-    LOCK_FREE_Node* curr = (LOCK_FREE_Node*)atomic_load(&list->head);
-
-    while (curr != NULL) {
-        if (curr->data == data) {
-            return 1; // Found
+int Lock_Free_list_delete(LockFreeList* list, int data) {
+    Reclaimer* r = list->reclaim;
+    int deleted = 0;
+    reclaim_enter(r);
+    for (;;) {
+        atomic_uintptr_t* link;
+        LOCK_FREE_Node* curr = Lock_Free_find(list, data, &link);
+        if (curr == NULL) {
+            break; // Not found
+        }
+        uintptr_t next = atomic_load(&curr->next);
+        if (next & LF_MARK) {
+            continue; // Another thread is deleting it, look for the next match
+        }
+        // Marking is the logical delete; it also freezes curr->next so that an
+        // insert behind curr cannot be lost when curr is unlinked.
+        if (atomic_compare_exchange_weak(&curr->next, &next, next | LF_MARK)) {
+            uintptr_t expected = (uintptr_t)curr;
+            if (atomic_compare_exchange_strong(link, &expected, next)) {
+                reclaim_retire(r, curr, free);
+            } // Otherwise the next traversal that reaches curr unlinks it
+            deleted = 1; // Success
+            break;
         }
-        curr = (LOCK_FREE_Node*)atomic_load(&(curr->next));
     }
-
-    return 0; // Not found
+    reclaim_exit(r);
+    return deleted;
 }
 
-
-
+int Lock_Free_list_search(LockFreeList* list, int data) {
+    atomic_uintptr_t* link;
+    reclaim_enter(list->reclaim);
+    int found = Lock_Free_find(list, data, &link) != NULL;
+    reclaim_exit(list->reclaim);
+    return found;
+}
@@ -3,18 +3,22 @@
 #define LOCK_FREE_LIST_H
 
 #include <stdatomic.h>
+#include "../Reclamation/reclaim.h"
 
 typedef struct LOCK_FREE_Node {
     int data;
-    atomic_uintptr_t next; // Points to the next Node
+    atomic_uintptr_t next; // Points to the next Node; bit 0 marks this node deleted
 } LOCK_FREE_Node;
 
 typedef struct LockFreeList {
     atomic_uintptr_t head;
+    Reclaimer* reclaim;
 } LockFreeList;
 
 // Function declarations
-void Lock_Free_list_init(LockFreeList* list);
+void Lock_Free_list_init(LockFreeList* list); // Hazard pointers
+void Lock_Free_list_init_mode(LockFreeList* list, ReclaimMode mode);
+void Lock_Free_list_destroy(LockFreeList* list);
 LOCK_FREE_Node* Lock_Free_create_node(int data);
 void Lock_Free_list_insert(LockFreeList* list, int data);
 int Lock_Free_list_delete(LockFreeList* list, int data);
@@ -29,10 +29,10 @@ void* thread_func(void* arg) {
     return NULL;
 }
 
-int main() {
+int run_test(ReclaimMode mode) {
     pthread_t threads[NUM_THREADS];
     int thread_nums[NUM_THREADS];
-    Lock_Free_list_init(&list);
+    Lock_Free_list_init_mode(&list, mode);
 
     // Create threads to perform insertions, searches, and deletions
     for (int i = 0; i < NUM_THREADS; i++) {
@@ -51,12 +51,24 @@ int main() {
         }
     }
 
-    // Final verification: Ensure the list is empty or in expected state
-    // This part is challenging for a lock-free list and might involve complex logic
-    // For this simple test, we might skip it or perform a basic check if feasible
+    // Final verification: every value was deleted by the thread that inserted it
+    for (int value = 0; value < NUM_THREADS * OPERATIONS_PER_THREAD; value++) {
+        if (Lock_Free_list_search(&list, value)) {
+            printf("Error: value %d still present with %s\n", value, reclaim_mode_name(mode));
+            return 1;
+        }
+    }
 
-    printf("All tests passed successfully.\n");
+    Lock_Free_list_destroy(&list);
+    printf("All tests passed successfully with %s.\n", reclaim_mode_name(mode));
+    return 0;
+}
+
+int main() {
+    if (run_test(RECLAIM_HAZARD_POINTERS) != 0 || run_test(RECLAIM_EPOCH) != 0) {
+        return 1;
+    }
     return 0;
 }
 
-// Compile with: gcc -pg lock_free_list_test.c lock_free_list.c-o lock_free_list -pthread -O3
\ No newline at end of file
+// Compile with: gcc -pg lock_free_list_test.c lock_free_list.c ../Reclamation/*.c -o lock_free_list -pthread -O3
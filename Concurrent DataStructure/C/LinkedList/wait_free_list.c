@@ -1,100 +1,440 @@
-
 // wait-free linked list
+//
+// Ordered set after Timnat, Braginsky, Kogan and Petrank ("Wait-Free Linked-Lists")
+// with the fast-path-slow-path scheme of Kogan and Petrank:
+//  - Every operation first runs the Harris-Michael lock-free algorithm, but only for
+//    WF_FAST_PATH_ATTEMPTS traversals.
+//  - If that budget runs out the operation is announced in state[tid] with a phase
+//    number, and every thread that announces later helps all older operations to
+//    completion before running its own. Fast-path threads also look at one other
+//    thread's announcement every WF_HELP_DELAY operations, so a stuck announcement
+//    is eventually helped by everyone and no operation takes unbounded steps.
+//
+// A node is logically deleted by the CAS that sets its owner field to the id of
+// the deleting operation; that CAS is the linearization point of delete and it
+// decides which of several concurrent deletes of the same key returns 1. Marking
+// next afterwards only allows the node to be unlinked. Nodes and descriptors are
+// reclaimed through ../Reclamation/reclaim.h, with hazard pointers by default:
+// epochs are cheaper but let one stalled thread hold back all memory.
 #include <stdatomic.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <stdint.h> 
-// #include <pthread.h>
+#include <stdint.h>
+#include <limits.h>
 #include "wait_free_list.h"
 
-// #define MARKED_PTR(p)   (Node*)((uintptr_t)(p) | 1)
-// #define UNMARKED_PTR(p) (Node*)((uintptr_t)(p) & ~1)
-// #define IS_MARKED(p)    ((uintptr_t)(p) & 1)
+// Hazard slots used by each thread
+enum { WF_HP_PRED, WF_HP_CURR, WF_HP_NODE, WF_HP_DESC, WF_HP_NEW_DESC, WF_HAZARDS };
 
-// typedef struct Node {
-//     int data;
-//     _Atomic(struct Node*) next; // Correctly define next as an atomic pointer to Node
-// } Node;
+typedef struct {
+    WAIT_FREE_Node* pred;
+    uint64_t pred_word;   // pred->next when curr was reached, version included
+    WAIT_FREE_Node* curr; // First present node with data >= key, or NULL
+} WF_Window;
 
-// // Define LockFreeList correctly
-// typedef struct LockFreeList {
-//     _Atomic(Node*) head; // Correctly define head as an atomic pointer to Node
-// } LockFreeList;
+// Per-thread bookkeeping, shared by all lists and kept across thread id reuse
+typedef struct {
+    _Alignas(64) uint64_t seq; // Makes delete ids unique: (seq << 8) | tid
+    unsigned ops;
+    int help_next;
+} WF_ThreadCtx;
 
+static WF_ThreadCtx wf_ctx[REGISTRY_MAX_THREADS];
 
 void wait_free_list_init(WAIT_FREE_LockFreeList* list) {
-    atomic_store(&list->head, NULL); // Correct initialization
+    wait_free_list_init_mode(list, RECLAIM_HAZARD_POINTERS);
+}
+
+void wait_free_list_init_mode(WAIT_FREE_LockFreeList* list, ReclaimMode mode) {
+    list->head.data = INT_MIN;
+    atomic_init(&list->head.next, 0);
+    atomic_init(&list->head.owner, 0);
+    atomic_init(&list->head.refs, 1);
+    atomic_init(&list->phase, 0);
+    for (int t = 0; t < REGISTRY_MAX_THREADS; t++) {
+        atomic_init(&list->state[t], NULL);
+    }
+    list->reclaim = reclaimer_create(mode, WF_HAZARDS);
+}
+
+void wait_free_list_destroy(WAIT_FREE_LockFreeList* list) {
+    WAIT_FREE_Node* curr = WF_PTR(atomic_load(&list->head.next));
+    while (curr != NULL) {
+        WAIT_FREE_Node* next = WF_PTR(atomic_load(&curr->next));
+        free(curr);
+        curr = next;
+    }
+    atomic_store(&list->head.next, 0);
+    for (int t = 0; t < REGISTRY_MAX_THREADS; t++) {
+        free(atomic_exchange(&list->state[t], NULL));
+    }
+    reclaimer_destroy(list->reclaim); // Frees the unlinked nodes and replaced descriptors
+    list->reclaim = NULL;
 }
 
-WAIT_FREE_Node* wait_free_create_node(int data) {
+static WAIT_FREE_Node* wf_create_node(int data) {
     WAIT_FREE_Node* node = (WAIT_FREE_Node*)malloc(sizeof(WAIT_FREE_Node));
     if (!node) {
         perror("malloc failed");
         exit(EXIT_FAILURE);
     }
     node->data = data;
-    atomic_store(&node->next, NULL); // Correctly initialize the atomic next pointer
+    atomic_init(&node->next, 0);
+    atomic_init(&node->owner, 0);
+    atomic_init(&node->refs, 1);
     return node;
 }
 
-void wait_free_list_insert(_Atomic(WAIT_FREE_Node*)* head, int data) {
-    WAIT_FREE_Node* newNode = wait_free_create_node(data);
-    WAIT_FREE_Node* oldHead = atomic_load(head);
-    do {
-        atomic_store(&newNode->next, oldHead);
-    } while (!atomic_compare_exchange_weak(head, &oldHead, newNode));
-}
-
-void wait_free_list_delete(_Atomic(WAIT_FREE_Node*)* head, int data) {
-    WAIT_FREE_Node* pred = NULL;
-    WAIT_FREE_Node* curr = atomic_load(head);
-    WAIT_FREE_Node* succ;
-
-    while (true) {
-        if (!curr) return; // If list is empty or end reached without finding the data
-        
-        succ = atomic_load(&curr->next);
-        
-        if (curr->data == data) {
-            WAIT_FREE_Node* succUnmarked = UNMARKED_PTR(succ);
-            // Try to logically delete the node by marking its successor
-            if (atomic_compare_exchange_weak(&curr->next, &succ, MARKED_PTR(succUnmarked))) {
-                // If successful, attempt to physically remove the node
-                if (pred) {
-                    if (!atomic_compare_exchange_strong(&pred->next, &curr, succUnmarked)) {
-                        // If CAS failed, curr could have been removed or marked by another thread, retry from head
-                        curr = atomic_load(head);
-                        continue;
-                    }
-                } else {
-                    // Special case when deleting head
-                    if (!atomic_compare_exchange_strong(head, &curr, succUnmarked)) {
-                        // If CAS failed, head has changed, retry
-                        curr = atomic_load(head);
-                        continue;
-                    }
+static WF_OpDesc* wf_create_desc(long phase, WF_OpType type, int key, uint64_t op_id, WAIT_FREE_Node* node) {
+    WF_OpDesc* desc = (WF_OpDesc*)malloc(sizeof(WF_OpDesc));
+    if (!desc) {
+        perror("malloc failed");
+        exit(EXIT_FAILURE);
+    }
+    desc->phase = phase;
+    desc->type = type;
+    desc->key = key;
+    desc->op_id = op_id;
+    desc->node = node;
+    return desc;
+}
+
+// Node references: the list link holds one, each pending delete descriptor that
+// names the node holds one. The last release retires the node.
+static int wf_node_acquire(WAIT_FREE_Node* node) {
+    int refs = atomic_load(&node->refs);
+    while (refs > 0) {
+        if (atomic_compare_exchange_weak(&node->refs, &refs, refs + 1)) {
+            return 1;
+        }
+    }
+    return 0; // Already unlinked and retired
+}
+
+static void wf_node_release(WAIT_FREE_LockFreeList* list, WAIT_FREE_Node* node) {
+    if (atomic_fetch_sub(&node->refs, 1) == 1) {
+        reclaim_retire(list->reclaim, node, free);
+    }
+}
+
+static bool wf_is_pending(const WF_OpDesc* desc) {
+    return desc->type != WF_OP_SUCCESS && desc->type != WF_OP_FAILURE;
+}
+
+static WF_OpDesc* wf_protect_desc(WAIT_FREE_LockFreeList* list, int tid) {
+    WF_OpDesc* desc = atomic_load(&list->state[tid]);
+    for (;;) {
+        reclaim_protect(list->reclaim, WF_HP_DESC, desc);
+        WF_OpDesc* again = atomic_load(&list->state[tid]);
+        if (again == desc) {
+            return desc;
+        }
+        desc = again;
+    }
+}
+
+// Moves state[tid] from desc to next. The winner retires desc (and drops the node
+// reference an execute-delete descriptor holds); a loser frees its unpublished next.
+static int wf_cas_state(WAIT_FREE_LockFreeList* list, int tid, WF_OpDesc* desc, WF_OpDesc* next) {
+    WF_OpDesc* expected = desc;
+    if (!atomic_compare_exchange_strong(&list->state[tid], &expected, next)) {
+        free(next);
+        return 0;
+    }
+    if (desc->type == WF_OP_EXECUTE_DELETE) {
+        wf_node_release(list, desc->node);
+    }
+    reclaim_retire(list->reclaim, desc, free);
+    return 1;
+}
+
+// Harris-Michael search: returns the window around key, marking and unlinking every
+// logically deleted node on the way. Gives up (returns 0) when budget traversals
+// have been used, or when desc is no longer the announcement of owner_tid.
+static int wf_find(WAIT_FREE_LockFreeList* list, int key, WF_Window* window,
+                   int* budget, int owner_tid, const WF_OpDesc* desc) {
+    Reclaimer* r = list->reclaim;
+retry:
+    if (budget != NULL && (*budget)-- <= 0) {
+        return 0;
+    }
+    if (desc != NULL && atomic_load(&list->state[owner_tid]) != desc) {
+        return 0;
+    }
+    WAIT_FREE_Node* pred = &list->head;
+    uint64_t pred_word = atomic_load(&pred->next);
+    for (;;) {
+        WAIT_FREE_Node* curr = WF_PTR(pred_word);
+        if (curr == NULL) {
+            break;
+        }
+        reclaim_protect(r, WF_HP_CURR, curr);
+        if (atomic_load(&pred->next) != pred_word) {
+            goto retry; // pred changed or was marked, curr may already be gone
+        }
+        uint64_t curr_word = atomic_load(&curr->next);
+        if (WF_IS_MARKED(curr_word) || atomic_load(&curr->owner) != 0) {
+            if (!WF_IS_MARKED(curr_word)) {
+                uint64_t marked = WF_PACK(WF_PTR(curr_word), 1, WF_VERSION(curr_word) + 1);
+                if (!atomic_compare_exchange_strong(&curr->next, &curr_word, marked)) {
+                    goto retry;
                 }
-                free(curr);// Free outside the critical section; consider safe memory reclamation techniques
-                return;
+                curr_word = marked;
             }
-        } else {
-            pred = curr;
-            curr = UNMARKED_PTR(succ);
+            uint64_t unlinked = WF_PACK(WF_PTR(curr_word), 0, WF_VERSION(pred_word) + 1);
+            if (!atomic_compare_exchange_strong(&pred->next, &pred_word, unlinked)) {
+                goto retry;
+            }
+            wf_node_release(list, curr); // Drop the list link
+            pred_word = unlinked;
+            continue;
+        }
+        if (curr->data >= key) {
+            break;
         }
+        reclaim_protect(r, WF_HP_PRED, curr);
+        pred = curr;
+        pred_word = curr_word;
     }
+    window->pred = pred;
+    window->pred_word = pred_word;
+    window->curr = WF_PTR(pred_word);
+    return 1;
 }
 
-int wait_free_list_search(_Atomic(WAIT_FREE_Node*)* head, int data) {
-    WAIT_FREE_Node* curr = atomic_load(head);
-    while (curr != NULL) {
-        if (curr->data == data) {
-            return 1;// Found
+static void wf_help_insert(WAIT_FREE_LockFreeList* list, int tid, WF_OpDesc* desc) {
+    WAIT_FREE_Node* node = desc->node;
+    reclaim_protect(list->reclaim, WF_HP_NODE, node);
+    if (atomic_load(&list->state[tid]) != desc) {
+        return; // Still pending means still unlinked, so node was alive when protected
+    }
+    uint64_t node_next = atomic_load(&node->next);
+    WF_Window w;
+    if (!wf_find(list, desc->key, &w, NULL, tid, desc)) {
+        return;
+    }
+    if (w.curr == node || WF_IS_MARKED(atomic_load(&node->next)) || atomic_load(&node->owner) != 0) {
+        // Linked by another helper (and possibly deleted again since)
+        wf_cas_state(list, tid, desc, wf_create_desc(desc->phase, WF_OP_SUCCESS, desc->key, 0, NULL));
+        return;
+    }
+    if (w.curr != NULL && w.curr->data == desc->key) {
+        wf_cas_state(list, tid, desc, wf_create_desc(desc->phase, WF_OP_FAILURE, desc->key, 0, NULL));
+        return;
+    }
+
+    // Replace the descriptor before touching the list: a helper that decided
+    // FAILURE from an older view can then no longer publish it.
+    WF_OpDesc* attempt = wf_create_desc(desc->phase, WF_OP_INSERT, desc->key, 0, node);
+    reclaim_protect(list->reclaim, WF_HP_NEW_DESC, attempt);
+    if (!wf_cas_state(list, tid, desc, attempt)) {
+        return;
+    }
+    // Every write to node->next bumps its version, so this fails if anyone touched
+    // node->next after node_next was read, in particular once the node is linked.
+    atomic_compare_exchange_strong(&node->next, &node_next,
+                                   WF_PACK(w.curr, 0, WF_VERSION(node_next) + 1));
+    uint64_t linked_next = atomic_load(&node->next);
+    if (WF_IS_MARKED(linked_next)) {
+        return;
+    }
+    uint64_t expected = WF_PACK(WF_PTR(linked_next), 0, WF_VERSION(w.pred_word));
+    if (atomic_compare_exchange_strong(&w.pred->next, &expected,
+                                       WF_PACK(node, 0, WF_VERSION(w.pred_word) + 1))) {
+        wf_cas_state(list, tid, attempt, wf_create_desc(desc->phase, WF_OP_SUCCESS, desc->key, 0, NULL));
+    }
+}
+
+static void wf_help_search_delete(WAIT_FREE_LockFreeList* list, int tid, WF_OpDesc* desc) {
+    WF_Window w;
+    if (!wf_find(list, desc->key, &w, NULL, tid, desc)) {
+        return;
+    }
+    if (w.curr == NULL || w.curr->data != desc->key) {
+        wf_cas_state(list, tid, desc, wf_create_desc(desc->phase, WF_OP_FAILURE, desc->key, 0, NULL));
+        return;
+    }
+    if (!wf_node_acquire(w.curr)) {
+        return; // Unlinked since the search; try again
+    }
+    WF_OpDesc* execute = wf_create_desc(desc->phase, WF_OP_EXECUTE_DELETE, desc->key, desc->op_id, w.curr);
+    if (!wf_cas_state(list, tid, desc, execute)) {
+        wf_node_release(list, w.curr);
+    }
+}
+
+static void wf_help_execute_delete(WAIT_FREE_LockFreeList* list, int tid, WF_OpDesc* desc) {
+    WAIT_FREE_Node* node = desc->node;
+    reclaim_protect(list->reclaim, WF_HP_NODE, node);
+    if (atomic_load(&list->state[tid]) != desc) {
+        return; // The descriptor's reference on node may be gone
+    }
+    uint64_t expected = 0;
+    atomic_compare_exchange_strong(&node->owner, &expected, desc->op_id);
+    WF_OpType result = atomic_load(&node->owner) == desc->op_id ? WF_OP_SUCCESS : WF_OP_FAILURE;
+    wf_cas_state(list, tid, desc, wf_create_desc(desc->phase, result, desc->key, 0, NULL));
+}
+
+static void wf_help_contains(WAIT_FREE_LockFreeList* list, int tid, WF_OpDesc* desc) {
+    WF_Window w;
+    if (!wf_find(list, desc->key, &w, NULL, tid, desc)) {
+        return;
+    }
+    WF_OpType result = (w.curr != NULL && w.curr->data == desc->key) ? WF_OP_SUCCESS : WF_OP_FAILURE;
+    wf_cas_state(list, tid, desc, wf_create_desc(desc->phase, result, desc->key, 0, NULL));
+}
+
+// Drives the operation tid announced in the given phase until it has a result
+static void wf_help_op(WAIT_FREE_LockFreeList* list, int tid, long phase) {
+    for (;;) {
+        WF_OpDesc* desc = wf_protect_desc(list, tid);
+        if (desc == NULL || desc->phase != phase || !wf_is_pending(desc)) {
+            return;
+        }
+        switch (desc->type) {
+            case WF_OP_INSERT:
+                wf_help_insert(list, tid, desc);
+                break;
+            case WF_OP_SEARCH_DELETE:
+                wf_help_search_delete(list, tid, desc);
+                break;
+            case WF_OP_EXECUTE_DELETE:
+                wf_help_execute_delete(list, tid, desc);
+                break;
+            case WF_OP_CONTAINS:
+                wf_help_contains(list, tid, desc);
+                break;
+            default:
+                return;
+        }
+    }
+}
+
+static void wf_help(WAIT_FREE_LockFreeList* list, long phase) {
+    int threads = registry_high_water();
+    for (int t = 0; t < threads; t++) {
+        WF_OpDesc* desc = wf_protect_desc(list, t);
+        if (desc != NULL && wf_is_pending(desc) && desc->phase <= phase) {
+            wf_help_op(list, t, desc->phase);
         }
-        curr = atomic_load(&curr->next);
     }
-    return 0;// Not found
 }
 
-// Wait-Free Guarantees: The provided code aims to minimize blocking but does not fully achieve wait-freedom. True wait-freedom in deletion operations often requires additional mechanisms to ensure all threads can make progress without interference.
+// Fast-path threads periodically help one announced operation, round robin
+static void wf_maybe_help(WAIT_FREE_LockFreeList* list, int tid) {
+    WF_ThreadCtx* ctx = &wf_ctx[tid];
+    if (++ctx->ops % WF_HELP_DELAY != 0) {
+        return;
+    }
+    int threads = registry_high_water();
+    int t = ctx->help_next % threads;
+    ctx->help_next = t + 1;
+    WF_OpDesc* desc = wf_protect_desc(list, t);
+    if (desc != NULL && wf_is_pending(desc)) {
+        wf_help_op(list, t, desc->phase);
+    }
+}
 
+static int wf_slow_path(WAIT_FREE_LockFreeList* list, int tid, WF_OpType type,
+                        int key, WAIT_FREE_Node* node, uint64_t op_id) {
+    long phase = atomic_fetch_add(&list->phase, 1);
+    WF_OpDesc* previous = atomic_exchange(&list->state[tid], wf_create_desc(phase, type, key, op_id, node));
+    if (previous != NULL) {
+        reclaim_retire(list->reclaim, previous, free); // Helpers may still be reading our last result
+    }
+    wf_help(list, phase);
+    return atomic_load(&list->state[tid])->type == WF_OP_SUCCESS;
+}
+
+static int wf_insert_fast(WAIT_FREE_LockFreeList* list, WAIT_FREE_Node* node, int* budget, int* result) {
+    WF_Window w;
+    while (wf_find(list, node->data, &w, budget, -1, NULL)) {
+        if (w.curr != NULL && w.curr->data == node->data) {
+            *result = 0;
+            return 1;
+        }
+        atomic_store_explicit(&node->next, WF_PACK(w.curr, 0, 0), memory_order_relaxed);
+        uint64_t expected = w.pred_word;
+        if (atomic_compare_exchange_strong(&w.pred->next, &expected,
+                                           WF_PACK(node, 0, WF_VERSION(w.pred_word) + 1))) {
+            *result = 1;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int wf_delete_fast(WAIT_FREE_LockFreeList* list, int key, uint64_t op_id, int* budget, int* result) {
+    WF_Window w;
+    while (wf_find(list, key, &w, budget, -1, NULL)) {
+        if (w.curr == NULL || w.curr->data != key) {
+            *result = 0;
+            return 1;
+        }
+        uint64_t expected = 0;
+        if (atomic_compare_exchange_strong(&w.curr->owner, &expected, op_id)) {
+            *result = 1;
+            return 1;
+        }
+        // A concurrent delete won this node; the next find unlinks it
+    }
+    return 0;
+}
+
+int wait_free_list_insert(WAIT_FREE_LockFreeList* list, int data) {
+    int tid = registry_thread_id();
+    int budget = WF_FAST_PATH_ATTEMPTS;
+    int result;
+    reclaim_enter(list->reclaim);
+    wf_maybe_help(list, tid);
+    WAIT_FREE_Node* node = wf_create_node(data);
+    if (wf_insert_fast(list, node, &budget, &result)) {
+        if (!result) {
+            free(node); // Never published
+        }
+    } else {
+        result = wf_slow_path(list, tid, WF_OP_INSERT, data, node, 0);
+        if (!result) {
+            wf_node_release(list, node); // Never linked, but helpers may hold it
+        }
+    }
+    reclaim_exit(list->reclaim);
+    return result;
+}
+
+int wait_free_list_delete(WAIT_FREE_LockFreeList* list, int data) {
+    int tid = registry_thread_id();
+    uint64_t op_id = (++wf_ctx[tid].seq << 8) | (uint64_t)tid;
+    int budget = WF_FAST_PATH_ATTEMPTS;
+    int result;
+    reclaim_enter(list->reclaim);
+    wf_maybe_help(list, tid);
+    if (!wf_delete_fast(list, data, op_id, &budget, &result)) {
+        result = wf_slow_path(list, tid, WF_OP_SEARCH_DELETE, data, NULL, op_id);
+    }
+    if (result) {
+        // One bounded pass to unlink the node now rather than on someone's later search
+        WF_Window w;
+        int cleanup = 1;
+        wf_find(list, data, &w, &cleanup, -1, NULL);
+    }
+    reclaim_exit(list->reclaim);
+    return result;
+}
+
+int wait_free_list_search(WAIT_FREE_LockFreeList* list, int data) {
+    int tid = registry_thread_id();
+    int budget = WF_FAST_PATH_ATTEMPTS;
+    int result;
+    reclaim_enter(list->reclaim);
+    wf_maybe_help(list, tid);
+    WF_Window w;
+    if (wf_find(list, data, &w, &budget, -1, NULL)) {
+        result = w.curr != NULL && w.curr->data == data;
+    } else {
+        result = wf_slow_path(list, tid, WF_OP_CONTAINS, data, NULL, 0);
+    }
+    reclaim_exit(list->reclaim);
+    return result;
+}
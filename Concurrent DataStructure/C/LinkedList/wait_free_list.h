@@ -3,25 +3,68 @@
 #define WAIT_FREE_LIST_H
 
 #include <stdatomic.h>
+#include <stdint.h>
 #include <pthread.h>
+#include "../Reclamation/reclaim.h"
 
-#define MARKED_PTR(p)   (WAIT_FREE_Node*)((uintptr_t)(p) | 1)
-#define UNMARKED_PTR(p) (WAIT_FREE_Node*)((uintptr_t)(p) & ~1)
-#define IS_MARKED(p)    ((uintptr_t)(p) & 1)
+// Every successor field is a 64-bit word: bit 0 is the Harris deletion mark, bits
+// 1..47 the node address and bits 48..63 a version that is bumped by every CAS.
+// The version is what stops a delayed helper from re-linking a node after it has
+// been inserted and removed again (pred->next went C -> node -> C).
+#define WF_MARK_BIT       ((uint64_t)1)
+#define WF_VERSION_SHIFT  48
+#define WF_PTR_MASK       ((((uint64_t)1) << WF_VERSION_SHIFT) - 2)
+#define WF_PTR(w)         ((WAIT_FREE_Node*)(uintptr_t)((w) & WF_PTR_MASK))
+#define WF_IS_MARKED(w)   ((w) & WF_MARK_BIT)
+#define WF_VERSION(w)     ((w) >> WF_VERSION_SHIFT)
+#define WF_PACK(p, m, v)  ((uint64_t)(uintptr_t)(p) | ((m) ? WF_MARK_BIT : 0) | \
+                           (((uint64_t)(v) & 0xFFFF) << WF_VERSION_SHIFT))
+
+#ifndef WF_FAST_PATH_ATTEMPTS
+#define WF_FAST_PATH_ATTEMPTS 8  // Lock-free attempts before announcing the operation
+#endif
+#ifndef WF_HELP_DELAY
+#define WF_HELP_DELAY         32 // Fast-path operations between checks on one other thread
+#endif
 
 typedef struct WAIT_FREE_Node {
     int data;
-    _Atomic(struct WAIT_FREE_Node*) next;
+    _Atomic uint64_t next;  // Versioned successor word, see WF_PACK
+    _Atomic uint64_t owner; // Id of the delete that removed the node, 0 while present
+    atomic_int refs;        // One for the list link plus one per pending delete descriptor
 } WAIT_FREE_Node;
 
+typedef enum {
+    WF_OP_INSERT,
+    WF_OP_SEARCH_DELETE,  // Looking for the node to remove
+    WF_OP_EXECUTE_DELETE, // Target fixed, racing for ownership of it
+    WF_OP_CONTAINS,
+    WF_OP_SUCCESS,
+    WF_OP_FAILURE
+} WF_OpType;
+
+// Announced operation; replaced (never mutated) on every state transition
+typedef struct WF_OpDesc {
+    long phase;
+    WF_OpType type;
+    int key;
+    uint64_t op_id;
+    WAIT_FREE_Node* node; // Node to insert, or the delete target
+} WF_OpDesc;
+
 typedef struct WAIT_FREE_LockFreeList {
-    _Atomic(WAIT_FREE_Node*) head;
+    WAIT_FREE_Node head; // Sentinel, never removed
+    _Atomic long phase;
+    _Atomic(WF_OpDesc*) state[REGISTRY_MAX_THREADS]; // Announcement array, indexed by registry_thread_id()
+    Reclaimer* reclaim;
 } WAIT_FREE_LockFreeList;
 
-void wait_free_list_init(WAIT_FREE_LockFreeList* list);
-WAIT_FREE_Node* create_node(int data);
-void wait_free_list_insert(_Atomic(WAIT_FREE_Node*)* head, int data);
-void wait_free_list_delete(_Atomic(WAIT_FREE_Node*)* head, int data);
-int wait_free_list_search(_Atomic(WAIT_FREE_Node*)* head, int data);
+void wait_free_list_init(WAIT_FREE_LockFreeList* list); // Hazard pointers
+void wait_free_list_init_mode(WAIT_FREE_LockFreeList* list, ReclaimMode mode);
+void wait_free_list_destroy(WAIT_FREE_LockFreeList* list);
+// Set semantics: each returns 1 if it changed / found the key, 0 otherwise.
+int wait_free_list_insert(WAIT_FREE_LockFreeList* list, int data);
+int wait_free_list_delete(WAIT_FREE_LockFreeList* list, int data);
+int wait_free_list_search(WAIT_FREE_LockFreeList* list, int data);
 
 #endif // WAIT_FREE_LIST_H
@@ -6,58 +6,124 @@
 
 #define NUM_THREADS 10
 #define OPERATIONS_PER_THREAD 100
+#define CONTENDED_KEYS 16
+#define CONTENDED_OPERATIONS 20000
 
 WAIT_FREE_LockFreeList list;
 
+// Net successful inserts minus successful deletes, per contended key
+atomic_int balance[CONTENDED_KEYS];
+
 void* thread_routine(void* arg) {
     int thread_id = *(int*)arg;
     for (int i = 0; i < OPERATIONS_PER_THREAD; i++) {
         int value = thread_id * OPERATIONS_PER_THREAD + i;
-        
+
         // Insert value into the list
-        wait_free_list_insert(&(list.head), value);
+        int inserted = wait_free_list_insert(&list, value);
+        assert(inserted == 1); // Keys are private to the thread
+        assert(wait_free_list_insert(&list, value) == 0); // Duplicate is rejected
 
         // Search the value in the list
-        int found = wait_free_list_search(&(list.head), value);
+        int found = wait_free_list_search(&list, value);
         assert(found == 1); // Ensure that the inserted value is found
 
         // Delete the value from the list
-        wait_free_list_delete(&(list.head), value);
+        assert(wait_free_list_delete(&list, value) == 1);
+        assert(wait_free_list_delete(&list, value) == 0); // Already gone
 
         // Ensure the value is not found after deletion
-        found = wait_free_list_search(&(list.head), value);
+        found = wait_free_list_search(&list, value);
         assert(found == 0); // Ensure that the deleted value is not found
     }
     return NULL;
 }
 
-int main() {
+// All threads fight over a handful of keys, which drives operations onto the
+// announced slow path. Each success is counted, so the final contents must match.
+void* contended_routine(void* arg) {
+    unsigned int seed = (unsigned int)*(int*)arg;
+    for (int i = 0; i < CONTENDED_OPERATIONS; i++) {
+        int key = rand_r(&seed) % CONTENDED_KEYS;
+        switch (rand_r(&seed) % 3) {
+            case 0:
+                if (wait_free_list_insert(&list, key)) {
+                    atomic_fetch_add(&balance[key], 1);
+                }
+                break;
+            case 1:
+                if (wait_free_list_delete(&list, key)) {
+                    atomic_fetch_sub(&balance[key], 1);
+                }
+                break;
+            default:
+                wait_free_list_search(&list, key);
+                break;
+        }
+    }
+    return NULL;
+}
+
+int run_threads(void* (*routine)(void*)) {
     pthread_t threads[NUM_THREADS];
     int thread_ids[NUM_THREADS];
-    wait_free_list_init(&list);
-
     for (int i = 0; i < NUM_THREADS; i++) {
         thread_ids[i] = i;
-        if (pthread_create(&threads[i], NULL, thread_routine, &thread_ids[i]) != 0) {
+        if (pthread_create(&threads[i], NULL, routine, &thread_ids[i]) != 0) {
             perror("Failed to create thread");
-            return EXIT_FAILURE;
+            return 0;
         }
     }
 
     for (int i = 0; i < NUM_THREADS; i++) {
         pthread_join(threads[i], NULL);
     }
+    return 1;
+}
+
+int run_suite(ReclaimMode mode) {
+    wait_free_list_init_mode(&list, mode);
+    for (int key = 0; key < CONTENDED_KEYS; key++) {
+        atomic_store(&balance[key], 0);
+    }
+
+    if (!run_threads(thread_routine)) {
+        return 0;
+    }
 
     // Verify the list is empty after all operations
-    if (atomic_load(&list.head) != NULL) {
+    if (WF_PTR(atomic_load(&list.head.next)) != NULL) {
         printf("Test failed: list is not empty after all operations.\n");
-    } else {
-        printf("Test passed: list is empty after all operations.\n");
+        return 0;
+    }
+    printf("Test passed (%s): list is empty after all operations.\n", reclaim_mode_name(mode));
+
+    if (!run_threads(contended_routine)) {
+        return 0;
     }
 
+    // Each key must be present exactly when its inserts outnumber its deletes by one
+    for (int key = 0; key < CONTENDED_KEYS; key++) {
+        int expected = atomic_load(&balance[key]);
+        if ((expected != 0 && expected != 1) || wait_free_list_search(&list, key) != expected) {
+            printf("Test failed: key %d has balance %d but search returned %d.\n",
+                   key, expected, wait_free_list_search(&list, key));
+            return 0;
+        }
+    }
+    printf("Test passed (%s): contended inserts and deletes are consistent.\n", reclaim_mode_name(mode));
+
+    wait_free_list_destroy(&list);
+    return 1;
+}
+
+int main() {
+    if (!run_suite(RECLAIM_HAZARD_POINTERS) || !run_suite(RECLAIM_EPOCH)) {
+        return EXIT_FAILURE;
+    }
     return EXIT_SUCCESS;
 }
 
 
-// Compile with: gcc -pg wait_free_list.c wait_free_list_test.c -o wait_free_list -pthread -O3
-// Run with: ./wait_free_list
\ No newline at end of file
+// Compile with: gcc -pg wait_free_list.c wait_free_list_test.c ../Reclamation/*.c -o wait_free_list -pthread -O3
+// Run with: ./wait_free_list
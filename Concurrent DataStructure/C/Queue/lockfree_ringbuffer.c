@@ -24,10 +24,17 @@
 #include <pthread.h> // Include pthread header for mutex
 #include "ring_buffer.h"
 
+// Per-operation tracing; build with -DRING_BUFFER_QUIET when timing the buffer
+#ifdef RING_BUFFER_QUIET
+#define RB_LOG(...) ((void)0)
+#else
+#define RB_LOG(...) printf(__VA_ARGS__)
+#endif
+
 // Initialize the ring buffer
 RingBuffer* initialize(size_t size) {
     RingBuffer *rb = (RingBuffer*)malloc(sizeof(RingBuffer));
-    rb->buffer = (CoWData**)malloc(size * sizeof(CoWData*));
+    rb->buffer = (CoWData**)calloc(size, sizeof(CoWData*)); // Empty slots are NULL for cleanupRingBuffer
     rb->size = size;
     atomic_store(&rb->head, 0);
     atomic_store(&rb->tail, 0);
@@ -43,11 +50,11 @@ RingBuffer* initialize(size_t size) {
 // Insert data into the ring buffer
 void insert(RingBuffer *rb, int value) {
     pthread_mutex_lock(&rb->mutex); // Acquire the lock to ensure exclusive access to the buffer.
-    printf("Attempting to insert value: %d\n", value); // Log attempt to insert
+    RB_LOG("Attempting to insert value: %d\n", value); // Log attempt to insert
 
     // Wait until there is space in the buffer.
     while ((atomic_load(&rb->head) + 1) % rb->size == atomic_load(&rb->tail)) {
-        printf("Buffer full, waiting...\n"); // Log buffer full
+        RB_LOG("Buffer full, waiting...\n"); // Log buffer full
         pthread_cond_wait(&rb->not_full, &rb->mutex);
     }
 
@@ -55,7 +62,7 @@ void insert(RingBuffer *rb, int value) {
     int head = atomic_load(&rb->head);
     CoWData* newData = malloc(sizeof(CoWData)); // Allocate new data.
     if (!newData) {
-        printf("Failed to allocate memory for new data\n"); // Log memory allocation failure
+        RB_LOG("Failed to allocate memory for new data\n"); // Log memory allocation failure
         pthread_mutex_unlock(&rb->mutex);
         return;
     }
@@ -67,12 +74,37 @@ void insert(RingBuffer *rb, int value) {
     atomic_store(&rb->head, (head + 1) % rb->size);
     atomic_fetch_add(&rb->count, 1); // Increment the count of items in the buffer.
 
-    printf("Inserted value: %d at position: %d\n", value, head); // Log successful insert
+    RB_LOG("Inserted value: %d at position: %d\n", value, head); // Log successful insert
 
     pthread_cond_signal(&rb->not_empty); // Signal any waiting threads that the buffer is not empty.
     pthread_mutex_unlock(&rb->mutex); // Release the lock.
 }
 
+// Non-blocking insert: returns false instead of waiting when the buffer is full
+bool tryInsert(RingBuffer *rb, int value) {
+    CoWData* newData = malloc(sizeof(CoWData)); // Allocated outside the critical section
+    if (!newData) {
+        RB_LOG("Failed to allocate memory for new data\n");
+        return false;
+    }
+    newData->data = value;
+    atomic_store(&newData->refCount, 1);
+
+    pthread_mutex_lock(&rb->mutex);
+    int head = atomic_load(&rb->head);
+    if ((head + 1) % rb->size == atomic_load(&rb->tail)) {
+        pthread_mutex_unlock(&rb->mutex);
+        free(newData);
+        return false;
+    }
+    rb->buffer[head] = newData;
+    atomic_store(&rb->head, (head + 1) % rb->size);
+    atomic_fetch_add(&rb->count, 1);
+    pthread_cond_signal(&rb->not_empty);
+    pthread_mutex_unlock(&rb->mutex);
+    return true;
+}
+
 // Function to check if the ring buffer is empty
 bool is_empty(RingBuffer *rb) {
     int head = atomic_load_explicit(&rb->head, memory_order_acquire);
@@ -92,25 +124,25 @@ bool is_full(RingBuffer *rb) {
 // Function to remove an item from the ring buffer, with added checks
 CoWData* ringBufferRemove(RingBuffer *rb) {
     pthread_mutex_lock(&rb->mutex); // Acquire the lock to ensure exclusive access to the buffer.
-    printf("Attempting to remove an item from the buffer...\n"); // Log attempt to remove
+    RB_LOG("Attempting to remove an item from the buffer...\n"); // Log attempt to remove
 
     // Wait until there is at least one item in the buffer.
     while (atomic_load(&rb->head) == atomic_load(&rb->tail)) {
-        printf("Buffer empty, waiting...\n"); // Log buffer empty, waiting for items
+        RB_LOG("Buffer empty, waiting...\n"); // Log buffer empty, waiting for items
         pthread_cond_wait(&rb->not_empty, &rb->mutex);
     }
     
     // Remove the value from the buffer.
     int tail = atomic_load(&rb->tail);
     CoWData* data = rb->buffer[tail]; // Retrieve the data to be removed.
-    printf("Removing value: %d from position: %d\n", data->data, tail); // Log removal details
+    RB_LOG("Removing value: %d from position: %d\n", data->data, tail); // Log removal details
     
     rb->buffer[tail] = NULL; // Clear the buffer slot.
     
     // Update the tail to the next position.
     atomic_store(&rb->tail, (tail + 1) % rb->size);
     atomic_fetch_sub(&rb->count, 1); // Decrement the count of items in the buffer.
-    printf("Item removed. New tail position: %d, Items in buffer now: %d\n", atomic_load(&rb->tail), atomic_load(&rb->count)); // Log new buffer state
+    RB_LOG("Item removed. New tail position: %d, Items in buffer now: %d\n", atomic_load(&rb->tail), atomic_load(&rb->count)); // Log new buffer state
     
     pthread_cond_signal(&rb->not_full); // Signal any waiting threads that the buffer is not full.
     pthread_mutex_unlock(&rb->mutex); // Release the lock.
@@ -118,6 +150,23 @@ CoWData* ringBufferRemove(RingBuffer *rb) {
     return data; // Return the removed data.
 }
 
+// Non-blocking remove: returns NULL instead of waiting when the buffer is empty
+CoWData* tryRingBufferRemove(RingBuffer *rb) {
+    pthread_mutex_lock(&rb->mutex);
+    int tail = atomic_load(&rb->tail);
+    if (atomic_load(&rb->head) == tail) {
+        pthread_mutex_unlock(&rb->mutex);
+        return NULL;
+    }
+    CoWData* data = rb->buffer[tail];
+    rb->buffer[tail] = NULL;
+    atomic_store(&rb->tail, (tail + 1) % rb->size);
+    atomic_fetch_sub(&rb->count, 1);
+    pthread_cond_signal(&rb->not_full);
+    pthread_mutex_unlock(&rb->mutex);
+    return data;
+}
+
 // Function to modify data with Copy-On-Write semantics
 void modifyData(RingBuffer *rb, int index, int newValue) {
     // Calculate actual index considering the ring buffer's nature
@@ -44,9 +44,11 @@ typedef struct {
 // Function prototypes
 RingBuffer* initialize(size_t size);
 void insert(RingBuffer *rb, int value);
+bool tryInsert(RingBuffer *rb, int value); // false when full
 bool is_empty(RingBuffer *rb);
 bool is_full(RingBuffer *rb);
 CoWData* ringBufferRemove(RingBuffer *rb);
+CoWData* tryRingBufferRemove(RingBuffer *rb); // NULL when empty
 void modifyData(RingBuffer *rb, int index, int newValue);
 void cleanupRingBuffer(RingBuffer *rb);
 
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "epoch.h"
+
+#define EBR_IDLE             UINT64_MAX // Record value of a thread outside any operation
+#define EBR_BAGS             3          // Epochs e-2, e-1 and e are live at any time
+#define EBR_ADVANCE_INTERVAL 64         // Retires between attempts to advance the epoch
+
+typedef struct {
+    void* ptr;
+    void (*reclaim)(void*);
+} EBR_Retired;
+
+typedef struct {
+    EBR_Retired* items;
+    size_t count;
+    size_t capacity;
+    uint64_t epoch; // Epoch the items were retired in
+} EBR_Bag;
+
+// Only the owner writes a record; others read pinned_epoch when advancing
+typedef struct {
+    _Alignas(64) _Atomic uint64_t pinned_epoch;
+    int nesting;
+    unsigned retires;
+    EBR_Bag bags[EBR_BAGS];
+} EBR_Record;
+
+struct EBR_Domain {
+    _Alignas(64) _Atomic uint64_t global_epoch;
+    EBR_Record records[REGISTRY_MAX_THREADS];
+};
+
+EBR_Domain* ebr_domain_create(void) {
+    EBR_Domain* domain = (EBR_Domain*)aligned_alloc(64, sizeof(EBR_Domain));
+    if (!domain) {
+        perror("aligned_alloc failed");
+        exit(EXIT_FAILURE);
+    }
+    atomic_init(&domain->global_epoch, 0);
+    for (int t = 0; t < REGISTRY_MAX_THREADS; t++) {
+        EBR_Record* rec = &domain->records[t];
+        atomic_init(&rec->pinned_epoch, EBR_IDLE);
+        rec->nesting = 0;
+        rec->retires = 0;
+        for (int b = 0; b < EBR_BAGS; b++) {
+            rec->bags[b].items = NULL;
+            rec->bags[b].count = 0;
+            rec->bags[b].capacity = 0;
+            rec->bags[b].epoch = 0;
+        }
+    }
+    return domain;
+}
+
+static void ebr_free_bag(EBR_Bag* bag) {
+    for (size_t i = 0; i < bag->count; i++) {
+        bag->items[i].reclaim(bag->items[i].ptr);
+    }
+    bag->count = 0;
+}
+
+void ebr_domain_destroy(EBR_Domain* domain) {
+    for (int t = 0; t < REGISTRY_MAX_THREADS; t++) {
+        for (int b = 0; b < EBR_BAGS; b++) {
+            ebr_free_bag(&domain->records[t].bags[b]);
+            free(domain->records[t].bags[b].items);
+        }
+    }
+    free(domain);
+}
+
+// Frees the caller's bags that are two or more epochs behind the global epoch
+static void ebr_collect(EBR_Record* rec, uint64_t global) {
+    for (int b = 0; b < EBR_BAGS; b++) {
+        EBR_Bag* bag = &rec->bags[b];
+        if (bag->count > 0 && bag->epoch + 2 <= global) {
+            ebr_free_bag(bag);
+        }
+    }
+}
+
+// The epoch may move from e to e + 1 once no thread is still pinned in e - 1
+static void ebr_try_advance(EBR_Domain* domain, EBR_Record* rec) {
+    uint64_t global = atomic_load(&domain->global_epoch);
+    int threads = registry_high_water();
+    for (int t = 0; t < threads; t++) {
+        uint64_t pinned = atomic_load(&domain->records[t].pinned_epoch);
+        if (pinned != EBR_IDLE && pinned != global) {
+            ebr_collect(rec, global);
+            return;
+        }
+    }
+    if (atomic_compare_exchange_strong(&domain->global_epoch, &global, global + 1)) {
+        global++;
+    }
+    ebr_collect(rec, global);
+}
+
+void ebr_enter(EBR_Domain* domain) {
+    EBR_Record* rec = &domain->records[registry_thread_id()];
+    if (rec->nesting++ == 0) {
+        // Sequentially consistent store: the pin is visible before any shared load
+        atomic_store(&rec->pinned_epoch, atomic_load(&domain->global_epoch));
+    }
+}
+
+void ebr_exit(EBR_Domain* domain) {
+    EBR_Record* rec = &domain->records[registry_thread_id()];
+    if (--rec->nesting == 0) {
+        atomic_store_explicit(&rec->pinned_epoch, EBR_IDLE, memory_order_release);
+    }
+}
+
+void ebr_retire(EBR_Domain* domain, void* ptr, void (*reclaim)(void*)) {
+    EBR_Record* rec = &domain->records[registry_thread_id()];
+    uint64_t global = atomic_load(&domain->global_epoch);
+    EBR_Bag* bag = &rec->bags[global % EBR_BAGS];
+    if (bag->epoch != global) {
+        // The slot last held epoch global - 3 or older, which is safe to free
+        ebr_free_bag(bag);
+        bag->epoch = global;
+    }
+    if (bag->count == bag->capacity) {
+        size_t capacity = bag->capacity ? bag->capacity * 2 : EBR_ADVANCE_INTERVAL;
+        EBR_Retired* grown = (EBR_Retired*)realloc(bag->items, capacity * sizeof(EBR_Retired));
+        if (!grown) {
+            perror("realloc failed");
+            exit(EXIT_FAILURE);
+        }
+        bag->items = grown;
+        bag->capacity = capacity;
+    }
+    bag->items[bag->count].ptr = ptr;
+    bag->items[bag->count].reclaim = reclaim;
+    bag->count++;
+
+    if (++rec->retires % EBR_ADVANCE_INTERVAL == 0) {
+        ebr_try_advance(domain, rec);
+    }
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// epoch.h
+// Epoch-based reclamation (Fraser). A thread pins the global epoch for the length
+// of an operation; leaving the operation is its quiescent state. Memory retired in
+// epoch e is freed once the global epoch reaches e + 2, i.e. after every pinned
+// thread has left an operation that could still see it. Reads cost one store on
+// entry and one on exit, but a thread stalled inside an operation holds back all
+// reclamation (hazard pointers bound that, see hazard_pointer.h).
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include "thread_registry.h"
+
+typedef struct EBR_Domain EBR_Domain;
+
+EBR_Domain* ebr_domain_create(void);
+// Frees everything still retired; no other thread may use the domain anymore.
+void ebr_domain_destroy(EBR_Domain* domain);
+
+// Pin / unpin the calling thread; calls nest.
+void ebr_enter(EBR_Domain* domain);
+void ebr_exit(EBR_Domain* domain);
+// Hands ptr to the domain; reclaim(ptr) runs two epochs later.
+void ebr_retire(EBR_Domain* domain, void* ptr, void (*reclaim)(void*));
+
+#endif // EPOCH_H
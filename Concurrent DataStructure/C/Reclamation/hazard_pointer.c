@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "hazard_pointer.h"
+
+#define HP_MIN_SCAN_THRESHOLD 64
+
+typedef struct {
+    void* ptr;
+    void (*reclaim)(void*);
+} HP_Retired;
+
+// One row per thread, padded so that publishing a hazard never bounces a line
+// that another thread is writing.
+typedef struct {
+    _Alignas(64) _Atomic(void*) hazards[HP_MAX_HAZARDS];
+    HP_Retired* retired;
+    size_t retired_count;
+    size_t retired_capacity;
+} HP_Record;
+
+struct HP_Domain {
+    int hazards_per_thread;
+    HP_Record records[REGISTRY_MAX_THREADS];
+};
+
+HP_Domain* hp_domain_create(int hazards_per_thread) {
+    if (hazards_per_thread < 1 || hazards_per_thread > HP_MAX_HAZARDS) {
+        fprintf(stderr, "hp_domain_create: hazards_per_thread must be in [1, %d]\n", HP_MAX_HAZARDS);
+        exit(EXIT_FAILURE);
+    }
+    HP_Domain* domain = (HP_Domain*)aligned_alloc(64, sizeof(HP_Domain));
+    if (!domain) {
+        perror("aligned_alloc failed");
+        exit(EXIT_FAILURE);
+    }
+    domain->hazards_per_thread = hazards_per_thread;
+    for (int t = 0; t < REGISTRY_MAX_THREADS; t++) {
+        for (int i = 0; i < HP_MAX_HAZARDS; i++) {
+            atomic_init(&domain->records[t].hazards[i], NULL);
+        }
+        domain->records[t].retired = NULL;
+        domain->records[t].retired_count = 0;
+        domain->records[t].retired_capacity = 0;
+    }
+    return domain;
+}
+
+void hp_domain_destroy(HP_Domain* domain) {
+    for (int t = 0; t < REGISTRY_MAX_THREADS; t++) {
+        HP_Record* rec = &domain->records[t];
+        for (size_t i = 0; i < rec->retired_count; i++) {
+            rec->retired[i].reclaim(rec->retired[i].ptr);
+        }
+        free(rec->retired);
+    }
+    free(domain);
+}
+
+void hp_protect(HP_Domain* domain, int index, void* ptr) {
+    atomic_store(&domain->records[registry_thread_id()].hazards[index], ptr);
+}
+
+void hp_clear(HP_Domain* domain) {
+    HP_Record* rec = &domain->records[registry_thread_id()];
+    for (int i = 0; i < domain->hazards_per_thread; i++) {
+        atomic_store_explicit(&rec->hazards[i], NULL, memory_order_release);
+    }
+}
+
+static int hp_compare_ptr(const void* a, const void* b) {
+    uintptr_t x = (uintptr_t)*(void* const*)a;
+    uintptr_t y = (uintptr_t)*(void* const*)b;
+    return (x > y) - (x < y);
+}
+
+void hp_scan(HP_Domain* domain) {
+    HP_Record* rec = &domain->records[registry_thread_id()];
+    int threads = registry_high_water();
+    void* snapshot[REGISTRY_MAX_THREADS * HP_MAX_HAZARDS];
+    size_t n = 0;
+
+    // Stage 1: snapshot every published hazard, sorted for binary search
+    for (int t = 0; t < threads; t++) {
+        for (int i = 0; i < domain->hazards_per_thread; i++) {
+            void* p = atomic_load(&domain->records[t].hazards[i]);
+            if (p != NULL) {
+                snapshot[n++] = p;
+            }
+        }
+    }
+    qsort(snapshot, n, sizeof(void*), hp_compare_ptr);
+
+    // Stage 2: reclaim whatever nobody protects, compact the rest in place
+    size_t kept = 0;
+    for (size_t i = 0; i < rec->retired_count; i++) {
+        HP_Retired r = rec->retired[i];
+        if (bsearch(&r.ptr, snapshot, n, sizeof(void*), hp_compare_ptr) != NULL) {
+            rec->retired[kept++] = r;
+        } else {
+            r.reclaim(r.ptr);
+        }
+    }
+    rec->retired_count = kept;
+}
+
+void hp_retire(HP_Domain* domain, void* ptr, void (*reclaim)(void*)) {
+    HP_Record* rec = &domain->records[registry_thread_id()];
+    if (rec->retired_count == rec->retired_capacity) {
+        size_t capacity = rec->retired_capacity ? rec->retired_capacity * 2 : HP_MIN_SCAN_THRESHOLD;
+        HP_Retired* grown = (HP_Retired*)realloc(rec->retired, capacity * sizeof(HP_Retired));
+        if (!grown) {
+            perror("realloc failed");
+            exit(EXIT_FAILURE);
+        }
+        rec->retired = grown;
+        rec->retired_capacity = capacity;
+    }
+    rec->retired[rec->retired_count].ptr = ptr;
+    rec->retired[rec->retired_count].reclaim = reclaim;
+    rec->retired_count++;
+
+    // Batch: scanning costs O(H log H) for H published hazards, so wait until the
+    // list is a constant factor larger than H and each scan frees Omega(H) nodes.
+    size_t threshold = 2 * (size_t)domain->hazards_per_thread * (size_t)registry_high_water();
+    if (threshold < HP_MIN_SCAN_THRESHOLD) {
+        threshold = HP_MIN_SCAN_THRESHOLD;
+    }
+    if (rec->retired_count >= threshold) {
+        hp_scan(domain);
+    }
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// hazard_pointer.h
+// C counterpart of HPManager (CPP/LinkedList/HazardPointer.hpp): every thread owns
+// a fixed row of hazard slots and a private retire list, and reclaims in batches
+// by scanning the published hazards. No global lock is taken on any path.
+#ifndef HAZARD_POINTER_H
+#define HAZARD_POINTER_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include "thread_registry.h"
+
+#define HP_MAX_HAZARDS 8 // Upper bound on hazards_per_thread
+
+typedef struct HP_Domain HP_Domain;
+
+HP_Domain* hp_domain_create(int hazards_per_thread);
+// Frees everything still retired; no other thread may use the domain anymore.
+void hp_domain_destroy(HP_Domain* domain);
+
+// Publishes ptr in slot index of the calling thread. The store is sequentially
+// consistent, so re-reading the source location afterwards validates it.
+void hp_protect(HP_Domain* domain, int index, void* ptr);
+void hp_clear(HP_Domain* domain);
+// Hands ptr to the domain; reclaim(ptr) runs once no thread publishes ptr.
+void hp_retire(HP_Domain* domain, void* ptr, void (*reclaim)(void*));
+// Reclaims what it can from the calling thread's retire list right away.
+void hp_scan(HP_Domain* domain);
+
+#endif // HAZARD_POINTER_H
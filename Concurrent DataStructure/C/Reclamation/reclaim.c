@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "reclaim.h"
+
+Reclaimer* reclaimer_create(ReclaimMode mode, int hazards_per_thread) {
+    Reclaimer* r = (Reclaimer*)malloc(sizeof(Reclaimer));
+    if (!r) {
+        perror("malloc failed");
+        exit(EXIT_FAILURE);
+    }
+    r->mode = mode;
+    r->hp = NULL;
+    r->ebr = NULL;
+    if (mode == RECLAIM_EPOCH) {
+        r->ebr = ebr_domain_create();
+    } else {
+        r->hp = hp_domain_create(hazards_per_thread);
+    }
+    return r;
+}
+
+void reclaimer_destroy(Reclaimer* r) {
+    if (r->hp != NULL) {
+        hp_domain_destroy(r->hp);
+    }
+    if (r->ebr != NULL) {
+        ebr_domain_destroy(r->ebr);
+    }
+    free(r);
+}
+
+const char* reclaim_mode_name(ReclaimMode mode) {
+    return mode == RECLAIM_EPOCH ? "epoch" : "hazard_pointers";
+}
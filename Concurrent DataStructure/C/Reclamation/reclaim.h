@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// reclaim.h
+// Safe memory reclamation for the C concurrent structures, one interface over
+// hazard pointers and epochs. A structure brackets every operation with
+// reclaim_enter / reclaim_exit, calls reclaim_protect on each shared node before
+// dereferencing it (then re-reads the link it came from), and reclaim_retire on
+// each node it unlinks instead of free(). In epoch mode protect is a no-op.
+#ifndef RECLAIM_H
+#define RECLAIM_H
+
+#include "thread_registry.h"
+#include "hazard_pointer.h"
+#include "epoch.h"
+
+typedef enum {
+    RECLAIM_HAZARD_POINTERS, // Bounded garbage, a fenced store per protected node
+    RECLAIM_EPOCH            // Cheapest reads, garbage unbounded while a thread stalls
+} ReclaimMode;
+
+typedef struct {
+    ReclaimMode mode;
+    HP_Domain* hp;
+    EBR_Domain* ebr;
+} Reclaimer;
+
+Reclaimer* reclaimer_create(ReclaimMode mode, int hazards_per_thread);
+void reclaimer_destroy(Reclaimer* r);
+const char* reclaim_mode_name(ReclaimMode mode);
+
+static inline void reclaim_enter(Reclaimer* r) {
+    if (r->mode == RECLAIM_EPOCH) {
+        ebr_enter(r->ebr);
+    }
+}
+
+static inline void reclaim_exit(Reclaimer* r) {
+    if (r->mode == RECLAIM_EPOCH) {
+        ebr_exit(r->ebr);
+    } else {
+        hp_clear(r->hp);
+    }
+}
+
+static inline void reclaim_protect(Reclaimer* r, int index, void* ptr) {
+    if (r->mode == RECLAIM_HAZARD_POINTERS) {
+        hp_protect(r->hp, index, ptr);
+    }
+}
+
+static inline void reclaim_retire(Reclaimer* r, void* ptr, void (*reclaim)(void*)) {
+    if (r->mode == RECLAIM_EPOCH) {
+        ebr_retire(r->ebr, ptr, reclaim);
+    } else {
+        hp_retire(r->hp, ptr, reclaim);
+    }
+}
+
+#endif // RECLAIM_H
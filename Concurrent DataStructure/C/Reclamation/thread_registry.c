@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "thread_registry.h"
+
+static atomic_bool registry_slot_used[REGISTRY_MAX_THREADS];
+static atomic_int registry_high;
+static _Thread_local int registry_tid = -1;
+static pthread_key_t registry_key;
+static pthread_once_t registry_key_once = PTHREAD_ONCE_INIT;
+
+static void registry_release_slot(void* arg) {
+    atomic_store(&registry_slot_used[(intptr_t)arg - 1], false);
+}
+
+static void registry_make_key(void) {
+    if (pthread_key_create(&registry_key, registry_release_slot) != 0) {
+        perror("pthread_key_create failed");
+        exit(EXIT_FAILURE);
+    }
+}
+
+int registry_thread_id(void) {
+    if (registry_tid >= 0) {
+        return registry_tid;
+    }
+    pthread_once(&registry_key_once, registry_make_key);
+    for (int i = 0; i < REGISTRY_MAX_THREADS; i++) {
+        bool expected = false;
+        if (!atomic_load(&registry_slot_used[i]) &&
+            atomic_compare_exchange_strong(&registry_slot_used[i], &expected, true)) {
+            int seen = atomic_load(&registry_high);
+            while (seen < i + 1 && !atomic_compare_exchange_weak(&registry_high, &seen, i + 1)) {
+            }
+            pthread_setspecific(registry_key, (void*)(intptr_t)(i + 1)); // +1: NULL means "no slot"
+            registry_tid = i;
+            return i;
+        }
+    }
+    fprintf(stderr, "registry_thread_id: more than %d concurrent threads\n", REGISTRY_MAX_THREADS);
+    exit(EXIT_FAILURE);
+}
+
+int registry_high_water(void) {
+    return atomic_load(&registry_high);
+}
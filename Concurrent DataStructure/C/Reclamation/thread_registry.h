@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// thread_registry.h
+// Dense, reusable thread ids for the per-thread arrays of the reclamation schemes
+// and of the structures built on them.
+#ifndef THREAD_REGISTRY_H
+#define THREAD_REGISTRY_H
+
+#define REGISTRY_MAX_THREADS 128 // Concurrently registered threads, process wide
+
+// Id of the calling thread in [0, REGISTRY_MAX_THREADS). Assigned on first use and
+// handed back when the thread exits, so short-lived threads do not exhaust slots.
+int registry_thread_id(void);
+// One past the largest id handed out so far; bounds loops over per-thread arrays.
+int registry_high_water(void);
+
+#endif // THREAD_REGISTRY_H
@@ -1,18 +1,30 @@
 #include <stdatomic.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <stdio.h>
+#include "wait_free_stack.h"
 
-typedef struct Node {
-    int data;
-    struct Node* next;
-} Node;
+#define STACK_HP_TOP 0 // The only hazard a pop needs: the top it tries to remove
 
-typedef struct {
-    atomic_uintptr_t top;
-} WaitFreeStack;
+void stack_init_mode(WaitFreeStack* stack, ReclaimMode mode) {
+    atomic_store(&stack->top, (uintptr_t)NULL);
+    stack->reclaim = reclaimer_create(mode, 1);
+}
 
 void stack_init(WaitFreeStack* stack) {
+    stack_init_mode(stack, RECLAIM_HAZARD_POINTERS);
+}
+
+void stack_destroy(WaitFreeStack* stack) {
+    Node* node = (Node*)atomic_load(&stack->top);
+    while (node != NULL) {
+        Node* next = node->next;
+        free(node);
+        node = next;
+    }
     atomic_store(&stack->top, (uintptr_t)NULL);
+    reclaimer_destroy(stack->reclaim); // Frees popped nodes not reclaimed yet
+    stack->reclaim = NULL;
 }
 
 Node* create_node(int data) {
@@ -38,102 +50,32 @@ void stack_push(WaitFreeStack* stack, int data) {
 
 //  atomic pop operation that tries to minimize waiting by using atomic compare-and-exchange operations to update the stack's top
 int stack_pop(WaitFreeStack* stack, int* poppedValue) {
+    Reclaimer* r = stack->reclaim;
     Node* oldTop;
     Node* newTop;
-    do {
+    reclaim_enter(r);
+    for (;;) {
         oldTop = (Node*)atomic_load(&stack->top);
         if (oldTop == NULL) {
+            reclaim_exit(r);
             return 0; // Stack is empty, cannot pop
         }
+        // Protect before reading oldTop->next: without it another thread could pop
+        // and free oldTop here, and a recycled address would also let the CAS
+        // below succeed on a stale newTop (ABA).
+        reclaim_protect(r, STACK_HP_TOP, oldTop);
+        if ((Node*)atomic_load(&stack->top) != oldTop) {
+            continue;
+        }
         newTop = oldTop->next;
         // Attempt to set the new top, if the top hasn't changed since this operation started
-        
-    } while (!atomic_compare_exchange_weak(&stack->top, (uintptr_t*)&oldTop, (uintptr_t)newTop));
+        if (atomic_compare_exchange_weak(&stack->top, (uintptr_t*)&oldTop, (uintptr_t)newTop)) {
+            break;
+        }
+    }
 
     *poppedValue = oldTop->data; // Retrieve the value to return
-    free(oldTop); // Free the popped node
+    reclaim_retire(r, oldTop, free); // Freed once no other pop can still be reading it
+    reclaim_exit(r);
     return 1; // Success
 }
-
-
-// int main() {
-//     WaitFreeStack stack;
-//     stack_init(&stack);
-    
-//     // Example usage
-//     stack_push(&stack, 10);
-//     printf("Pushed: %d",10);
-//     stack_push(&stack, 20);
-//     printf("Pushed: %d",20);
-//     int value;
-//     if (stack_pop(&stack, &value)) {
-//         printf("Popped: %d\n", value);
-//     } else {
-//         printf("Failed to pop: Stack might be empty.\n");
-//     }
-
-//     // Continue with stack operations...
-
-//     return 0;
-// }
-
-#include <pthread.h>
-#include <stdatomic.h>
-#include <stdio.h>
-#include <stdlib.h>
-
-#define NUM_THREADS 10
-
-typedef struct {
-    WaitFreeStack* stack;
-    int thread_id;
-} ThreadData;
-
-void* thread_push(void* arg) {
-    ThreadData* data = (ThreadData*)arg;
-    int value = data->thread_id;
-    for (int i = 0; i < 10; ++i) {
-        stack_push(data->stack, value * 10 + i);
-    }
-    return NULL;
-}
-
-void* thread_pop(void* arg) {
-    WaitFreeStack* stack = (WaitFreeStack*)arg;
-    int poppedValue;
-    for (int i = 0; i < 10; ++i) {
-        if (stack_pop(stack, &poppedValue)) {
-            printf("Thread popped: %d\n", poppedValue);
-        } else {
-            printf("Thread failed to pop, stack might be empty.\n");
-        }
-    }
-    return NULL;
-}
-
-int main() {
-    WaitFreeStack stack;
-    stack_init(&stack);
-
-    pthread_t threads[NUM_THREADS];
-    ThreadData data[NUM_THREADS / 2]; // Half for push, half for pop
-
-    // Create threads for pushing
-    for (int i = 0; i < NUM_THREADS / 2; ++i) {
-        data[i].stack = &stack;
-        data[i].thread_id = i;
-        pthread_create(&threads[i], NULL, thread_push, &data[i]);
-    }
-
-    // Create threads for popping
-    for (int i = NUM_THREADS / 2; i < NUM_THREADS; ++i) {
-        pthread_create(&threads[i], NULL, thread_pop, &stack);
-    }
-
-    // Wait for all threads to complete
-    for (int i = 0; i < NUM_THREADS; ++i) {
-        pthread_join(threads[i], NULL);
-    }
-
-    return 0;
-}
\ No newline at end of file
@@ -0,0 +1,25 @@
+// wait_free_stack.h
+#ifndef WAIT_FREE_STACK_H
+#define WAIT_FREE_STACK_H
+
+#include <stdatomic.h>
+#include "../Reclamation/reclaim.h"
+
+typedef struct Node {
+    int data;
+    struct Node* next;
+} Node;
+
+typedef struct {
+    atomic_uintptr_t top;
+    Reclaimer* reclaim;
+} WaitFreeStack;
+
+void stack_init(WaitFreeStack* stack); // Hazard pointers
+void stack_init_mode(WaitFreeStack* stack, ReclaimMode mode);
+void stack_destroy(WaitFreeStack* stack);
+Node* create_node(int data);
+void stack_push(WaitFreeStack* stack, int data);
+int stack_pop(WaitFreeStack* stack, int* poppedValue);
+
+#endif // WAIT_FREE_STACK_H
@@ -0,0 +1,92 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "wait_free_stack.h"
+
+// int main() {
+//     WaitFreeStack stack;
+//     stack_init(&stack);
+    
+//     // Example usage
+//     stack_push(&stack, 10);
+//     printf("Pushed: %d",10);
+//     stack_push(&stack, 20);
+//     printf("Pushed: %d",20);
+//     int value;
+//     if (stack_pop(&stack, &value)) {
+//         printf("Popped: %d\n", value);
+//     } else {
+//         printf("Failed to pop: Stack might be empty.\n");
+//     }
+
+//     // Continue with stack operations...
+
+//     return 0;
+// }
+
+#define NUM_THREADS 10
+
+typedef struct {
+    WaitFreeStack* stack;
+    int thread_id;
+} ThreadData;
+
+void* thread_push(void* arg) {
+    ThreadData* data = (ThreadData*)arg;
+    int value = data->thread_id;
+    for (int i = 0; i < 10; ++i) {
+        stack_push(data->stack, value * 10 + i);
+    }
+    return NULL;
+}
+
+void* thread_pop(void* arg) {
+    WaitFreeStack* stack = (WaitFreeStack*)arg;
+    int poppedValue;
+    for (int i = 0; i < 10; ++i) {
+        if (stack_pop(stack, &poppedValue)) {
+            printf("Thread popped: %d\n", poppedValue);
+        } else {
+            printf("Thread failed to pop, stack might be empty.\n");
+        }
+    }
+    return NULL;
+}
+
+int run_test(ReclaimMode mode) {
+    WaitFreeStack stack;
+    stack_init_mode(&stack, mode);
+
+    pthread_t threads[NUM_THREADS];
+    ThreadData data[NUM_THREADS / 2]; // Half for push, half for pop
+
+    // Create threads for pushing
+    for (int i = 0; i < NUM_THREADS / 2; ++i) {
+        data[i].stack = &stack;
+        data[i].thread_id = i;
+        pthread_create(&threads[i], NULL, thread_push, &data[i]);
+    }
+
+    // Create threads for popping
+    for (int i = NUM_THREADS / 2; i < NUM_THREADS; ++i) {
+        pthread_create(&threads[i], NULL, thread_pop, &stack);
+    }
+
+    // Wait for all threads to complete
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    printf("Finished with %s reclamation.\n", reclaim_mode_name(mode));
+    stack_destroy(&stack); // Frees whatever the poppers left behind
+    return 0;
+}
+
+int main() {
+    run_test(RECLAIM_HAZARD_POINTERS);
+    run_test(RECLAIM_EPOCH);
+    return 0;
+}
+
+// Compile with: gcc wait_free_stack_test.c wait_free_stack.c ../Reclamation/*.c -o wait_free_stack -pthread -O3
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "union_find.h"
+
+#define UF_PARENT(word) ((int32_t)(uint32_t)(word))
+#define UF_RANK(word) ((uint32_t)((word) >> 32))
+#define UF_WORD(rank, parent) ((uint64_t)(rank) << 32 | (uint32_t)(parent))
+
+UnionFind* uf_create(int32_t size) {
+    UnionFind* uf = (UnionFind*)malloc(sizeof(UnionFind));
+    if (!uf) {
+        perror("malloc failed");
+        exit(EXIT_FAILURE);
+    }
+    uf->size = size;
+    uf->nodes = (_Atomic uint64_t*)malloc(((size_t)size + 1) * sizeof(_Atomic uint64_t));
+    if (!uf->nodes) {
+        perror("malloc failed");
+        exit(EXIT_FAILURE);
+    }
+    #pragma omp parallel for schedule(static)
+    for (int32_t x = 0; x < size; x++) {
+        atomic_init(&uf->nodes[x], UF_WORD(0, x));
+    }
+    return uf;
+}
+
+void uf_destroy(UnionFind* uf) {
+    free(uf->nodes);
+    free(uf);
+}
+
+int32_t uf_find(UnionFind* uf, int32_t x) {
+    while (1) {
+        uint64_t word = atomic_load_explicit(&uf->nodes[x], memory_order_acquire);
+        int32_t parent = UF_PARENT(word);
+        if (parent == x) {
+            return x;
+        }
+        uint64_t parentWord = atomic_load_explicit(&uf->nodes[parent], memory_order_acquire);
+        int32_t grand = UF_PARENT(parentWord);
+        if (grand != parent) {
+            // Path splitting: point x at its grandparent. Losing the CAS only
+            // means someone else already shortened or changed this link.
+            atomic_compare_exchange_weak_explicit(&uf->nodes[x], &word, UF_WORD(UF_RANK(word), grand),
+                                                  memory_order_release, memory_order_relaxed);
+        }
+        x = parent;
+    }
+}
+
+int uf_unite(UnionFind* uf, int32_t x, int32_t y) {
+    while (1) {
+        x = uf_find(uf, x);
+        y = uf_find(uf, y);
+        if (x == y) {
+            return 0;
+        }
+        uint64_t xWord = atomic_load_explicit(&uf->nodes[x], memory_order_acquire);
+        uint64_t yWord = atomic_load_explicit(&uf->nodes[y], memory_order_acquire);
+        uint32_t xRank = UF_RANK(xWord), yRank = UF_RANK(yWord);
+        if (UF_PARENT(xWord) != x || UF_PARENT(yWord) != y) {
+            continue; // One of them was linked away meanwhile
+        }
+        // Link the smaller (rank, index) root under the larger
+        if (xRank > yRank || (xRank == yRank && x > y)) {
+            int32_t tmp = x;
+            x = y;
+            y = tmp;
+            uint64_t tmpWord = xWord;
+            xWord = yWord;
+            yWord = tmpWord;
+        }
+        // The CAS fails if x stopped being a root or its rank grew
+        if (!atomic_compare_exchange_strong_explicit(&uf->nodes[x], &xWord, UF_WORD(UF_RANK(xWord), y),
+                                                     memory_order_acq_rel, memory_order_relaxed)) {
+            continue;
+        }
+        if (UF_RANK(xWord) == UF_RANK(yWord)) {
+            // Best effort: if y was linked elsewhere or already promoted, leave it
+            atomic_compare_exchange_strong_explicit(&uf->nodes[y], &yWord, UF_WORD(UF_RANK(yWord) + 1, y),
+                                                    memory_order_acq_rel, memory_order_relaxed);
+        }
+        return 1;
+    }
+}
+
+int uf_same_set(UnionFind* uf, int32_t x, int32_t y) {
+    while (1) {
+        x = uf_find(uf, x);
+        y = uf_find(uf, y);
+        if (x == y) {
+            return 1;
+        }
+        // x was a root after y's root was found, so at that instant they differed
+        if (UF_PARENT(atomic_load_explicit(&uf->nodes[x], memory_order_acquire)) == x) {
+            return 0;
+        }
+    }
+}
+
+long uf_unite_edges(UnionFind* uf, const UF_Edge* edges, size_t count) {
+    long merged = 0;
+    #pragma omp parallel for schedule(dynamic, 4096) reduction(+:merged)
+    for (size_t i = 0; i < count; i++) {
+        merged += uf_unite(uf, edges[i].u, edges[i].v);
+    }
+    return merged;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+
+// union_find.h
+// Lock-free union-find (disjoint sets) over the elements 0..n-1, after
+// Anderson and Woll. Each element is one 64-bit word holding (rank << 32 |
+// parent), so a single CAS both checks that a root is still a root with the
+// rank that was read and re-links it. Roots are linked by (rank, index): the
+// smaller pair goes under the larger, which keeps the forest acyclic under any
+// interleaving. find shortens paths with path splitting, also by CAS, so every
+// operation is lock-free and no thread ever waits on another.
+#ifndef UNION_FIND_H
+#define UNION_FIND_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    int32_t u;
+    int32_t v;
+} UF_Edge;
+
+typedef struct {
+    int32_t size;
+    _Atomic uint64_t* nodes; // (rank << 32) | parent
+} UnionFind;
+
+UnionFind* uf_create(int32_t size); // Every element starts in its own set
+void uf_destroy(UnionFind* uf);
+
+// Representative of x's set. Representatives change as sets merge, so compare
+// two of them only with same_set while other threads are uniting.
+int32_t uf_find(UnionFind* uf, int32_t x);
+
+// Merges the sets of x and y; returns 1 if they were separate, 0 if already joined.
+int uf_unite(UnionFind* uf, int32_t x, int32_t y);
+
+// Whether x and y are in the same set, linearizable against concurrent unites.
+int uf_same_set(UnionFind* uf, int32_t x, int32_t y);
+
+// Unites every edge of the batch on all OpenMP threads; returns how many
+// edges merged two sets, so a batch on a fresh structure leaves
+// size - merged sets.
+long uf_unite_edges(UnionFind* uf, const UF_Edge* edges, size_t count);
+
+#endif // UNION_FIND_H
@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include "union_find.h"
+
+#define NUM_ELEMENTS 1000000
+#define NUM_EDGES 3000000
+#define STREAM_BATCHES 16
+
+// Sequential union-find with the same edges, for the expected answers
+static int32_t serial_find(int32_t* parent, int32_t x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+// Mostly short-range edges, so sets grow gradually instead of collapsing at once
+static UF_Edge* random_edges(unsigned seed) {
+    UF_Edge* edges = (UF_Edge*)malloc(NUM_EDGES * sizeof(UF_Edge));
+    if (!edges) {
+        perror("malloc failed");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < NUM_EDGES; i++) {
+        edges[i].u = rand_r(&seed) % NUM_ELEMENTS;
+        edges[i].v = i % 64 == 0 ? rand_r(&seed) % NUM_ELEMENTS
+                                 : (edges[i].u + rand_r(&seed) % 1024) % NUM_ELEMENTS;
+    }
+    return edges;
+}
+
+// Edges arrive in batches; between batches every answer must match the
+// sequential structure fed the same prefix
+int test_streaming(const UF_Edge* edges) {
+    UnionFind* uf = uf_create(NUM_ELEMENTS);
+    int32_t* parent = (int32_t*)malloc(NUM_ELEMENTS * sizeof(int32_t));
+    long sets = NUM_ELEMENTS, expectedSets = NUM_ELEMENTS;
+    for (int32_t x = 0; x < NUM_ELEMENTS; x++) {
+        parent[x] = x;
+    }
+
+    double seconds = 0;
+    size_t batch = NUM_EDGES / STREAM_BATCHES;
+    for (int b = 0; b < STREAM_BATCHES; b++) {
+        const UF_Edge* chunk = edges + b * batch;
+        double t0 = omp_get_wtime();
+        sets -= uf_unite_edges(uf, chunk, batch);
+        seconds += omp_get_wtime() - t0;
+
+        for (size_t i = 0; i < batch; i++) {
+            int32_t ru = serial_find(parent, chunk[i].u), rv = serial_find(parent, chunk[i].v);
+            if (ru != rv) {
+                parent[ru] = rv;
+                expectedSets--;
+            }
+        }
+        if (sets != expectedSets) {
+            printf("Test failed: batch %d leaves %ld sets, expected %ld.\n", b, sets, expectedSets);
+            return 0;
+        }
+        int mismatch = 0;
+        #pragma omp parallel for reduction(+:mismatch)
+        for (int32_t x = 1; x < NUM_ELEMENTS; x++) {
+            // Only reads, so the reference needs no path compression here
+            int32_t rx = x, ry = x - 1;
+            while (parent[rx] != rx) rx = parent[rx];
+            while (parent[ry] != ry) ry = parent[ry];
+            mismatch += uf_same_set(uf, x, x - 1) != (rx == ry);
+        }
+        if (mismatch) {
+            printf("Test failed: %d same_set answers differ after batch %d.\n", mismatch, b);
+            return 0;
+        }
+    }
+    printf("Test passed: %d edges streamed in %d batches on %d threads, %.1f M unites/s, %ld sets.\n",
+           NUM_EDGES, STREAM_BATCHES, omp_get_max_threads(), NUM_EDGES / seconds / 1e6, sets);
+    free(parent);
+    uf_destroy(uf);
+    return 1;
+}
+
+// Threads unite and query at the same time. Queries only ever ask about pairs
+// joined before the parallel phase or pairs that can never be joined, so the
+// answers are fixed while the forest changes underneath them.
+int test_concurrent_queries(const UF_Edge* edges) {
+    UnionFind* uf = uf_create(NUM_ELEMENTS);
+    // Even and odd elements stay apart: every edge below joins equal parities
+    for (int32_t x = 2; x < 1000; x++) {
+        uf_unite(uf, x, x - 2);
+    }
+    int wrong = 0;
+    #pragma omp parallel for schedule(dynamic, 1024) reduction(+:wrong)
+    for (int i = 0; i < NUM_EDGES; i++) {
+        int32_t u = edges[i].u;
+        uf_unite(uf, u, edges[i].v ^ ((u ^ edges[i].v) & 1)); // v with u's parity
+        int32_t q = i % 998;
+        wrong += !uf_same_set(uf, q, q + 2);
+        wrong += uf_same_set(uf, q, q + 1);
+    }
+    // Both parities must have collapsed into exactly one set each for 0..999
+    for (int32_t x = 0; x + 2 < 1000; x++) {
+        wrong += !uf_same_set(uf, x, x + 2) || uf_same_set(uf, x, x + 1);
+    }
+    if (wrong) {
+        printf("Test failed: %d wrong answers under concurrent unites.\n", wrong);
+        return 0;
+    }
+    printf("Test passed: same_set stays consistent during concurrent unites.\n");
+    uf_destroy(uf);
+    return 1;
+}
+
+int main() {
+    UF_Edge* edges = random_edges(42);
+    int ok = test_streaming(edges) && test_concurrent_queries(edges);
+    free(edges);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Compile with: gcc -O3 -fopenmp union_find.c union_find_test.c -o union_find
+// Run with: OMP_NUM_THREADS=8 ./union_find
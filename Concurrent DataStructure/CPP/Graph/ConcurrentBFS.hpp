@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// ConcurrentBFS.hpp
+
+#ifndef CONCURRENT_BFS_HPP
+#define CONCURRENT_BFS_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "CSRGraph.hpp"
+
+struct BFSResult {
+    std::vector<int32_t> distance; // Hops from the source, -1 if unreachable
+    std::vector<int32_t> parent;   // BFS tree parent, the source is its own parent, -1 if unreachable
+};
+
+// Level-synchronous, direction-optimizing BFS (Beamer et al.). Every level is
+// expanded by all threads together and separated by barriers, so no lock is
+// taken per vertex:
+//   top-down:  frontier vertices claim unvisited neighbors with a CAS on
+//              parent and append them to a per-thread buffer; the buffers are
+//              concatenated into the next frontier queue.
+//   bottom-up: each unvisited vertex scans its in-neighbors for one in the
+//              frontier bitmap and stops at the first hit; threads own whole
+//              64-bit words of the next bitmap, so it is written without atomics.
+// The search goes bottom-up once the frontier's edges exceed 1/alpha of the
+// edges still unexplored, and back top-down once the frontier shrinks below
+// n/beta vertices.
+class ConcurrentBFS {
+private:
+    static constexpr int64_t alpha = 14;
+    static constexpr int64_t beta = 24;
+    static constexpr int64_t topDownChunk = 64;  // Frontier vertices per claim
+    static constexpr int64_t bottomUpChunk = 16; // Bitmap words per claim
+
+    // Reusable barrier for the threads of one run.
+    class LevelBarrier {
+    public:
+        explicit LevelBarrier(unsigned count) : count(count), waiting(0), generation(0) {}
+
+        void wait() {
+            std::unique_lock<std::mutex> lock(mutex);
+            unsigned gen = generation;
+            if (++waiting == count) {
+                waiting = 0;
+                generation++;
+                cv.notify_all();
+                return;
+            }
+            cv.wait(lock, [this, gen] { return generation != gen; });
+        }
+
+    private:
+        std::mutex mutex;
+        std::condition_variable cv;
+        unsigned count;
+        unsigned waiting;
+        unsigned generation;
+    };
+
+    // Written only by its owner during a step, read by thread 0 between steps.
+    struct alignas(64) ThreadState {
+        std::vector<int32_t> discovered;
+        int64_t edges = 0;  // Sum of the degrees of discovered
+        int64_t offset = 0; // Where discovered lands in the next frontier queue
+    };
+
+    // Shared state of one run; fields written by thread 0 are only read after a barrier.
+    struct Search {
+        std::vector<std::atomic<int32_t>> parent;
+        std::vector<int32_t> distance;
+        std::vector<int32_t> queue;              // Frontier as a list, valid top-down
+        std::vector<std::atomic<uint64_t>> bits; // Frontier as a bitmap, valid bottom-up
+        std::vector<std::atomic<uint64_t>> nextBits;
+        std::vector<ThreadState> threads;
+        std::atomic<int64_t> cursor{0};
+        int64_t frontierSize = 0;
+        int64_t unexploredEdges = 0;
+        int32_t depth = 0;
+        bool bottomUp = false;
+        bool nextBottomUp = false;
+        bool finished = false;
+
+        Search(int32_t n, unsigned numThreads)
+            : parent(n), distance(n), queue(n), bits((n + 63) / 64), nextBits((n + 63) / 64),
+              threads(numThreads) {}
+    };
+
+    // owned only holds storage when built from an adjacency list; graph and
+    // inverse are views. inverse is the transpose used by bottom-up steps.
+    CSRGraph owned;
+    CSRView graph;
+    CSRView inverse;
+    unsigned numThreads;
+
+    void topDownStep(Search& s, ThreadState& self) {
+        int32_t nextDepth = s.depth + 1;
+        for (;;) {
+            int64_t begin = s.cursor.fetch_add(topDownChunk, std::memory_order_relaxed);
+            if (begin >= s.frontierSize) break;
+            int64_t end = std::min(begin + topDownChunk, s.frontierSize);
+            for (int64_t i = begin; i < end; i++) {
+                int32_t u = s.queue[i];
+                for (int32_t v : graph.neighbors(u)) {
+                    int32_t unvisited = -1;
+                    if (s.parent[v].load(std::memory_order_relaxed) == -1 &&
+                        s.parent[v].compare_exchange_strong(unvisited, u, std::memory_order_relaxed)) {
+                        s.distance[v] = nextDepth;
+                        self.discovered.push_back(v);
+                        self.edges += graph.degree(v);
+                    }
+                }
+            }
+        }
+    }
+
+    void bottomUpStep(Search& s, ThreadState& self) {
+        int32_t n = graph.numVertices();
+        int64_t words = (int64_t)s.bits.size();
+        int32_t nextDepth = s.depth + 1;
+        for (;;) {
+            int64_t begin = s.cursor.fetch_add(bottomUpChunk, std::memory_order_relaxed);
+            if (begin >= words) break;
+            int64_t end = std::min(begin + bottomUpChunk, words);
+            for (int64_t w = begin; w < end; w++) {
+                uint64_t word = 0;
+                int32_t last = (int32_t)std::min<int64_t>(n, (w + 1) * 64);
+                for (int32_t v = (int32_t)(w * 64); v < last; v++) {
+                    if (s.parent[v].load(std::memory_order_relaxed) != -1) continue;
+                    for (int32_t u : inverse.neighbors(v)) {
+                        if (s.bits[u >> 6].load(std::memory_order_relaxed) & (1ULL << (u & 63))) {
+                            s.parent[v].store(u, std::memory_order_relaxed);
+                            s.distance[v] = nextDepth;
+                            word |= 1ULL << (v & 63);
+                            self.discovered.push_back(v);
+                            self.edges += graph.degree(v);
+                            break;
+                        }
+                    }
+                }
+                s.nextBits[w].store(word, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Thread 0 only: totals the step, picks the next direction and lays out the next queue.
+    void finishLevel(Search& s) {
+        int64_t nextSize = 0, nextEdges = 0;
+        for (ThreadState& t : s.threads) {
+            t.offset = nextSize;
+            nextSize += (int64_t)t.discovered.size();
+            nextEdges += t.edges;
+        }
+        s.unexploredEdges -= nextEdges;
+        s.depth++;
+        if (nextSize == 0) {
+            s.finished = true;
+        } else if (!s.bottomUp) {
+            s.nextBottomUp = nextEdges > s.unexploredEdges / alpha && nextSize > s.frontierSize;
+        } else {
+            s.nextBottomUp = !(nextSize < graph.numVertices() / beta && nextSize < s.frontierSize);
+        }
+        if (s.bottomUp && s.nextBottomUp) {
+            // The step wrote every word of nextBits, so it is the whole next frontier
+            s.bits.swap(s.nextBits);
+        }
+        s.frontierSize = nextSize;
+        s.cursor.store(0, std::memory_order_relaxed);
+    }
+
+    void worker(Search& s, LevelBarrier& barrier, unsigned tid) {
+        ThreadState& self = s.threads[tid];
+        int64_t words = (int64_t)s.bits.size();
+        while (true) {
+            if (s.bottomUp) {
+                bottomUpStep(s, self);
+            } else {
+                topDownStep(s, self);
+            }
+            barrier.wait();
+            if (tid == 0) finishLevel(s);
+            barrier.wait();
+            if (s.finished) break;
+
+            if (!s.nextBottomUp) {
+                std::copy(self.discovered.begin(), self.discovered.end(), s.queue.begin() + self.offset);
+            } else if (!s.bottomUp) {
+                // Switching to bottom-up: rebuild the bitmap from the discovered lists
+                for (int64_t w = words * tid / numThreads; w < words * (tid + 1) / numThreads; w++) {
+                    s.bits[w].store(0, std::memory_order_relaxed);
+                }
+                barrier.wait();
+                for (int32_t v : self.discovered) {
+                    s.bits[v >> 6].fetch_or(1ULL << (v & 63), std::memory_order_relaxed);
+                }
+            }
+            self.discovered.clear();
+            self.edges = 0;
+            barrier.wait();
+            if (tid == 0) s.bottomUp = s.nextBottomUp;
+            barrier.wait();
+        }
+    }
+
+public:
+    // Bottom-up steps need in-neighbors, so a directed graph must come with its
+    // transpose; an undirected (symmetric) graph is its own transpose.
+    ConcurrentBFS(CSRView graph, unsigned numThreads = 0)
+        : graph(graph), inverse(graph), numThreads(CSRGraph::threadCount(numThreads)) {
+    }
+
+    ConcurrentBFS(CSRView graph, CSRView transpose, unsigned numThreads = 0)
+        : graph(graph), inverse(transpose), numThreads(CSRGraph::threadCount(numThreads)) {
+    }
+
+    ConcurrentBFS(const std::vector<std::vector<int>>& adj, unsigned numThreads = 0)
+        : owned(CSRGraph::fromAdjacencyList(adj)), graph(owned.view()), inverse(owned.view()),
+          numThreads(CSRGraph::threadCount(numThreads)) {
+    }
+
+    // A copy would keep views into the source's owned graph and dangle once
+    // the source is gone. Moving is safe: the moved vectors keep their buffers.
+    ConcurrentBFS(const ConcurrentBFS&) = delete;
+    ConcurrentBFS& operator=(const ConcurrentBFS&) = delete;
+    ConcurrentBFS(ConcurrentBFS&&) = default;
+    ConcurrentBFS& operator=(ConcurrentBFS&&) = default;
+
+    // Function to run the BFS starting from a given node.
+    BFSResult run(int32_t start) {
+        int32_t n = graph.numVertices();
+        Search s(n, numThreads);
+        CSRGraph::parallelFor(0, n, numThreads, [&](int64_t lo, int64_t hi, unsigned) {
+            for (int64_t v = lo; v < hi; v++) {
+                s.parent[v].store(-1, std::memory_order_relaxed);
+                s.distance[v] = -1;
+            }
+        });
+        s.parent[start].store(start, std::memory_order_relaxed);
+        s.distance[start] = 0;
+        s.queue[0] = start;
+        s.frontierSize = 1;
+        s.unexploredEdges = graph.numEdges() - graph.degree(start);
+
+        // The calling thread works as thread 0.
+        LevelBarrier barrier(numThreads);
+        std::vector<std::thread> workers;
+        for (unsigned t = 1; t < numThreads; ++t) {
+            workers.emplace_back(&ConcurrentBFS::worker, this, std::ref(s), std::ref(barrier), t);
+        }
+        worker(s, barrier, 0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        BFSResult result;
+        result.distance = std::move(s.distance);
+        result.parent.resize(n);
+        for (int32_t v = 0; v < n; v++) {
+            result.parent[v] = s.parent[v].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+};
+
+
+// Time Complexity
+// O(V + E) for a purely top-down search, where V is the number of vertices and E is the number of edges.
+// Bottom-up levels scan every unvisited vertex but stop at the first parent found, so on low-diameter
+// (scale-free) graphs they examine only a fraction of E; that is where the direction switch pays off.
+// Each level costs a few barriers, so high-diameter graphs (roads, meshes) pay O(depth) synchronization.
+// Space Complexity
+// O(V + E): For storing the graph in CSR form, shared with the caller rather than copied.
+// O(V): For the parent and distance arrays, the frontier queue and two frontier bitmaps (V/8 bytes each).
+// Optimizations and Efficiency
+// Per-thread discovery buffers: No shared queue or lock on the hot path; buffers are concatenated once per level.
+// Chunked dynamic scheduling: Threads claim 64 frontier vertices or 16 bitmap words at a time to balance skewed degrees.
+// Check before CAS: A relaxed load filters already-visited neighbors so most edges cost no atomic write.
+// Bitmap frontier: Bottom-up membership tests touch V/8 bytes instead of a V-entry array.
+
+#endif // CONCURRENT_BFS_HPP
@@ -17,126 +17,113 @@
  * Email: ih246@cornell.edu
  */
 
+#include <chrono>
 #include <iostream>
-#include <vector>
+#include <memory>
 #include <queue>
-#include <mutex>
-#include <thread>
-#include <atomic>
-#include <condition_variable>
-#include <functional>
-
-class ConcurrentBFS {
-private:
-    // Graph representation and visited flag for each node.
-    std::vector<std::vector<int>> graph;
-    std::vector<std::atomic<bool>> visited;
-    
-    // Queue for BFS and mutex for synchronization.
-    std::queue<int> queue;
-    std::mutex queue_mutex;
-    
-    // Condition variable to manage worker thread synchronization.
-    std::condition_variable cv;
-    
-    // Atomic variables to manage work status and termination condition.
-    std::atomic<int> working;
-    std::atomic<bool> done;
-
-    // Function to process a node and add its neighbors to the queue.
-    void processNode(int node) {
-        for (int neighbor : graph[node]) {
-            // If neighbor not visited, mark as visited and add to queue.
-            if (!visited[neighbor].exchange(true)) {
-                std::lock_guard<std::mutex> guard(queue_mutex);
-                queue.push(neighbor);
-                cv.notify_one();
+#include <random>
+#include <vector>
+#include "ConcurrentBFS.hpp"
+#include "GraphLoader.hpp"
+
+// Plain queue BFS used to check the parallel distances
+std::vector<int32_t> serialDistances(CSRView graph, int32_t start) {
+    std::vector<int32_t> distance(graph.numVertices(), -1);
+    std::queue<int32_t> queue;
+    distance[start] = 0;
+    queue.push(start);
+    while (!queue.empty()) {
+        int32_t u = queue.front();
+        queue.pop();
+        for (int32_t v : graph.neighbors(u)) {
+            if (distance[v] == -1) {
+                distance[v] = distance[u] + 1;
+                queue.push(v);
             }
         }
     }
+    return distance;
+}
 
-    // Worker function run by each thread.
-    void worker() {
-        while (true) {
-            std::unique_lock<std::mutex> lock(queue_mutex);
-            // Wait until work is available or done is signaled.
-            cv.wait(lock, [this] { return !queue.empty() || done; });
-
-            if (queue.empty()) {
-                if (done) break; // Exit loop if no work and done is true.
-                continue;
-            }
-
-            int node = queue.front();
-            queue.pop();
-            working++; // Increment active worker count.
-            lock.unlock();
-
-            processNode(node); // Process the current node.
-
-            lock.lock();
-            working--; // Decrement active worker count.
-            // Signal done if no workers active and no nodes left to process.
-            if (working == 0 && queue.empty()) {
-                done = true;
-                cv.notify_all();
-            }
+// A BFS tree is valid when every reached vertex hangs off a real edge from a vertex one level up
+bool verify(CSRView graph, int32_t start, const BFSResult& result) {
+    if (result.distance != serialDistances(graph, start)) return false;
+    for (int32_t v = 0; v < graph.numVertices(); v++) {
+        int32_t p = result.parent[v];
+        if (result.distance[v] == -1 || v == start) {
+            if (p != (v == start ? start : -1)) return false;
+            continue;
         }
+        if (p < 0 || result.distance[p] != result.distance[v] - 1) return false;
+        bool edge = false;
+        for (int32_t u : graph.neighbors(p)) edge |= (u == v);
+        if (!edge) return false;
     }
+    return true;
+}
 
-public:
-    // Constructor initializing the graph and atomic variables.
-    ConcurrentBFS(const std::vector<std::vector<int>>& graph) 
-        : graph(graph), visited(graph.size()), working(0), done(false) {
+// BFS over a graph file: a text edge list is symmetrized on load, a binary CSR
+// file is mapped as is and must already hold both directions of every edge
+int runOnFile(const std::string& path, int32_t start) {
+    auto t0 = std::chrono::steady_clock::now();
+    CSRGraph owned;
+    std::unique_ptr<MappedCSR> mapped;
+    CSRView graph;
+    if (isBinaryCSR(path)) {
+        mapped.reset(new MappedCSR(path));
+        graph = mapped->view();
+    } else {
+        EdgeListFile file = readEdgeList(path);
+        owned = CSRGraph::fromEdgeList(file.numVertices, file.edges, false, !file.symmetric);
+        graph = owned.view();
     }
-
-    // Function to run the BFS starting from a given node.
-    void run(int start) {
-        std::fill(visited.begin(), visited.end(), false);
-        visited[start] = true;
-        queue.push(start);
-
-        // Create and start worker threads based on hardware concurrency.
-        std::vector<std::thread> workers;
-        int numThreads = std::thread::hardware_concurrency();
-        for (int i = 0; i < numThreads; ++i) {
-            workers.emplace_back(&ConcurrentBFS::worker, this);
-        }
-
-        // Wait for all worker threads to complete.
-        for (auto& worker : workers) {
-            worker.join();
-        }
+    if (start < 0 || start >= graph.numVertices()) {
+        std::cerr << "source " << start << " is not a vertex of " << path << std::endl;
+        return 1;
     }
-};
-
-
-// Time Complexity
-// O(V + E): Where V is the number of vertices and E is the number of edges in the graph.
-// The concurrent nature of the algorithm aims to speed up the processing by utilizing multiple cores. However, the worst-case time complexity remains O(V + E) because every vertex and edge is processed once.
-// Space Complexity
-// O(V + E): For storing the graph.
-// O(V): For the visited array.
-// O(V): Maximum size of the queue.
-// Total: O(V + E) + O(V) + O(V) ≈ O(V + E), assuming the graph storage dominates.
-// Optimizations and Efficiency
-// Concurrency: Utilizes multiple threads for parallel processing.
-// Dynamic Thread Allocation: Adapts the number of threads to the system's capabilities.
-// Atomic Operations: Reduces the overhead of locking for visited checks.
-// Condition Variables: Efficient thread synchronization, reducing idle time.
-// Reduced Lock Contention: Minimizes the duration for which locks are held.
+    auto t1 = std::chrono::steady_clock::now();
+    BFSResult result = ConcurrentBFS(graph).run(start);
+    auto t2 = std::chrono::steady_clock::now();
+    int64_t reached = 0;
+    for (int32_t d : result.distance) reached += d >= 0;
+    std::cout << path << ": " << graph.numVertices() << " vertices, " << graph.numEdges() << " edges, loaded in "
+              << std::chrono::duration<double>(t1 - t0).count() << " s; BFS from " << start << " reached "
+              << reached << " in " << std::chrono::duration<double>(t2 - t1).count() << " s" << std::endl;
+    return 0;
+}
 
 // Example usage
-int main() {
-    std::vector<std::vector<int>> graph = {
-        {1, 2},
-        {0, 3},
-        {0, 3},
-        {1, 2}
-    };
+int main(int argc, char** argv) {
+    if (argc >= 2) return runOnFile(argv[1], argc >= 3 ? std::atoi(argv[2]) : 0);
+
+    std::vector<CSREdge> edges = {{0, 1, 0}, {0, 2, 0}, {1, 3, 0}, {2, 3, 0}};
+    CSRGraph graph = CSRGraph::fromEdgeList(4, edges, false, true);
 
     ConcurrentBFS bfs(graph);
-    bfs.run(0); // Start BFS from node 0
+    BFSResult result = bfs.run(0); // Start BFS from node 0
+    for (int32_t v = 0; v < graph.numVertices(); v++) {
+        std::cout << "Vertex " << v << ": distance " << result.distance[v]
+                  << ", parent " << result.parent[v] << std::endl;
+    }
+
+    // Skewed random graph: a few hubs make the frontier dense enough to go bottom-up
+    const int32_t n = 1 << 16;
+    std::mt19937 rng(42);
+    std::vector<CSREdge> randomEdges;
+    for (int32_t i = 0; i < 8 * n; i++) {
+        int32_t src = (int32_t)(rng() % n);
+        int32_t dst = (i % 4 == 0) ? (int32_t)(rng() % 64) : (int32_t)(rng() % n);
+        randomEdges.push_back({src, dst, 0});
+    }
+    CSRGraph random = CSRGraph::fromEdgeList(n, randomEdges, false, true);
+    for (unsigned threads : {1u, 4u, 8u}) {
+        BFSResult r = ConcurrentBFS(random, threads).run(7);
+        std::cout << (verify(random, 7, r) ? "Test passed" : "Test failed")
+                  << ": random graph with " << threads << " threads" << std::endl;
+    }
 
     return 0;
 }
+
+// Compile with: g++ -std=c++17 -O3 Concurrent_BFS.cpp -o concurrent_bfs -pthread
+// Run with: ./concurrent_bfs [graph.txt|graph.mtx|graph.csr [source]]
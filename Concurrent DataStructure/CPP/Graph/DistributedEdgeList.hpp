@@ -0,0 +1,162 @@
+// DistributedEdgeList.hpp
+// Partitioned loading for the MPI graph codes. Every rank parses its own byte
+// range of an edge-list file, then the edges are shipped to whichever rank owns
+// them with one MPI_Alltoallv, so no rank ever holds the whole graph.
+//
+// File format: one edge "src dst [weight]" per line, vertex ids from 0. Lines
+// starting with '#' or '%' are comments (SNAP headers). The vertex count is one
+// more than the largest id seen.
+#ifndef DISTRIBUTED_EDGE_LIST_HPP
+#define DISTRIBUTED_EDGE_LIST_HPP
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mpi.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CSRGraph.hpp"
+
+struct EdgeSlice {
+  std::vector<CSREdge> edges; // Edges parsed by this rank, not yet redistributed
+  int32_t numVertices;        // Global vertex count, same on every rank
+};
+
+inline MPI_Datatype csrEdgeType() {
+  static MPI_Datatype type = MPI_DATATYPE_NULL;
+  if (type == MPI_DATATYPE_NULL) {
+    MPI_Type_contiguous(3, MPI_INT32_T, &type);
+    MPI_Type_commit(&type);
+  }
+  return type;
+}
+
+// Rank r parses the lines that start in bytes [size*r/P, size*(r+1)/P).
+inline EdgeSlice readEdgeSlice(const std::string &path, MPI_Comm comm) {
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    std::perror(("cannot open " + path).c_str());
+    MPI_Abort(comm, EXIT_FAILURE);
+  }
+  in.seekg(0, std::ios::end);
+  long long bytes = in.tellg();
+  long long begin = bytes * rank / size;
+  long long end = bytes * (rank + 1) / size;
+
+  // A line belongs to the rank whose range holds its first byte
+  in.seekg(begin > 0 ? begin - 1 : 0);
+  std::string line;
+  if (begin > 0 && in.get() != '\n') {
+    std::getline(in, line);
+  }
+
+  EdgeSlice slice;
+  int32_t maxId = -1;
+  while (in.tellg() < end && std::getline(in, line)) {
+    if (line.empty() || line[0] == '#' || line[0] == '%') {
+      continue;
+    }
+    char *cursor = &line[0];
+    char *next;
+    long src = std::strtol(cursor, &next, 10);
+    if (next == cursor) {
+      continue;
+    }
+    cursor = next;
+    long dst = std::strtol(cursor, &next, 10);
+    if (next == cursor) {
+      continue;
+    }
+    cursor = next;
+    long weight = std::strtol(cursor, &next, 10);
+    if (next == cursor) {
+      weight = 1;
+    }
+    slice.edges.push_back({(int32_t)src, (int32_t)dst, (int32_t)weight});
+    maxId = std::max(maxId, (int32_t)std::max(src, dst));
+  }
+
+  MPI_Allreduce(&maxId, &slice.numVertices, 1, MPI_INT32_T, MPI_MAX, comm);
+  slice.numVertices++;
+  return slice;
+}
+
+// Sends every edge to rank owner(edge) and returns the edges this rank received.
+template <typename Owner>
+std::vector<CSREdge> redistributeEdges(const std::vector<CSREdge> &edges,
+                                       Owner owner, MPI_Comm comm) {
+  int size;
+  MPI_Comm_size(comm, &size);
+
+  std::vector<int> sendCounts(size, 0), recvCounts(size);
+  for (const CSREdge &e : edges) {
+    sendCounts[owner(e)]++;
+  }
+  std::vector<int> sendDispls(size, 0), recvDispls(size, 0);
+  for (int p = 1; p < size; p++) {
+    sendDispls[p] = sendDispls[p - 1] + sendCounts[p - 1];
+  }
+  std::vector<CSREdge> sendBuf(edges.size());
+  std::vector<int> cursor(sendDispls);
+  for (const CSREdge &e : edges) {
+    sendBuf[cursor[owner(e)]++] = e;
+  }
+
+  MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT,
+               comm);
+  for (int p = 1; p < size; p++) {
+    recvDispls[p] = recvDispls[p - 1] + recvCounts[p - 1];
+  }
+  std::vector<CSREdge> received(recvDispls[size - 1] + recvCounts[size - 1]);
+  MPI_Alltoallv(sendBuf.data(), sendCounts.data(), sendDispls.data(),
+                csrEdgeType(), received.data(), recvCounts.data(),
+                recvDispls.data(), csrEdgeType(), comm);
+  return received;
+}
+
+// Local CSR over rows [0, numRows) whose neighbor entries keep whatever ids the
+// caller stored in dst (usually global ids, so they are not range checked).
+inline CSRGraph buildLocalCSR(int32_t numRows, const std::vector<CSREdge> &edges,
+                              int32_t rowBase) {
+  std::vector<int64_t> offsets(numRows + 1, 0);
+  for (const CSREdge &e : edges) {
+    offsets[e.src - rowBase + 1]++;
+  }
+  for (int32_t r = 0; r < numRows; r++) {
+    offsets[r + 1] += offsets[r];
+  }
+  std::vector<int32_t> neighbors(edges.size());
+  std::vector<int64_t> cursor(offsets.begin(), offsets.end() - 1);
+  for (const CSREdge &e : edges) {
+    neighbors[cursor[e.src - rowBase]++] = e.dst;
+  }
+  for (int32_t r = 0; r < numRows; r++) {
+    std::sort(neighbors.begin() + offsets[r], neighbors.begin() + offsets[r + 1]);
+  }
+  return CSRGraph(std::move(offsets), std::move(neighbors));
+}
+
+// Test input: numEdges random edges over numVertices, written by one rank.
+inline void writeRandomEdgeFile(const std::string &path, int32_t numVertices,
+                                int64_t numEdges, unsigned seed) {
+  std::ofstream out(path);
+  if (!out) {
+    std::perror(("cannot create " + path).c_str());
+    std::exit(EXIT_FAILURE);
+  }
+  std::mt19937 rng(seed);
+  out << "# random graph: " << numVertices << " vertices, " << numEdges
+      << " edges\n";
+  for (int64_t i = 0; i < numEdges; i++) {
+    out << rng() % numVertices << ' ' << rng() % numVertices << '\n';
+  }
+}
+
+#endif // DISTRIBUTED_EDGE_LIST_HPP
@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// GraphLoader.hpp
+// Reading graphs from disk instead of building them in main().
+//   - Text edge lists, SNAP style ("src dst [weight]" per line, '#' or '%'
+//     comments, 0-based ids) or Matrix Market coordinate files (1-based,
+//     pattern/integer/real, general or symmetric). The file is mmap'd and cut
+//     into one byte range per thread; each thread parses the lines that start
+//     in its range, so parsing scales with cores instead of being bound to one
+//     ifstream.
+//   - A binary CSR file: a 32-byte header, then offsets, neighbors and
+//     weights exactly as CSRView expects them. MappedCSR maps it read-only and
+//     points a CSRView into the mapping, so loading costs one mmap call and the
+//     pages are shared through the page cache by every process that maps the
+//     same file. The format is native-endian; the version field rejects files
+//     written on a machine of the other byte order.
+
+#ifndef GRAPH_LOADER_HPP
+#define GRAPH_LOADER_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "CSRGraph.hpp"
+
+struct EdgeListFile {
+    int32_t numVertices = 0;
+    std::vector<CSREdge> edges;
+    bool weighted = false;  // Weights were read; real weights are rounded to int32
+    bool symmetric = false; // Matrix Market symmetric: edges already hold both directions
+};
+
+struct BinaryCSRHeader {
+    char magic[8];     // "CSRGRAPH"
+    uint32_t version;  // binaryCSRVersion
+    uint32_t flags;    // binaryCSRWeighted
+    int64_t numVertices;
+    int64_t numEdges;
+};
+static_assert(sizeof(BinaryCSRHeader) == 32, "offsets must start 8-byte aligned");
+
+constexpr uint32_t binaryCSRVersion = 1;
+constexpr uint32_t binaryCSRWeighted = 1;
+
+namespace graph_loader_detail {
+
+inline std::runtime_error systemError(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+// Read-only mapping of a whole file, unmapped on destruction
+class FileMapping {
+public:
+    explicit FileMapping(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw systemError("cannot open", path);
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw systemError("cannot stat", path);
+        }
+        length = (size_t)st.st_size;
+        if (length > 0) {
+            void* p = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw systemError("cannot mmap", path);
+            }
+            base = (const char*)p;
+        }
+        ::close(fd); // The mapping keeps the file referenced
+    }
+    ~FileMapping() {
+        if (base) ::munmap((void*)base, length);
+    }
+    FileMapping(FileMapping&& other) noexcept : base(other.base), length(other.length) {
+        other.base = nullptr;
+        other.length = 0;
+    }
+    FileMapping(const FileMapping&) = delete;
+    FileMapping& operator=(const FileMapping&) = delete;
+
+    const char* data() const { return base; }
+    size_t size() const { return length; }
+
+private:
+    const char* base = nullptr;
+    size_t length = 0;
+};
+
+inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r' || c == ','; }
+
+// Parses an unsigned id at p; returns false if there is none
+inline bool parseId(const char*& p, const char* end, int64_t& value) {
+    while (p < end && isBlank(*p)) p++;
+    if (p == end || *p < '0' || *p > '9') return false;
+    int64_t v = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        v = v * 10 + (*p++ - '0');
+        if (v > INT32_MAX + int64_t(1)) return false;
+    }
+    value = v;
+    return true;
+}
+
+// Integer fast path; anything with a fraction or exponent goes through strtod
+// on a NUL-terminated copy, since the mapping has no terminator.
+inline bool parseWeight(const char*& p, const char* end, int32_t& weight) {
+    while (p < end && isBlank(*p)) p++;
+    const char* start = p;
+    bool negative = p < end && *p == '-';
+    if (negative || (p < end && *p == '+')) p++;
+    int64_t v = 0;
+    const char* digits = p;
+    while (p < end && *p >= '0' && *p <= '9' && v <= INT32_MAX) v = v * 10 + (*p++ - '0');
+    if (p < end && (*p == '.' || *p == 'e' || *p == 'E')) {
+        char buf[64];
+        size_t len = 0;
+        while (start + len < end && len < sizeof(buf) - 1 && !isBlank(start[len]) && start[len] != '\n') len++;
+        std::memcpy(buf, start, len);
+        buf[len] = '\0';
+        char* stop;
+        double d = std::strtod(buf, &stop);
+        if (stop == buf) return false;
+        p = start + (stop - buf);
+        weight = (int32_t)std::lround(std::max(std::min(d, (double)INT32_MAX), (double)INT32_MIN));
+        return true;
+    }
+    if (p == digits || v > INT32_MAX) return false;
+    weight = (int32_t)(negative ? -v : v);
+    return true;
+}
+
+inline const char* nextLine(const char* p, const char* end) {
+    const char* nl = (const char*)std::memchr(p, '\n', end - p);
+    return nl ? nl + 1 : end;
+}
+
+inline bool isCommentOrEmpty(const char* p, const char* end) {
+    while (p < end && isBlank(*p)) p++;
+    return p == end || *p == '\n' || *p == '#' || *p == '%';
+}
+
+} // namespace graph_loader_detail
+
+// Parses a SNAP or Matrix Market edge list on numThreads threads (0 = all
+// cores). Throws std::runtime_error naming the first malformed line.
+inline EdgeListFile readEdgeList(const std::string& path, unsigned numThreads = 0) {
+    using namespace graph_loader_detail;
+    FileMapping file(path);
+    const char* text = file.data();
+    const char* end = text + file.size();
+    EdgeListFile result;
+
+    // Header, parsed serially: the banner and size line for Matrix Market,
+    // the first data line's column count for SNAP
+    const char* body = text;
+    int64_t base = 0; // Subtracted from every id
+    bool matrixMarket = file.size() >= 14 && std::memcmp(text, "%%MatrixMarket", 14) == 0;
+    if (matrixMarket) {
+        std::string banner(text, nextLine(text, end));
+        std::transform(banner.begin(), banner.end(), banner.begin(), ::tolower);
+        if (banner.find("coordinate") == std::string::npos || banner.find("complex") != std::string::npos) {
+            throw std::runtime_error(path + ": only real, integer or pattern coordinate matrices are graphs");
+        }
+        result.weighted = banner.find("pattern") == std::string::npos;
+        result.symmetric = banner.find("general") == std::string::npos;
+        body = nextLine(text, end);
+        while (body < end && isCommentOrEmpty(body, end)) body = nextLine(body, end);
+        int64_t rows, cols, entries;
+        const char* p = body;
+        if (!parseId(p, end, rows) || !parseId(p, end, cols) || !parseId(p, end, entries)) {
+            throw std::runtime_error(path + ": missing Matrix Market size line");
+        }
+        result.numVertices = (int32_t)std::max(rows, cols);
+        body = nextLine(body, end);
+        base = 1;
+    } else {
+        const char* line = text;
+        while (line < end && isCommentOrEmpty(line, end)) line = nextLine(line, end);
+        const char* p = line;
+        int64_t u, v;
+        int32_t w;
+        result.weighted = line < end && parseId(p, end, u) && parseId(p, end, v) && parseWeight(p, end, w);
+    }
+
+    // Each thread takes the lines that start inside its chunk of the bytes;
+    // parallelFor hands chunk t to thread t
+    unsigned threads = CSRGraph::threadCount(numThreads);
+    size_t length = end - body;
+    if (length < ((size_t)1 << 20)) threads = 1;
+    std::vector<std::vector<CSREdge>> local(threads);
+    std::vector<int64_t> maxId(threads, -1);
+    std::vector<int64_t> badLine(threads, -1); // Byte offset of the first malformed line
+    CSRGraph::parallelFor(0, (int64_t)length, threads, [&](int64_t lo, int64_t hi, unsigned t) {
+        const char* first = body + lo;
+        const char* last = body + hi;
+        if (first != body && first[-1] != '\n') first = nextLine(first, end);
+        std::vector<CSREdge>& out = local[t];
+        if (last > first) out.reserve((last - first) / 12);
+        for (const char* line = first; line < last; line = nextLine(line, end)) {
+            if (isCommentOrEmpty(line, end)) continue;
+            const char* p = line;
+            int64_t u, v;
+            int32_t w = 0;
+            if (!parseId(p, end, u) || !parseId(p, end, v) || u < base || v < base ||
+                (result.weighted && !parseWeight(p, end, w))) {
+                badLine[t] = line - text;
+                break;
+            }
+            u -= base;
+            v -= base;
+            maxId[t] = std::max(maxId[t], std::max(u, v));
+            out.push_back({(int32_t)u, (int32_t)v, w});
+            if (result.symmetric && u != v) out.push_back({(int32_t)v, (int32_t)u, w});
+        }
+    });
+
+    for (unsigned t = 0; t < threads; t++) {
+        if (badLine[t] >= 0) {
+            const char* line = text + badLine[t];
+            std::string shown(line, std::min(nextLine(line, end), line + 80));
+            while (!shown.empty() && (shown.back() == '\n' || shown.back() == '\r')) shown.pop_back();
+            throw std::runtime_error(path + ": malformed edge line \"" + shown + "\"");
+        }
+    }
+    int64_t largest = *std::max_element(maxId.begin(), maxId.end());
+    if (largest >= INT32_MAX) throw std::runtime_error(path + ": vertex id does not fit in int32");
+    if (matrixMarket && largest >= result.numVertices) {
+        throw std::runtime_error(path + ": entry outside the declared matrix size");
+    }
+    result.numVertices = std::max(result.numVertices, (int32_t)(largest + 1));
+
+    // Concatenate the per-thread pieces in file order
+    std::vector<size_t> start(threads + 1, 0);
+    for (unsigned t = 0; t < threads; t++) start[t + 1] = start[t] + local[t].size();
+    result.edges.resize(start[threads]);
+    CSRGraph::parallelFor(0, (int64_t)length, threads, [&](int64_t, int64_t, unsigned t) {
+        std::copy(local[t].begin(), local[t].end(), result.edges.begin() + start[t]);
+        std::vector<CSREdge>().swap(local[t]);
+    });
+    return result;
+}
+
+// Text edge list straight to CSR
+inline CSRGraph loadEdgeList(const std::string& path, unsigned numThreads = 0) {
+    EdgeListFile file = readEdgeList(path, numThreads);
+    return CSRGraph::fromEdgeList(file.numVertices, file.edges, file.weighted, false, numThreads);
+}
+
+// Writes the header and the three arrays of graph in the layout MappedCSR reads
+inline void writeBinaryCSR(const std::string& path, CSRView graph) {
+    BinaryCSRHeader header;
+    std::memcpy(header.magic, "CSRGRAPH", 8);
+    header.version = binaryCSRVersion;
+    header.flags = graph.hasWeights() ? binaryCSRWeighted : 0;
+    header.numVertices = graph.numVertices();
+    header.numEdges = graph.numEdges();
+
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) throw graph_loader_detail::systemError("cannot create", path);
+    size_t m = (size_t)graph.numEdges();
+    bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1 &&
+              std::fwrite(graph.offsets(), sizeof(int64_t), graph.numVertices() + 1, out) ==
+                  (size_t)graph.numVertices() + 1 &&
+              std::fwrite(graph.neighborData(), sizeof(int32_t), m, out) == m &&
+              (!graph.hasWeights() || std::fwrite(graph.weightData(), sizeof(int32_t), m, out) == m);
+    ok = (std::fclose(out) == 0) && ok;
+    if (!ok) throw graph_loader_detail::systemError("cannot write", path);
+}
+
+// A binary CSR file mapped read-only; view() stays valid while this object lives
+class MappedCSR {
+public:
+    explicit MappedCSR(const std::string& path) : file(path) {
+        const char* base = file.data();
+        if (file.size() < sizeof(BinaryCSRHeader)) throw std::runtime_error(path + ": not a binary CSR file");
+        BinaryCSRHeader header;
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, "CSRGRAPH", 8) != 0 || header.version != binaryCSRVersion) {
+            throw std::runtime_error(path + ": not a binary CSR file of this version and byte order");
+        }
+        bool weighted = header.flags & binaryCSRWeighted;
+        int64_t n = header.numVertices, m = header.numEdges;
+        if (n < 0 || n >= INT32_MAX || m < 0 ||
+            file.size() != sizeof(header) + (size_t)(n + 1) * 8 + (size_t)m * (weighted ? 8 : 4)) {
+            throw std::runtime_error(path + ": truncated or inconsistent binary CSR file");
+        }
+        const int64_t* offsets = (const int64_t*)(base + sizeof(header));
+        const int32_t* neighbors = (const int32_t*)(offsets + n + 1);
+        if (offsets[n] != m) throw std::runtime_error(path + ": offsets do not match the edge count");
+        graph = CSRView((int32_t)n, offsets, neighbors, weighted ? neighbors + m : nullptr);
+    }
+
+    CSRView view() const { return graph; }
+    operator CSRView() const { return graph; }
+
+    // Asks the kernel to start reading the whole file in now instead of
+    // faulting it in page by page during the first traversal
+    void prefetch() const {
+        if (file.size() > 0) ::madvise((void*)file.data(), file.size(), MADV_WILLNEED);
+    }
+
+private:
+    graph_loader_detail::FileMapping file;
+    CSRView graph;
+};
+
+// True if path starts with the binary CSR magic
+inline bool isBinaryCSR(const std::string& path) {
+    char magic[8] = {};
+    std::FILE* in = std::fopen(path.c_str(), "rb");
+    if (!in) return false;
+    bool match = std::fread(magic, 1, 8, in) == 8 && std::memcmp(magic, "CSRGRAPH", 8) == 0;
+    std::fclose(in);
+    return match;
+}
+
+#endif // GRAPH_LOADER_HPP
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// MultiSourceBFS.hpp
+// Bit-parallel multi-source BFS (Then et al., "The More the Merrier", VLDB
+// 2015). Up to 64 * Words searches run at once: every vertex carries three
+// source bitsets, seen (sources that reached it), visit (sources for which it
+// is in the current frontier) and visitNext. One adjacency scan serves every
+// search in the batch:
+//     visitNext[n] |= visit[u] & ~seen[n]   for each edge u -> n
+// Levels alternate between pushing from the frontier (atomic OR into
+// visitNext) and pulling into every unfinished vertex (plain writes, each
+// vertex owned by one thread), picked by how many edges the frontier has.
+
+#ifndef MULTI_SOURCE_BFS_HPP
+#define MULTI_SOURCE_BFS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include <omp.h>
+#include "CSRGraph.hpp"
+
+template <int Words = 1>
+class MultiSourceBFS {
+    static_assert(Words >= 1 && Words <= 8, "MultiSourceBFS supports 64 to 512 sources per batch");
+
+public:
+    static constexpr int maxSources = 64 * Words;
+
+    struct Mask {
+        uint64_t word[Words];
+
+        bool any() const {
+            uint64_t bits = 0;
+            for (int w = 0; w < Words; w++) bits |= word[w];
+            return bits != 0;
+        }
+    };
+
+    struct SourceStats {
+        int64_t reached = 0;     // Vertices reachable from the source, itself included
+        int64_t distanceSum = 0; // Sum of hop distances to them, for closeness
+    };
+
+    // Pull levels scan in-neighbors, so a directed graph needs its transpose;
+    // an undirected (symmetric) graph is its own transpose.
+    explicit MultiSourceBFS(CSRView graph) : graph(graph), inverse(graph) {}
+    MultiSourceBFS(CSRView graph, CSRView transpose) : graph(graph), inverse(transpose) {}
+
+    // Runs one batch of at most maxSources searches. onReach(v, depth, mask) is
+    // called once per (vertex, level) with the sources whose search first
+    // reaches v at that depth; bit i of mask is sources[i]. It runs on several
+    // threads at once, but never twice concurrently for the same vertex.
+    template <typename OnReach>
+    void run(const std::vector<int32_t>& sources, OnReach onReach) {
+        if (sources.size() > (size_t)maxSources) {
+            throw std::invalid_argument("MultiSourceBFS::run: too many sources for one batch");
+        }
+        const int32_t n = graph.numVertices();
+        seen.assign(n, Mask{});
+        visit.assign(n, Mask{});
+        visitNext.assign(n, Mask{});
+        std::vector<std::atomic<bool>> queued(n);
+        for (int32_t v = 0; v < n; v++) queued[v].store(false, std::memory_order_relaxed);
+
+        Mask full{};
+        for (size_t i = 0; i < sources.size(); i++) full.word[i / 64] |= 1ULL << (i % 64);
+
+        std::vector<int32_t> frontier;
+        int64_t frontierEdges = 0;
+        for (size_t i = 0; i < sources.size(); i++) {
+            int32_t s = sources[i];
+            if (!visit[s].any()) frontier.push_back(s);
+            seen[s].word[i / 64] |= 1ULL << (i % 64);
+            visit[s].word[i / 64] |= 1ULL << (i % 64);
+        }
+        for (int32_t s : frontier) onReach(s, 0, visit[s]);
+
+        int maxThreads = omp_get_max_threads();
+        std::vector<std::vector<int32_t>> next(maxThreads);
+        std::vector<int64_t> offsets(maxThreads + 1);
+        int depth = 0;
+        bool pull = false;
+
+        #pragma omp parallel
+        {
+            const int tid = omp_get_thread_num();
+            const int threads = omp_get_num_threads();
+            std::vector<int32_t>& mine = next[tid];
+
+            while (true) {
+                // Expand one level for every search in the batch
+                if (!pull) {
+                    #pragma omp for schedule(dynamic, 64)
+                    for (size_t i = 0; i < frontier.size(); i++) {
+                        int32_t u = frontier[i];
+                        const Mask& from = visit[u];
+                        for (int32_t v : graph.neighbors(u)) {
+                            uint64_t fresh = 0;
+                            for (int w = 0; w < Words; w++) {
+                                uint64_t bits = from.word[w] & ~seen[v].word[w];
+                                if (bits) __atomic_fetch_or(&visitNext[v].word[w], bits, __ATOMIC_RELAXED);
+                                fresh |= bits;
+                            }
+                            if (fresh && !queued[v].exchange(true, std::memory_order_relaxed)) {
+                                mine.push_back(v);
+                            }
+                        }
+                    }
+                } else {
+                    #pragma omp for schedule(dynamic, 1024)
+                    for (int32_t v = 0; v < n; v++) {
+                        Mask missing, gathered{};
+                        bool open = false;
+                        for (int w = 0; w < Words; w++) {
+                            missing.word[w] = full.word[w] & ~seen[v].word[w];
+                            open |= missing.word[w] != 0;
+                        }
+                        if (!open) continue; // Every search already reached v
+                        for (int32_t u : inverse.neighbors(v)) {
+                            for (int w = 0; w < Words; w++) gathered.word[w] |= visit[u].word[w];
+                        }
+                        for (int w = 0; w < Words; w++) gathered.word[w] &= missing.word[w];
+                        if (gathered.any()) {
+                            visitNext[v] = gathered;
+                            mine.push_back(v);
+                        }
+                    }
+                }
+
+                // The old frontier leaves visit before the new one enters
+                #pragma omp for schedule(static)
+                for (size_t i = 0; i < frontier.size(); i++) visit[frontier[i]] = Mask{};
+
+                int64_t edges = 0;
+                for (int32_t v : mine) {
+                    for (int w = 0; w < Words; w++) seen[v].word[w] |= visitNext[v].word[w];
+                    visit[v] = visitNext[v];
+                    visitNext[v] = Mask{};
+                    queued[v].store(false, std::memory_order_relaxed);
+                    onReach(v, depth + 1, visit[v]);
+                    edges += graph.degree(v);
+                }
+                offsets[tid + 1] = (int64_t)mine.size();
+                #pragma omp atomic
+                frontierEdges += edges;
+                #pragma omp barrier
+
+                #pragma omp single
+                {
+                    offsets[0] = 0;
+                    for (int t = 0; t < threads; t++) offsets[t + 1] += offsets[t];
+                    frontier.resize(offsets[threads]);
+                    // Pull once the frontier's edges are a sizeable share of the graph
+                    pull = frontierEdges > graph.numEdges() / pullFraction;
+                    frontierEdges = 0;
+                    depth++;
+                }
+                std::copy(mine.begin(), mine.end(), frontier.begin() + offsets[tid]);
+                mine.clear();
+                #pragma omp barrier
+                if (frontier.empty()) break;
+            }
+        }
+    }
+
+    // Per-source reach counts and distance sums; any number of sources, split
+    // into batches of maxSources.
+    std::vector<SourceStats> closeness(const std::vector<int32_t>& sources) {
+        std::vector<SourceStats> stats(sources.size());
+        int maxThreads = omp_get_max_threads();
+        for (size_t first = 0; first < sources.size(); first += maxSources) {
+            std::vector<int32_t> batch(sources.begin() + first,
+                                       sources.begin() + std::min(sources.size(), first + maxSources));
+            std::vector<std::vector<SourceStats>> local(maxThreads, std::vector<SourceStats>(batch.size()));
+            run(batch, [&](int32_t, int depth, const Mask& mask) {
+                std::vector<SourceStats>& acc = local[omp_get_thread_num()];
+                for (int w = 0; w < Words; w++) {
+                    for (uint64_t bits = mask.word[w]; bits; bits &= bits - 1) {
+                        SourceStats& s = acc[w * 64 + __builtin_ctzll(bits)];
+                        s.reached++;
+                        s.distanceSum += depth;
+                    }
+                }
+            });
+            for (const auto& acc : local) {
+                for (size_t i = 0; i < batch.size(); i++) {
+                    stats[first + i].reached += acc[i].reached;
+                    stats[first + i].distanceSum += acc[i].distanceSum;
+                }
+            }
+        }
+        return stats;
+    }
+
+private:
+    static constexpr int64_t pullFraction = 20;
+
+    CSRView graph;
+    CSRView inverse;
+    std::vector<Mask> seen;
+    std::vector<Mask> visit;
+    std::vector<Mask> visitNext;
+};
+
+#endif // MULTI_SOURCE_BFS_HPP
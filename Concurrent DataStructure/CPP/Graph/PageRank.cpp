@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "GraphLoader.hpp"
+#include "PageRank.hpp"
+
+// Textbook power iteration on plain loops, one thread, as the reference
+std::vector<double> serialPageRank(const CSRGraph& graph, const PageRankOptions& options) {
+    const int32_t n = graph.numVertices();
+    std::vector<double> rank(n, 1.0 / n), next(n);
+    for (int it = 0; it < options.maxIterations; it++) {
+        double dangling = 0;
+        for (int32_t u = 0; u < n; u++) {
+            if (graph.degree(u) == 0) dangling += rank[u];
+        }
+        std::fill(next.begin(), next.end(), (1.0 - options.damping) / n + options.damping * dangling / n);
+        for (int32_t u = 0; u < n; u++) {
+            for (int32_t v : graph.neighbors(u)) next[v] += options.damping * rank[u] / graph.degree(u);
+        }
+        double error = 0;
+        for (int32_t v = 0; v < n; v++) error += std::fabs(next[v] - rank[v]);
+        rank.swap(next);
+        if (error < options.tolerance) break;
+    }
+    return rank;
+}
+
+template <typename Real>
+double distance(const std::vector<Real>& a, const std::vector<double>& b) {
+    double sum = 0;
+    for (size_t i = 0; i < b.size(); i++) sum += std::fabs((double)a[i] - b[i]);
+    return sum;
+}
+
+template <typename Run>
+double timed(Run run) {
+    auto t0 = std::chrono::steady_clock::now();
+    run();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Directed graph with skewed in-degrees and about 5% dangling vertices
+CSRGraph randomGraph(int32_t n, int edgesPerVertex) {
+    std::mt19937 rng(11);
+    std::vector<CSREdge> edges;
+    for (int32_t u = 0; u < n; u++) {
+        if (rng() % 20 == 0) continue;
+        for (int k = 0; k < edgesPerVertex; k++) {
+            uint32_t r = rng() % n;
+            int32_t v = (int32_t)(k % 2 ? r : (uint64_t)r * r / n / 4); // Half the edges favour low ids
+            edges.push_back({u, v, 0});
+        }
+    }
+    return CSRGraph::fromEdgeList(n, edges);
+}
+
+int main(int argc, char** argv) {
+    // Example: a 4-vertex graph where vertex 3 has no out-edges
+    std::vector<CSREdge> small = {{0, 1, 0}, {0, 2, 0}, {1, 2, 0}, {2, 0, 0}, {2, 3, 0}};
+    CSRGraph example = CSRGraph::fromEdgeList(4, small);
+    PageRankResult<double> ranks = pageRankPull<double>(example, CSRGraph::transposeOf(example));
+    for (int32_t v = 0; v < 4; v++) std::cout << "Vertex " << v << ": rank " << ranks.rank[v] << std::endl;
+
+    CSRGraph graph = argc >= 2 ? loadEdgeList(argv[1]) : randomGraph(1 << 20, 16);
+    CSRGraph transpose = CSRGraph::transposeOf(graph);
+    const int32_t n = graph.numVertices();
+    std::cout << n << " vertices, " << graph.numEdges() << " edges, " << omp_get_max_threads() << " threads"
+              << std::endl;
+
+    PageRankOptions options;
+    options.tolerance = 1e-7;
+    std::vector<double> expected;
+    double serial = timed([&] { expected = serialPageRank(graph, options); });
+
+    PageRankResult<double> pull;
+    PageRankResult<float> pullFloat;
+    PageRankResult<double> push;
+    double pullTime = timed([&] { pull = pageRankPull<double>(graph, transpose, options); });
+    double floatTime = timed([&] { pullFloat = pageRankPull<float>(graph, transpose, options); });
+    double pushTime = timed([&] { push = pageRankPush<double>(graph, options); });
+
+    // Bytes one pull iteration must move at minimum: the in-edge arrays once,
+    // one contribution per edge, and the per-vertex vectors
+    auto bandwidth = [&](size_t real, int iterations, double seconds) {
+        double bytes = (double)graph.numEdges() * (4 + real) + (double)n * (8 + 8 + 4 * real);
+        return bytes * iterations / seconds / 1e9;
+    };
+    bool ok = true;
+    auto report = [&](const char* name, double error, double bound, int iterations, double seconds, double gbs) {
+        ok &= error < bound;
+        std::cout << (error < bound ? "Test passed" : "Test failed") << ": " << name << " L1 error " << error
+                  << ", " << iterations << " iterations in " << seconds << " s";
+        if (gbs > 0) std::cout << " (" << gbs << " GB/s effective)";
+        std::cout << std::endl;
+    };
+    std::cout << "Serial reference: " << serial << " s" << std::endl;
+    report("pull double", distance(pull.rank, expected), 1e-6, pull.iterations, pullTime,
+           bandwidth(8, pull.iterations, pullTime));
+    report("pull float", distance(pullFloat.rank, expected), 1e-3, pullFloat.iterations, floatTime,
+           bandwidth(4, pullFloat.iterations, floatTime));
+    report("push blocked", distance(push.rank, expected), 1e-6, push.iterations, pushTime, 0);
+
+    // Called from inside a parallel region the nested team has one thread,
+    // which must still fill and add up every source part's bins
+    CSRGraph smallGraph = randomGraph(1 << 12, 8);
+    options.binWidth = 256;
+    PageRankResult<double> nested;
+    #pragma omp parallel num_threads(2)
+    #pragma omp single
+    nested = pageRankPush<double>(smallGraph, options);
+    report("push blocked, nested", distance(nested.rank, serialPageRank(smallGraph, options)), 1e-6,
+           nested.iterations, 0, 0);
+    return ok ? 0 : 1;
+}
+
+// Compile with: g++ -std=c++17 -O3 -march=native -fopenmp PageRank.cpp -o pagerank -pthread
+// Run with: ./pagerank [edge-list.txt]
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// PageRank.hpp
+// PageRank by power iteration, plus the sparse matrix-vector product it is
+// built on. Each iteration is one SpMV over the graph, whose cost is almost
+// entirely memory traffic, so the two variants differ in how they touch memory:
+//   pull: rank[v] is a sum over v's in-neighbors, read from the transpose.
+//         Every thread owns whole rows, so there are no atomics. The edge
+//         arrays stream sequentially; the random part is one read of
+//         contribution[u] per edge.
+//   push with propagation blocking (Beamer, Asanovic and Patterson, IPDPS
+//         2017): each source appends its contribution to the bin of the
+//         destination's id range, then each bin is added up on its own. The
+//         bin's slice of sums fits in cache, so scattered writes never miss,
+//         and the bins themselves are written and read sequentially. The
+//         destination ids of every bin are fixed by the graph, so they are
+//         recorded once and later iterations write only the values.
+// Real selects float or double ranks; float halves the bytes of the
+// per-edge contribution reads. The convergence error is always summed in
+// double.
+
+#ifndef PAGE_RANK_HPP
+#define PAGE_RANK_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <omp.h>
+#include "CSRGraph.hpp"
+
+struct PageRankOptions {
+    double damping = 0.85;
+    double tolerance = 1e-6; // Stop once the L1 change of the rank vector drops below this
+    int maxIterations = 100;
+    int32_t binWidth = 1 << 16; // Destinations per propagation bin; its sums slice should fit in L2
+};
+
+template <typename Real>
+struct PageRankResult {
+    std::vector<Real> rank; // Sums to 1
+    int iterations = 0;
+    double error = 0;       // L1 change in the last iteration
+};
+
+// y[v] = sum of weight(v, u) * x[u] over the row of v, weights 1 when the
+// graph has none. Rows are claimed in chunks so skewed degrees balance out.
+template <typename Real>
+void spmv(CSRView matrix, const Real* x, Real* y) {
+    const int64_t* offsets = matrix.offsets();
+    const int32_t* columns = matrix.neighborData();
+    const int32_t* weights = matrix.weightData();
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (int32_t v = 0; v < matrix.numVertices(); v++) {
+        Real sum = 0;
+        if (weights) {
+            for (int64_t i = offsets[v]; i < offsets[v + 1]; i++) sum += (Real)weights[i] * x[columns[i]];
+        } else {
+            for (int64_t i = offsets[v]; i < offsets[v + 1]; i++) sum += x[columns[i]];
+        }
+        y[v] = sum;
+    }
+}
+
+namespace page_rank_detail {
+
+// contribution[u] = rank[u] / outDegree(u); returns the rank held by dangling
+// vertices, which is spread evenly over every vertex
+template <typename Real>
+double contributions(CSRView graph, const std::vector<Real>& rank, std::vector<Real>& contribution) {
+    double dangling = 0;
+    #pragma omp parallel for schedule(static) reduction(+:dangling)
+    for (int32_t u = 0; u < graph.numVertices(); u++) {
+        int64_t degree = graph.degree(u);
+        contribution[u] = degree ? rank[u] / (Real)degree : 0;
+        if (!degree) dangling += rank[u];
+    }
+    return dangling;
+}
+
+// rank = (1 - d) / n + d * (sums + dangling / n); returns the L1 change
+template <typename Real>
+double applyDamping(const PageRankOptions& options, double dangling, const std::vector<Real>& sums,
+                    std::vector<Real>& rank) {
+    const int32_t n = (int32_t)rank.size();
+    const Real base = (Real)((1.0 - options.damping) / n + options.damping * dangling / n);
+    const Real damping = (Real)options.damping;
+    double error = 0;
+    #pragma omp parallel for schedule(static) reduction(+:error)
+    for (int32_t v = 0; v < n; v++) {
+        Real next = base + damping * sums[v];
+        error += std::fabs((double)next - (double)rank[v]);
+        rank[v] = next;
+    }
+    return error;
+}
+
+} // namespace page_rank_detail
+
+// Pull PageRank. transpose holds the in-edges; for an undirected (symmetric)
+// graph pass the graph itself. Edge weights are ignored.
+template <typename Real = double>
+PageRankResult<Real> pageRankPull(CSRView graph, CSRView transpose, const PageRankOptions& options = {}) {
+    const int32_t n = graph.numVertices();
+    PageRankResult<Real> result;
+    result.rank.assign(n, n ? (Real)1 / n : 0);
+    std::vector<Real> contribution(n), sums(n);
+    CSRView inEdges(n, transpose.offsets(), transpose.neighborData()); // Unweighted SpMV
+    while (n && result.iterations < options.maxIterations) {
+        double dangling = page_rank_detail::contributions(graph, result.rank, contribution);
+        spmv(inEdges, contribution.data(), sums.data());
+        result.error = page_rank_detail::applyDamping(options, dangling, sums, result.rank);
+        result.iterations++;
+        if (result.error < options.tolerance) break;
+    }
+    return result;
+}
+
+// Push PageRank with propagation blocking; needs only the out-edges
+template <typename Real = double>
+PageRankResult<Real> pageRankPush(CSRView graph, const PageRankOptions& options = {}) {
+    const int32_t n = graph.numVertices();
+    const int32_t width = options.binWidth > 0 ? options.binWidth : 1 << 16;
+    const int numBins = n ? (int)((n + (int64_t)width - 1) / width) : 0;
+    const int threads = omp_get_max_threads();
+    PageRankResult<Real> result;
+    result.rank.assign(n, n ? (Real)1 / n : 0);
+    std::vector<Real> contribution(n), sums(n);
+
+    // bins[p * numBins + b]: the (destination, value) pairs that source part p
+    // produces for bin b. Sources are split into a fixed set of parts, each
+    // appended to in the same order every iteration, so the destinations are
+    // recorded only once. A team may come up short (nested regions,
+    // OMP_THREAD_LIMIT), so threads take parts by stride rather than by id.
+    const int parts = threads;
+    auto partBegin = [&](int p) { return (int32_t)((int64_t)n * p / parts); };
+    std::vector<std::vector<int32_t>> destinations(parts * numBins);
+    std::vector<std::vector<Real>> values(parts * numBins);
+    #pragma omp parallel num_threads(threads)
+    for (int p = omp_get_thread_num(); p < parts; p += omp_get_num_threads()) {
+        for (int32_t u = partBegin(p); u < partBegin(p + 1); u++) {
+            for (int32_t v : graph.neighbors(u)) destinations[p * numBins + v / width].push_back(v);
+        }
+        for (int b = 0; b < numBins; b++) values[p * numBins + b].resize(destinations[p * numBins + b].size());
+    }
+
+    std::vector<size_t> fill(parts * numBins);
+    while (n && result.iterations < options.maxIterations) {
+        double dangling = page_rank_detail::contributions(graph, result.rank, contribution);
+        #pragma omp parallel num_threads(threads)
+        {
+            // Binning: sequential writes into each part's bins
+            for (int p = omp_get_thread_num(); p < parts; p += omp_get_num_threads()) {
+                size_t* cursor = &fill[p * numBins];
+                for (int b = 0; b < numBins; b++) cursor[b] = 0;
+                for (int32_t u = partBegin(p); u < partBegin(p + 1); u++) {
+                    Real c = contribution[u];
+                    for (int32_t v : graph.neighbors(u)) {
+                        int b = v / width;
+                        values[p * numBins + b][cursor[b]++] = c;
+                    }
+                }
+            }
+            #pragma omp barrier
+            // Accumulate: one bin per thread at a time, so its slice of sums stays in cache
+            #pragma omp for schedule(dynamic, 1)
+            for (int b = 0; b < numBins; b++) {
+                int32_t first = b * width, last = (int32_t)std::min<int64_t>((int64_t)first + width, n);
+                for (int32_t v = first; v < last; v++) sums[v] = 0;
+                for (int p = 0; p < parts; p++) {
+                    const std::vector<int32_t>& dst = destinations[p * numBins + b];
+                    const std::vector<Real>& val = values[p * numBins + b];
+                    for (size_t i = 0; i < dst.size(); i++) sums[dst[i]] += val[i];
+                }
+            }
+        }
+        result.error = page_rank_detail::applyDamping(options, dangling, sums, result.rank);
+        result.iterations++;
+        if (result.error < options.tolerance) break;
+    }
+    return result;
+}
+
+#endif // PAGE_RANK_HPP
@@ -1,61 +1,209 @@
 // Distributed BFS with 1-D Partitioning
 // ref :https://en.wikipedia.org/wiki/Parallel_breadth-first_search
+//
+// Vertices are dealt out in contiguous blocks: rank r owns
+// [r * block, (r + 1) * block) and stores the out-edges of those vertices as a
+// local CSR (rows are local, neighbor ids stay global). Each level a rank only
+// expands its own frontier. Neighbors it owns are settled locally; the rest are
+// batched per owner as (vertex, parent) pairs and delivered with one
+// MPI_Alltoallv, so every edge crosses the network at most once per BFS
+// instead of shipping the whole level array every level.
 #include <algorithm>
+#include <chrono>
 #include <iostream>
-#include <limits>
 #include <mpi.h>
+#include <queue>
+#include <string>
 #include <vector>
 
-std::vector<int> graph[] = {
-    {1, 2},    // Neighbors of vertex 0
-    {0, 3, 4}, // Neighbors of vertex 1
-    {0, 5},    // Neighbors of vertex 2
-    {1, 6},    // Neighbors of vertex 3
-    {1, 6, 7}, // Neighbors of vertex 4
-    {2, 7},    // Neighbors of vertex 5
-    {3, 4},    // Neighbors of vertex 6
-    {4, 5}     // Neighbors of vertex 7
+#include "CSRGraph.hpp"
+#include "DistributedEdgeList.hpp"
+
+struct Partition1D {
+  int32_t numVertices;
+  int32_t block; // Vertices per rank, the last rank may own fewer
+  int rank;
+  int size;
+
+  int owner(int32_t v) const { return v / block; }
+  int32_t first() const { return std::min(numVertices, rank * block); }
+  int32_t count() const {
+    return std::min(numVertices, (rank + 1) * block) - first();
+  }
 };
 
-void distributed_bfs(int start_vertex, std::vector<int> &levels, int rank,
-                     int world_size) {
-  int num_vertices = sizeof(graph) / sizeof(graph[0]);
-  std::vector<int> local_levels(num_vertices, std::numeric_limits<int>::max());
-  // Initialize local BFS levels
-  local_levels[start_vertex] = 0;
-  std::vector<int> level_changes(num_vertices, 0);
-
-  // Main BFS loop
-  bool changed;
-  do {
-    changed = false;
-    fill(level_changes.begin(), level_changes.end(), 0);
-    // Check each vertex to see if it is at the current level.
-    for (int vertex = 0; vertex < num_vertices; ++vertex) {
-      if (local_levels[vertex] == std::numeric_limits<int>::max()) {
-        continue; // Skip vertices that are not yet reached.
-      }
-      for (int neighbor : graph[vertex]) {
-        if (local_levels[neighbor] == std::numeric_limits<int>::max()) {
-          level_changes[neighbor] = local_levels[vertex] + 1;
-          changed = true;
+struct DistributedGraph {
+  Partition1D part;
+  CSRGraph local; // Row i is global vertex part.first() + i
+};
+
+// Loads an undirected graph: each rank parses a slice of the file and every
+// edge {u, v} is sent to owner(u) as u->v and to owner(v) as v->u.
+DistributedGraph loadPartitioned(const std::string &path, MPI_Comm comm) {
+  EdgeSlice slice = readEdgeSlice(path, comm);
+  DistributedGraph g;
+  MPI_Comm_rank(comm, &g.part.rank);
+  MPI_Comm_size(comm, &g.part.size);
+  g.part.numVertices = slice.numVertices;
+  g.part.block = (slice.numVertices + g.part.size - 1) / g.part.size;
+
+  std::vector<CSREdge> both;
+  both.reserve(slice.edges.size() * 2);
+  for (const CSREdge &e : slice.edges) {
+    both.push_back(e);
+    if (e.src != e.dst) {
+      both.push_back({e.dst, e.src, e.weight});
+    }
+  }
+  slice.edges.clear();
+  slice.edges.shrink_to_fit();
+
+  const Partition1D &part = g.part;
+  std::vector<CSREdge> mine = redistributeEdges(
+      both, [&part](const CSREdge &e) { return part.owner(e.src); }, comm);
+  g.local = buildLocalCSR(part.count(), mine, part.first());
+  return g;
+}
+
+// Fills levels and parents for the owned vertices (-1 when unreached).
+// Returns the number of BFS levels.
+int distributed_bfs(const DistributedGraph &g, int32_t start_vertex,
+                    std::vector<int32_t> &levels, std::vector<int32_t> &parents,
+                    MPI_Comm comm) {
+  const Partition1D &part = g.part;
+  int32_t base = part.first();
+  levels.assign(part.count(), -1);
+  parents.assign(part.count(), -1);
+
+  std::vector<int32_t> frontier, next;
+  if (part.owner(start_vertex) == part.rank) {
+    levels[start_vertex - base] = 0;
+    parents[start_vertex - base] = start_vertex;
+    frontier.push_back(start_vertex);
+  }
+
+  std::vector<std::vector<int32_t>> outgoing(part.size);
+  std::vector<int> sendCounts(part.size), recvCounts(part.size);
+  std::vector<int> sendDispls(part.size), recvDispls(part.size);
+  std::vector<int32_t> sendBuf, recvBuf;
+
+  int level = 0;
+  while (true) {
+    // Expand the owned frontier
+    for (int32_t u : frontier) {
+      for (int32_t v : g.local.neighbors(u - base)) {
+        int owner = part.owner(v);
+        if (owner == part.rank) {
+          if (levels[v - base] == -1) {
+            levels[v - base] = level + 1;
+            parents[v - base] = u;
+            next.push_back(v);
+          }
+        } else {
+          outgoing[owner].push_back(v);
+          outgoing[owner].push_back(u);
         }
       }
     }
-    // Apply changes if there are any
-    for (int i = 0; i < num_vertices; ++i) {
-      if (level_changes[i] != 0) {
-        local_levels[i] = level_changes[i];
+
+    // Exchange discovered remote vertices as (vertex, parent) pairs
+    int displ = 0;
+    for (int p = 0; p < part.size; p++) {
+      sendCounts[p] = (int)outgoing[p].size();
+      sendDispls[p] = displ;
+      displ += sendCounts[p];
+    }
+    sendBuf.resize(displ);
+    for (int p = 0; p < part.size; p++) {
+      std::copy(outgoing[p].begin(), outgoing[p].end(),
+                sendBuf.begin() + sendDispls[p]);
+      outgoing[p].clear();
+    }
+    MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT,
+                 comm);
+    displ = 0;
+    for (int p = 0; p < part.size; p++) {
+      recvDispls[p] = displ;
+      displ += recvCounts[p];
+    }
+    recvBuf.resize(displ);
+    MPI_Alltoallv(sendBuf.data(), sendCounts.data(), sendDispls.data(),
+                  MPI_INT32_T, recvBuf.data(), recvCounts.data(),
+                  recvDispls.data(), MPI_INT32_T, comm);
+
+    for (size_t i = 0; i < recvBuf.size(); i += 2) {
+      int32_t v = recvBuf[i];
+      if (levels[v - base] == -1) {
+        levels[v - base] = level + 1;
+        parents[v - base] = recvBuf[i + 1];
+        next.push_back(v);
       }
     }
-    // Communicate the changes to all processors
-    MPI_Allreduce(MPI_IN_PLACE, local_levels.data(), num_vertices, MPI_INT,
-                  MPI_MIN, MPI_COMM_WORLD);
-    MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_C_BOOL, MPI_LOR,
-                  MPI_COMM_WORLD);
-  } while (changed);
-  // Update the global levels vector with the local levels
-  levels = local_levels;
+
+    // Done once no rank discovered anything this level
+    long long local_next = (long long)next.size(), global_next = 0;
+    MPI_Allreduce(&local_next, &global_next, 1, MPI_LONG_LONG, MPI_SUM, comm);
+    if (global_next == 0) {
+      return level + 1;
+    }
+    frontier.swap(next);
+    next.clear();
+    level++;
+  }
+}
+
+// Gathers a per-vertex array spread over the 1-D partition onto rank 0.
+std::vector<int32_t> gatherOnRoot(const Partition1D &part,
+                                  const std::vector<int32_t> &mine,
+                                  MPI_Comm comm) {
+  std::vector<int> counts(part.size), displs(part.size);
+  for (int p = 0; p < part.size; p++) {
+    int32_t first = std::min(part.numVertices, p * part.block);
+    counts[p] = std::min(part.numVertices, (p + 1) * part.block) - first;
+    displs[p] = first;
+  }
+  std::vector<int32_t> all(part.rank == 0 ? part.numVertices : 0);
+  MPI_Gatherv(mine.data(), (int)mine.size(), MPI_INT32_T, all.data(),
+              counts.data(), displs.data(), MPI_INT32_T, 0, comm);
+  return all;
+}
+
+// Serial check on rank 0: reloads the whole file on one rank and runs a queue BFS.
+bool verifyOnRoot(const std::string &path, int32_t start_vertex,
+                  const std::vector<int32_t> &levels,
+                  const std::vector<int32_t> &parents) {
+  EdgeSlice slice = readEdgeSlice(path, MPI_COMM_SELF);
+  std::vector<CSREdge> both;
+  for (const CSREdge &e : slice.edges) {
+    both.push_back(e);
+    both.push_back({e.dst, e.src, e.weight});
+  }
+  CSRGraph graph = CSRGraph::fromEdgeList(slice.numVertices, both);
+
+  std::vector<int32_t> expected(slice.numVertices, -1);
+  std::queue<int32_t> queue;
+  expected[start_vertex] = 0;
+  queue.push(start_vertex);
+  while (!queue.empty()) {
+    int32_t u = queue.front();
+    queue.pop();
+    for (int32_t v : graph.neighbors(u)) {
+      if (expected[v] == -1) {
+        expected[v] = expected[u] + 1;
+        queue.push(v);
+      }
+    }
+  }
+  if (expected != levels) {
+    return false;
+  }
+  // Every reached vertex other than the source must hang off a vertex one level up
+  for (int32_t v = 0; v < slice.numVertices; v++) {
+    if (levels[v] > 0 && levels[parents[v]] != levels[v] - 1) {
+      return false;
+    }
+  }
+  return true;
 }
 
 int main(int argc, char **argv) {
@@ -64,16 +212,43 @@ int main(int argc, char **argv) {
   MPI_Comm_size(MPI_COMM_WORLD, &world_size);
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
-  int num_vertices = sizeof(graph) / sizeof(graph[0]);
-  std::vector<int> levels(num_vertices, std::numeric_limits<int>::max());
+  // Usage: distributed_bfs [edge-file [source]]; without a file a random test
+  // graph is generated so the run checks itself.
+  std::string path = argc > 1 ? argv[1] : "distributed_bfs_test_graph.txt";
+  int32_t source = argc > 2 ? std::atoi(argv[2]) : 0;
+  bool generated = argc <= 1;
+  if (generated && rank == 0) {
+    writeRandomEdgeFile(path, 100000, 400000, 12345);
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  DistributedGraph g = loadPartitioned(path, MPI_COMM_WORLD);
+  std::vector<int32_t> levels, parents;
 
-  // Assuming vertex 0 is the source vertex for BFS
-  distributed_bfs(0, levels, rank, world_size);
+  MPI_Barrier(MPI_COMM_WORLD);
+  auto begin = std::chrono::steady_clock::now();
+  int depth = distributed_bfs(g, source, levels, parents, MPI_COMM_WORLD);
+  auto end = std::chrono::steady_clock::now();
+
+  long long reached = 0, local_reached = 0;
+  for (int32_t l : levels) {
+    local_reached += (l != -1);
+  }
+  MPI_Reduce(&local_reached, &reached, 1, MPI_LONG_LONG, MPI_SUM, 0,
+             MPI_COMM_WORLD);
 
-  // Print the BFS levels
+  std::vector<int32_t> all_levels = gatherOnRoot(g.part, levels, MPI_COMM_WORLD);
+  std::vector<int32_t> all_parents =
+      gatherOnRoot(g.part, parents, MPI_COMM_WORLD);
   if (rank == 0) {
-    for (int i = 0; i < num_vertices; ++i) {
-      std::cout << "Vertex " << i << " has level " << levels[i] << std::endl;
+    double seconds = std::chrono::duration<double>(end - begin).count();
+    std::cout << "Ranks " << world_size << ", vertices " << g.part.numVertices
+              << ", reached " << reached << " in " << depth << " levels, "
+              << seconds << " s" << std::endl;
+    if (generated) {
+      bool ok = verifyOnRoot(path, source, all_levels, all_parents);
+      std::cout << (ok ? "Test passed" : "Test failed") << std::endl;
+      std::remove(path.c_str());
     }
   }
 
@@ -81,5 +256,5 @@ int main(int argc, char **argv) {
   return 0;
 }
 
-// compile: mpicxx distributed_bfs.cpp -o distributed_bfs -O3
-// execute: mpiexec -n 4 ./distributed_bfs
+// compile: mpicxx -std=c++17 distributed_bfs.cpp -o distributed_bfs -O3
+// execute: mpiexec -n 4 ./distributed_bfs [edge-file [source]]
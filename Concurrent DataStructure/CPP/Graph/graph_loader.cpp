@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "GraphLoader.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool sameGraph(CSRView a, CSRView b) {
+    if (a.numVertices() != b.numVertices() || a.numEdges() != b.numEdges() || a.hasWeights() != b.hasWeights()) {
+        return false;
+    }
+    for (int32_t v = 0; v <= a.numVertices(); v++) {
+        if (a.offsets()[v] != b.offsets()[v]) return false;
+    }
+    for (int64_t i = 0; i < a.numEdges(); i++) {
+        if (a.neighborData()[i] != b.neighborData()[i]) return false;
+        if (a.hasWeights() && a.weightData()[i] != b.weightData()[i]) return false;
+    }
+    return true;
+}
+
+// Converts a text edge list to the binary format and reports both load times
+static int convert(const std::string& input, const std::string& output) {
+    auto t0 = std::chrono::steady_clock::now();
+    CSRGraph graph = loadEdgeList(input);
+    double parse = secondsSince(t0);
+    writeBinaryCSR(output, graph);
+    t0 = std::chrono::steady_clock::now();
+    MappedCSR mapped(output);
+    double map = secondsSince(t0);
+    std::cout << input << ": " << graph.numVertices() << " vertices, " << graph.numEdges() << " edges"
+              << (graph.hasWeights() ? ", weighted" : "") << "; text " << parse << " s, mmap " << map
+              << " s -> " << output << std::endl;
+    return sameGraph(graph, mapped) ? 0 : 1;
+}
+
+static bool expectThrow(const std::string& path, const std::string& contents) {
+    std::ofstream(path) << contents;
+    try {
+        readEdgeList(path);
+    } catch (const std::runtime_error& e) {
+        std::cout << "Rejected as expected: " << e.what() << std::endl;
+        return true;
+    }
+    return false;
+}
+
+static int selfTest() {
+    const std::string dir = "/tmp/";
+    const int32_t n = 200000;
+    std::mt19937 rng(5);
+    std::vector<CSREdge> edges;
+    for (int32_t i = 0; i < 8 * n; i++) {
+        edges.push_back({(int32_t)(rng() % n), (int32_t)(rng() % n), (int32_t)(rng() % 1000) - 100});
+    }
+    edges.push_back({n - 1, n - 1, 7}); // Highest id appears, as a self-loop
+    CSRGraph expected = CSRGraph::fromEdgeList(n, edges, true);
+    bool ok = true;
+
+    // SNAP: comments, tabs, CRLF and no newline after the last line
+    {
+        std::ofstream out(dir + "graph_loader_snap.txt");
+        out << "# Directed graph\n# FromNodeId\tToNodeId\tWeight\n";
+        for (size_t i = 0; i < edges.size(); i++) {
+            out << edges[i].src << '\t' << edges[i].dst << ' ' << edges[i].weight
+                << (i + 1 == edges.size() ? "" : (i % 3 ? "\n" : "\r\n"));
+        }
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    CSRGraph snap = loadEdgeList(dir + "graph_loader_snap.txt");
+    double parse = secondsSince(t0);
+    // Parsing alone, one thread against one per core (at least four)
+    const unsigned many = std::max(4u, CSRGraph::threadCount(0));
+    t0 = std::chrono::steady_clock::now();
+    readEdgeList(dir + "graph_loader_snap.txt", 1);
+    double parseOne = secondsSince(t0);
+    t0 = std::chrono::steady_clock::now();
+    readEdgeList(dir + "graph_loader_snap.txt", many);
+    double parseMany = secondsSince(t0);
+    // Chunk boundaries land mid-line at any thread count
+    bool split = sameGraph(loadEdgeList(dir + "graph_loader_snap.txt", 1), expected) &&
+                 sameGraph(loadEdgeList(dir + "graph_loader_snap.txt", 7), expected);
+    std::cout << (sameGraph(snap, expected) && split ? "Test passed" : "Test failed") << ": SNAP text, "
+              << edges.size() << " edges parsed in " << parse << " s" << std::endl;
+    ok &= sameGraph(snap, expected) && split;
+    std::cout << "Parsing alone: " << parseOne << " s on 1 thread, " << parseMany << " s on " << many << " threads"
+              << std::endl;
+
+    // Matrix Market symmetric pattern: lower triangle, 1-based, reverse edges implied
+    {
+        std::ofstream out(dir + "graph_loader.mtx");
+        out << "%%MatrixMarket matrix coordinate pattern symmetric\n% generated\n" << n << ' ' << n << ' '
+            << edges.size() << '\n';
+        for (const CSREdge& e : edges) out << std::max(e.src, e.dst) + 1 << ' ' << std::min(e.src, e.dst) + 1 << '\n';
+    }
+    std::vector<CSREdge> both;
+    for (const CSREdge& e : edges) {
+        both.push_back({e.src, e.dst, 0});
+        if (e.src != e.dst) both.push_back({e.dst, e.src, 0});
+    }
+    bool mm = sameGraph(loadEdgeList(dir + "graph_loader.mtx"), CSRGraph::fromEdgeList(n, both));
+    std::cout << (mm ? "Test passed" : "Test failed") << ": Matrix Market symmetric pattern" << std::endl;
+    ok &= mm;
+
+    // Binary round trip through mmap
+    writeBinaryCSR(dir + "graph_loader.csr", expected);
+    t0 = std::chrono::steady_clock::now();
+    MappedCSR mapped(dir + "graph_loader.csr");
+    double map = secondsSince(t0);
+    bool binary = isBinaryCSR(dir + "graph_loader.csr") && sameGraph(mapped, expected);
+    std::cout << (binary ? "Test passed" : "Test failed") << ": binary CSR mapped in " << map << " s" << std::endl;
+    ok &= binary;
+
+    bool rejects = expectThrow(dir + "graph_loader_bad.txt", "0 1\n2 x\n") &&
+                   expectThrow(dir + "graph_loader_bad.mtx",
+                               "%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 0.5\n");
+    std::ofstream(dir + "graph_loader_bad.csr") << "CSRGRAPH but cut short";
+    try {
+        MappedCSR truncated(dir + "graph_loader_bad.csr");
+        rejects = false;
+    } catch (const std::runtime_error& e) {
+        std::cout << "Rejected as expected: " << e.what() << std::endl;
+    }
+    std::cout << (rejects ? "Test passed" : "Test failed") << ": malformed inputs are rejected" << std::endl;
+    ok &= rejects;
+
+    for (const char* name : {"graph_loader_snap.txt", "graph_loader.mtx", "graph_loader.csr", "graph_loader_bad.txt",
+                             "graph_loader_bad.mtx", "graph_loader_bad.csr"}) {
+        std::remove((dir + name).c_str());
+    }
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc == 3) return convert(argv[1], argv[2]);
+    if (argc != 1) {
+        std::cerr << "usage: " << argv[0] << " [edge-list.txt|.mtx output.csr]" << std::endl;
+        return 1;
+    }
+    return selfTest();
+}
+
+// Compile with: g++ -std=c++17 -O3 graph_loader.cpp -o graph_loader -pthread
+// Run with: ./graph_loader                       (self-test)
+//           ./graph_loader soc-LiveJournal1.txt lj.csr
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "ConcurrentBFS.hpp"
+#include "GraphLoader.hpp"
+#include "GraphReorder.hpp"
+#include "../../../Algorithms/CPP/Greedy/dijkstra.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Undirected R-MAT graph (a = 0.57, b = c = 0.19) with weights 1..255. R-MAT
+// ids already cluster hubs at low numbers, so they are shuffled to look like
+// the arbitrary ids of a crawled graph.
+static CSRGraph rmatGraph(int scale, int edgeFactor) {
+    const int32_t n = 1 << scale;
+    std::mt19937_64 rng(17);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    std::vector<int32_t> shuffle(n);
+    for (int32_t v = 0; v < n; v++) shuffle[v] = v;
+    std::shuffle(shuffle.begin(), shuffle.end(), rng);
+    std::vector<CSREdge> edges((size_t)n * edgeFactor);
+    for (CSREdge& e : edges) {
+        int32_t u = 0, v = 0;
+        for (int bit = 0; bit < scale; bit++) {
+            double r = coin(rng);
+            u |= (r >= 0.76) << bit;
+            v |= (r >= 0.57 && r < 0.76) << bit | (r >= 0.95) << bit;
+        }
+        e = {shuffle[u], shuffle[v], (int32_t)(rng() % 255) + 1};
+    }
+    return CSRGraph::fromEdgeList(n, edges, true, true);
+}
+
+struct Measurement {
+    double bfs = 0, sssp = 0;
+    int64_t checksum = 0; // Reached counts and distance sums; must not depend on the ordering
+};
+
+static Measurement measure(CSRView graph, const std::vector<int32_t>& sources, int ssspSources) {
+    Measurement result;
+    ConcurrentBFS bfs(graph);
+    for (int32_t s : sources) {
+        auto t0 = std::chrono::steady_clock::now();
+        BFSResult r = bfs.run(s);
+        result.bfs += secondsSince(t0);
+        for (int32_t d : r.distance) result.checksum += d + 1;
+    }
+    for (int i = 0; i < ssspSources; i++) {
+        auto t0 = std::chrono::steady_clock::now();
+        ShortestPaths p = dijkstra<IndexedDaryHeap<4>>(graph, sources[i]);
+        result.sssp += secondsSince(t0);
+        for (int d : p.distance) result.checksum += d == INF ? 0 : d;
+    }
+    return result;
+}
+
+int main(int argc, char** argv) {
+    CSRGraph graph;
+    if (argc >= 2 && std::string(argv[1]) != "--scale") {
+        EdgeListFile file = readEdgeList(argv[1]);
+        graph = CSRGraph::fromEdgeList(file.numVertices, file.edges, file.weighted, !file.symmetric);
+    } else {
+        graph = rmatGraph(argc >= 3 ? std::atoi(argv[2]) : 18, 16);
+    }
+    const int32_t n = graph.numVertices();
+    std::cout << n << " vertices, " << graph.numEdges() << " edges, " << omp_get_max_threads() << " threads"
+              << std::endl;
+
+    // Sources with at least one edge, the same vertices under every ordering
+    std::mt19937 rng(3);
+    std::vector<int32_t> sources;
+    while (sources.size() < 8 && n > 0) {
+        int32_t s = (int32_t)(rng() % n);
+        if (graph.degree(s) > 0) sources.push_back(s);
+    }
+    const int ssspSources = 2;
+
+    struct Ordering {
+        const char* name;
+        std::vector<int32_t> (*order)(CSRView);
+    };
+    const Ordering orderings[] = {{"original", identityOrder}, {"degree", degreeSortOrder},
+                                  {"hub-cluster", hubClusterOrder}, {"rcm", rcmOrder}};
+
+    // Directed inputs (a path pointing back at the lowest-degree seed, and a
+    // sparse random graph) must still get a permutation from every ordering
+    bool ok = true;
+    std::vector<CSREdge> random(3000);
+    for (CSREdge& e : random) e = {(int32_t)(rng() % 2000), (int32_t)(rng() % 2000), 1};
+    const CSRGraph directed[] = {CSRGraph::fromEdgeList(3, {{1, 0, 1}, {2, 1, 1}}),
+                                 CSRGraph::fromEdgeList(2000, random)};
+    for (const CSRGraph& g : directed) {
+        for (const Ordering& ordering : orderings) {
+            std::vector<int32_t> perm = ordering.order(g), seen(g.numVertices(), 0);
+            for (int32_t p : perm) ok &= p >= 0 && p < g.numVertices() && !seen[p]++;
+        }
+    }
+    std::cout << (ok ? "Test passed" : "Test failed") << ": every ordering of a directed graph is a permutation"
+              << std::endl;
+
+    Measurement baseline;
+    std::cout << std::left << std::setw(13) << "ordering" << std::setw(13) << "reorder s" << std::setw(13)
+              << "bfs s" << std::setw(13) << "dijkstra s" << "speedup bfs/dijkstra" << std::endl;
+    for (const Ordering& ordering : orderings) {
+        auto t0 = std::chrono::steady_clock::now();
+        std::vector<int32_t> perm = ordering.order(graph);
+        CSRGraph relabeled = relabel(graph, perm);
+        double reorder = secondsSince(t0);
+
+        std::vector<int32_t> mapped;
+        for (int32_t s : sources) mapped.push_back(perm[s]);
+        Measurement m = measure(relabeled, mapped, ssspSources);
+        if (&ordering == orderings) baseline = m;
+        ok &= m.checksum == baseline.checksum;
+        std::cout << std::setw(13) << ordering.name << std::setw(13) << reorder << std::setw(13) << m.bfs
+                  << std::setw(13) << m.sssp << baseline.bfs / m.bfs << " / " << baseline.sssp / m.sssp
+                  << std::endl;
+    }
+    std::cout << (ok ? "Test passed" : "Test failed") << ": every ordering gives the same distances" << std::endl;
+    return ok ? 0 : 1;
+}
+
+// Compile with: g++ -std=c++17 -O3 -march=native -fopenmp reorder_benchmark.cpp -o reorder_benchmark -pthread
+// Run with: ./reorder_benchmark [--scale 20]   (R-MAT graph with 2^scale vertices)
+//           ./reorder_benchmark soc-LiveJournal1.txt
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+
+// csr_graph.h
+// Compressed sparse row graph for the C code. Vertex v's out-neighbors are
+// neighbors[offsets[v] .. offsets[v + 1]), with weights (when not NULL) at the
+// same positions. The arrays use the same types as CSRView in
+// Concurrent DataStructure/CPP/Graph/CSRGraph.hpp, so C++ code can wrap them
+// without copying.
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct CSREdge {
+    int32_t src;
+    int32_t dst;
+    int32_t weight;
+} CSREdge;
+
+typedef struct CSRGraph {
+    int32_t numVertices;
+    int64_t numEdges;
+    int64_t* offsets;   // numVertices + 1 entries
+    int32_t* neighbors; // numEdges entries
+    int32_t* weights;   // numEdges entries, or NULL when unweighted
+} CSRGraph;
+
+static inline void* csrAlloc(size_t bytes) {
+    void* p = malloc(bytes ? bytes : 1);
+    if (!p) {
+        perror("malloc failed");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+// Counting sort by source; neighbors keep the order they appear in edges
+static inline CSRGraph* csrFromEdges(int32_t numVertices, const CSREdge* edges, int64_t numEdges,
+                                     bool weighted) {
+    CSRGraph* g = (CSRGraph*)csrAlloc(sizeof(CSRGraph));
+    g->numVertices = numVertices;
+    g->numEdges = numEdges;
+    g->offsets = (int64_t*)csrAlloc((size_t)(numVertices + 1) * sizeof(int64_t));
+    g->neighbors = (int32_t*)csrAlloc((size_t)numEdges * sizeof(int32_t));
+    g->weights = weighted ? (int32_t*)csrAlloc((size_t)numEdges * sizeof(int32_t)) : NULL;
+
+    memset(g->offsets, 0, (size_t)(numVertices + 1) * sizeof(int64_t));
+    for (int64_t i = 0; i < numEdges; i++) {
+        g->offsets[edges[i].src + 1]++;
+    }
+    for (int32_t v = 0; v < numVertices; v++) {
+        g->offsets[v + 1] += g->offsets[v];
+    }
+
+    int64_t* cursor = (int64_t*)csrAlloc((size_t)numVertices * sizeof(int64_t));
+    memcpy(cursor, g->offsets, (size_t)numVertices * sizeof(int64_t));
+    for (int64_t i = 0; i < numEdges; i++) {
+        int64_t slot = cursor[edges[i].src]++;
+        g->neighbors[slot] = edges[i].dst;
+        if (weighted) {
+            g->weights[slot] = edges[i].weight;
+        }
+    }
+    free(cursor);
+    return g;
+}
+
+static inline int64_t csrDegree(const CSRGraph* g, int32_t v) {
+    return g->offsets[v + 1] - g->offsets[v];
+}
+
+static inline void csrFree(CSRGraph* g) {
+    if (!g) return;
+    free(g->offsets);
+    free(g->neighbors);
+    free(g->weights);
+    free(g);
+}
+
+#endif // CSR_GRAPH_H
@@ -22,48 +22,111 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include "graph.h"
 
-typedef struct Edge {
-    int dest;
-    int weight;
-    struct Edge* next;
-} Edge;
-
-typedef struct Vertex {
-    int value;
-    Edge* head; // Head of the list of edges
-} Vertex;
-
-typedef struct Graph {
-    int numVertices;
-    Vertex* vertices; // Dynamic array of vertices
-} Graph;
+#define EDGE_INDEX_EMPTY UINT64_MAX       // Never-used slot, ends a probe sequence
+#define EDGE_INDEX_TOMB (UINT64_MAX - 1)  // Deleted slot, probing continues past it
+#define EDGE_INDEX_MIN_CAPACITY 16
 
 // Time and Space Complexity Analysis
-// adjacent(G, x, y): O(V) in the worst case, where V is the number of vertices, as it may need to traverse the entire edge list of vertex x.
-// neighbors(G, x): O(V) in the worst case, for the same reason as adjacent.
-// add_vertex(G, x): O(1) if we ignore the time taken to check if the vertex exists and reallocating memory. Otherwise, O(V).
-// remove_vertex(G, x): O(V + E), where E is the number of edges, because it needs to remove the vertex and all edges connected to it.
-// add_edge(G, x, y, z), remove_edge(G, x, y): O(V) in the worst case, to find the vertices and update their edge lists.
+// adjacent(G, x, y): O(1) on average, one probe sequence in the edge index.
+// neighbors(G, x): O(deg(x)), a scan of x's contiguous edge array.
+// add_vertex(G, x): O(1) amortized; the vertex array doubles when full, so vertex counts are unbounded.
+// remove_vertex(G, x): O(V + E), because it renumbers the vertices after x and rebuilds the edge index.
+// add_edge(G, x, y, z), remove_edge(G, x, y): O(1) on average; removal moves x's last edge into the hole.
 // get_vertex_value(G, x), set_vertex_value(G, x, v): O(1), assuming direct access to the vertex.
-// get_edge_value(G, x, y), set_edge_value(G, x, y, v): O(V), as it may need to traverse the edge list of x to find y.
-// printGraph operating in O(V+E) time, where V is the number of vertices and E is the number of edges, to print all vertices and their edges. The space complexity of the graph is O(V+E), accounting for all vertices and their edge lists.
-
-// Function prototypes for graph operations
-Graph* createGraph(int numVertices);
-void add_edge(Graph* graph, int src, int dest, int weight);
-bool adjacent(Graph* graph, int x, int y);
-void add_vertex(Graph* graph, int x);
-void remove_vertex(Graph* graph, int vertex);
-void remove_edge(Graph* graph, int src, int dest);
-int get_vertex_value(Graph* graph, int x);
-void set_vertex_value(Graph* graph, int x, int value);
-int get_edge_value(Graph* graph, int src, int dest);
-void set_edge_value(Graph* graph, int src, int dest, int weight);
-void printGraph(Graph* graph);
-void freeGraph(Graph* graph);
-
-// createGraph: Allocates memory for the Graph structure and its vertices array, initializing each vertex's edge list head to NULL and their value to 0. It's crucial to check for successful memory allocation to avoid memory access errors.
+// get_edge_value(G, x, y), set_edge_value(G, x, y, v): O(1) on average through the edge index.
+// printGraph operating in O(V+E) time, where V is the number of vertices and E is the number of edges, to print all vertices and their edges. The space complexity of the graph is O(V+E), accounting for all vertices, their edge arrays and the index (at most 50% full).
+
+static void* graphAlloc(size_t bytes) {
+    void* p = malloc(bytes);
+    if (!p) {
+        perror("malloc failed");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+static uint64_t edgeKey(int src, int dest) {
+    return (uint64_t)(uint32_t)src << 32 | (uint32_t)dest;
+}
+
+// 64-bit finalizer from MurmurHash3; keys of one vertex differ only in the low bits
+static size_t edgeHash(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return (size_t)key;
+}
+
+static void indexInit(EdgeIndex* index, size_t capacity) {
+    index->capacity = capacity;
+    index->used = 0;
+    index->keys = (uint64_t*)graphAlloc(capacity * sizeof(uint64_t));
+    index->slots = (int*)graphAlloc(capacity * sizeof(int));
+    for (size_t i = 0; i < capacity; i++) {
+        index->keys[i] = EDGE_INDEX_EMPTY;
+    }
+}
+
+// Position of key in the table, or -1
+static long indexFind(const EdgeIndex* index, uint64_t key) {
+    size_t mask = index->capacity - 1;
+    for (size_t i = edgeHash(key) & mask;; i = (i + 1) & mask) {
+        if (index->keys[i] == key) {
+            return (long)i;
+        }
+        if (index->keys[i] == EDGE_INDEX_EMPTY) {
+            return -1;
+        }
+    }
+}
+
+static void indexPut(EdgeIndex* index, uint64_t key, int slot) {
+    size_t mask = index->capacity - 1;
+    size_t i = edgeHash(key) & mask;
+    while (index->keys[i] != EDGE_INDEX_EMPTY && index->keys[i] != EDGE_INDEX_TOMB) {
+        i = (i + 1) & mask;
+    }
+    if (index->keys[i] == EDGE_INDEX_EMPTY) {
+        index->used++;
+    }
+    index->keys[i] = key;
+    index->slots[i] = slot;
+}
+
+// Re-inserts every edge of the graph into a fresh table sized for twice the load, dropping tombstones
+static void indexRebuild(Graph* graph) {
+    size_t capacity = EDGE_INDEX_MIN_CAPACITY;
+    while (capacity < 4 * (size_t)graph->numEdges) {
+        capacity *= 2;
+    }
+    free(graph->index.keys);
+    free(graph->index.slots);
+    indexInit(&graph->index, capacity);
+    for (int v = 0; v < graph->numVertices; v++) {
+        for (int e = 0; e < graph->vertices[v].degree; e++) {
+            indexPut(&graph->index, edgeKey(v, graph->vertices[v].edges[e].dest), e);
+        }
+    }
+}
+
+static Edge* findEdge(Graph* graph, int src, int dest) {
+    long pos = indexFind(&graph->index, edgeKey(src, dest));
+    return pos < 0 ? NULL : &graph->vertices[src].edges[graph->index.slots[pos]];
+}
+
+static bool validVertex(Graph* graph, int x) {
+    if (x < 0 || x >= graph->numVertices) {
+        printf("Vertex %d does not exist.\n", x);
+        return false;
+    }
+    return true;
+}
+
+// createGraph: Allocates memory for the Graph structure and its vertices array, initializing each vertex's edge array to empty and their value to 0. It's crucial to check for successful memory allocation to avoid memory access errors.
 Graph* createGraph(int numVertices) {
     Graph* graph = (Graph*)malloc(sizeof(Graph));
     if (!graph) {
@@ -72,7 +135,9 @@ Graph* createGraph(int numVertices) {
     }
 
     graph->numVertices = numVertices;
-    graph->vertices = (Vertex*)malloc(numVertices * sizeof(Vertex));
+    graph->capacity = numVertices > 4 ? numVertices : 4;
+    graph->numEdges = 0;
+    graph->vertices = (Vertex*)malloc(graph->capacity * sizeof(Vertex));
 
     if (!graph->vertices) {
         printf("Memory allocation failed for vertices.\n");
@@ -81,65 +146,92 @@ Graph* createGraph(int numVertices) {
     }
 
     for (int i = 0; i < numVertices; i++) {
-        graph->vertices[i].head = NULL;
+        graph->vertices[i].edges = NULL;
+        graph->vertices[i].degree = 0;
+        graph->vertices[i].capacity = 0;
         graph->vertices[i].value = 0; // Optionally initialize vertex value to 0 or any identifier
     }
+    indexInit(&graph->index, EDGE_INDEX_MIN_CAPACITY);
 
     return graph;
 }
 
 
-// add_edge(G, x, y, z): Before adding an edge, use adjacent(G, x, y) to check if an edge already exists. If not, proceed to add the new edge.
+// add_edge(G, x, y, z): Before adding an edge, use adjacent(G, x, y) to check if an edge already exists. If not, append it to x's edge array and record its slot in the index.
 // Function to add an edge if it does not already exist
 void add_edge(Graph* graph, int src, int dest, int weight) {
-    if (!adjacent(graph, src, dest)) {
-        Edge* newEdge = (Edge*)malloc(sizeof(Edge));
-        newEdge->dest = dest;
-        newEdge->weight = weight;
-        newEdge->next = graph->vertices[src].head;
-        graph->vertices[src].head = newEdge;
+    if (!validVertex(graph, src) || !validVertex(graph, dest) || adjacent(graph, src, dest)) {
+        return;
+    }
+
+    Vertex* vertex = &graph->vertices[src];
+    if (vertex->degree == vertex->capacity) {
+        vertex->capacity = vertex->capacity ? 2 * vertex->capacity : 4;
+        Edge* grown = (Edge*)realloc(vertex->edges, vertex->capacity * sizeof(Edge));
+        if (!grown) {
+            perror("realloc failed");
+            exit(EXIT_FAILURE);
+        }
+        vertex->edges = grown;
     }
+    vertex->edges[vertex->degree].dest = dest;
+    vertex->edges[vertex->degree].weight = weight;
+
+    // Keep the index at most half full, tombstones included
+    if (2 * (graph->index.used + 1) > graph->index.capacity) {
+        graph->numEdges++;
+        vertex->degree++;
+        indexRebuild(graph);
+        return;
+    }
+    indexPut(&graph->index, edgeKey(src, dest), vertex->degree);
+    vertex->degree++;
+    graph->numEdges++;
 }
 
-// adjacent(G, x, y): Iterate over the edge list of vertex x. If a vertex y is found, return true; otherwise, return false.
+// adjacent(G, x, y): Look up the key (x, y) in the edge index.
 // Function to check if an edge exists between x and y
 bool adjacent(Graph* graph, int x, int y) {
-    Edge* temp = graph->vertices[x].head;
-    while (temp != NULL) {
-        if (temp->dest == y) {
-            return true;
-        }
-        temp = temp->next;
-    }
-    return false;
+    return indexFind(&graph->index, edgeKey(x, y)) >= 0;
 }
 
 
-// remove_vertex(G, x): Iterate through G's vertices to find x. Remove x and adjust the vertices array. Also, go through all vertices' edge lists and remove any edges pointing to x.
+// add_vertex(G, x): Append a vertex with value x, doubling the vertices array when it is full.
 void add_vertex(Graph* graph, int x) {
-    // Dynamically increase the size of the vertices array to add a new vertex
-    // This is a simplified approach and might not be the most efficient way to handle vertices dynamically
-    graph->numVertices++;
-    graph->vertices = realloc(graph->vertices, graph->numVertices * sizeof(Vertex));
-    graph->vertices[graph->numVertices - 1].head = NULL;
-    graph->vertices[graph->numVertices - 1].value = x;
-    printf("Vertex %d added.\n", x);
+    if (graph->numVertices == graph->capacity) {
+        graph->capacity *= 2;
+        Vertex* grown = (Vertex*)realloc(graph->vertices, graph->capacity * sizeof(Vertex));
+        if (!grown) {
+            perror("realloc failed");
+            exit(EXIT_FAILURE);
+        }
+        graph->vertices = grown;
+    }
+    Vertex* vertex = &graph->vertices[graph->numVertices++];
+    vertex->edges = NULL;
+    vertex->degree = 0;
+    vertex->capacity = 0;
+    vertex->value = x;
 }
 
 
-// remove_edge(G, x, y): Traverse the edge list of vertex x to find and remove the edge pointing to y.
+// remove_edge(G, x, y): Find the edge through the index, move x's last edge into its slot and update that edge's index entry.
 // Function to remove an edge from x to y
 void remove_edge(Graph* graph, int src, int dest) {
-    Edge** curr = &graph->vertices[src].head;
-    while (*curr) {
-        Edge* entry = *curr;
-        if (entry->dest == dest) {
-            *curr = entry->next;
-            free(entry);
-            return;
-        }
-        curr = &entry->next;
+    long pos = indexFind(&graph->index, edgeKey(src, dest));
+    if (pos < 0) {
+        return;
+    }
+    Vertex* vertex = &graph->vertices[src];
+    int slot = graph->index.slots[pos];
+    int last = vertex->degree - 1;
+    graph->index.keys[pos] = EDGE_INDEX_TOMB;
+    if (slot != last) {
+        vertex->edges[slot] = vertex->edges[last];
+        graph->index.slots[indexFind(&graph->index, edgeKey(src, vertex->edges[slot].dest))] = slot;
     }
+    vertex->degree--;
+    graph->numEdges--;
 }
 
 
@@ -155,18 +247,12 @@ void set_vertex_value(Graph* graph, int x, int value) {
 }
 
 
-// get_edge_value(G, x, y) and set_edge_value(G, x, y, v): Traverse the edge list of vertex x to find the edge pointing to y and get/set its weight.
+// get_edge_value(G, x, y) and set_edge_value(G, x, y, v): Find the edge from x to y through the index and get/set its weight.
 // Function to get the value (weight) of an edge from x to y
 // Return the value (weight) associated with the edge from x to y
 int get_edge_value(Graph* graph, int src, int dest) {
-    Edge* temp = graph->vertices[src].head;
-    while (temp) {
-        if (temp->dest == dest) {
-            return temp->weight;
-        }
-        temp = temp->next;
-    }
-    return -1; // Indicate that the edge does not exist
+    Edge* edge = findEdge(graph, src, dest);
+    return edge ? edge->weight : -1; // -1 indicates that the edge does not exist
 }
 
 
@@ -174,41 +260,31 @@ int get_edge_value(Graph* graph, int src, int dest) {
 // Set the value (weight) of the edge from x to y to v.
 // Function to set the value (weight) of an edge from x to y
 void set_edge_value(Graph* graph, int src, int dest, int weight) {
-    Edge* temp = graph->vertices[src].head;
-    while (temp) {
-        if (temp->dest == dest) {
-            temp->weight = weight;
-            return;
-        }
-        temp = temp->next;
+    Edge* edge = findEdge(graph, src, dest);
+    if (edge) {
+        edge->weight = weight;
     }
 }
 
 // neighbors(G, x) : Return the list of vertices connected by an edge from vertex x.
 void neighbors(Graph* graph, int x) {
     printf("Neighbors of Vertex %d:\n", x);
-    Edge* temp = graph->vertices[x].head;
-    while (temp != NULL) {
-        printf("%d ", temp->dest);
-        temp = temp->next;
+    for (int e = 0; e < graph->vertices[x].degree; e++) {
+        printf("%d ", graph->vertices[x].edges[e].dest);
     }
     printf("\n");
 }
 
 
+// remove_vertex(G, x): Free x's edges, shift the later vertices down, drop edges pointing to x, renumber the others and rebuild the index.
 void remove_vertex(Graph* graph, int vertex) {
-    if (vertex < 0 || vertex >= graph->numVertices) {
-        printf("Vertex %d does not exist.\n", vertex);
+    if (!validVertex(graph, vertex)) {
         return;
     }
 
-    // First, free the adjacency list of the vertex to be removed.
-    Edge* tempEdge = graph->vertices[vertex].head;
-    while (tempEdge != NULL) {
-        Edge* toDelete = tempEdge;
-        tempEdge = tempEdge->next;
-        free(toDelete);
-    }
+    // First, free the edge array of the vertex to be removed.
+    graph->numEdges -= graph->vertices[vertex].degree;
+    free(graph->vertices[vertex].edges);
 
     // Shift vertices down to fill the gap.
     for (int i = vertex; i < graph->numVertices - 1; i++) {
@@ -218,25 +294,26 @@ void remove_vertex(Graph* graph, int vertex) {
     // Adjust the numVertices.
     graph->numVertices--;
 
-    // Update the adjacency lists of the remaining vertices.
+    // Update the edge arrays of the remaining vertices.
     for (int i = 0; i < graph->numVertices; i++) {
-        Edge** curr = &graph->vertices[i].head;
-        while (*curr != NULL) {
-            Edge* entry = *curr;
-            if (entry->dest == vertex) {
-                *curr = entry->next; // Remove edge pointing to the removed vertex.
-                free(entry);
-            } else {
-                if (entry->dest > vertex) {
-                    entry->dest--; // Adjust the destination vertex index.
-                }
-                curr = &entry->next;
+        Vertex* v = &graph->vertices[i];
+        int kept = 0;
+        for (int e = 0; e < v->degree; e++) {
+            Edge edge = v->edges[e];
+            if (edge.dest == vertex) {
+                graph->numEdges--; // Remove edge pointing to the removed vertex.
+                continue;
+            }
+            if (edge.dest > vertex) {
+                edge.dest--; // Adjust the destination vertex index.
             }
+            v->edges[kept++] = edge;
         }
+        v->degree = kept;
     }
 
-    // Optionally, resize the vertices array.
-    graph->vertices = realloc(graph->vertices, graph->numVertices * sizeof(Vertex));
+    // Every key after the removed vertex changed, so rebuild the index.
+    indexRebuild(graph);
 }
 
 void printGraph(Graph* graph) {
@@ -249,10 +326,8 @@ void printGraph(Graph* graph) {
         Vertex vertex = graph->vertices[i];
         printf("Vertex %d (Value %d) has edges to: ", i, vertex.value);
 
-        Edge* edge = vertex.head;
-        while (edge) {
-            printf("%d (Weight %d) ", edge->dest, edge->weight);
-            edge = edge->next;
+        for (int e = 0; e < vertex.degree; e++) {
+            printf("%d (Weight %d) ", vertex.edges[e].dest, vertex.edges[e].weight);
         }
 
         printf("\n");
@@ -263,68 +338,32 @@ void freeGraph(Graph* graph) {
     if (!graph) return;
 
     for (int i = 0; i < graph->numVertices; i++) {
-        Edge* edge = graph->vertices[i].head;
-        while (edge) {
-            Edge* temp = edge;
-            edge = edge->next;
-            free(temp);
-        }
+        free(graph->vertices[i].edges);
     }
 
+    free(graph->index.keys);
+    free(graph->index.slots);
     free(graph->vertices);
     free(graph);
 }
 
-
-
-
-int main() {
-    // Create a graph with 5 vertices
-    Graph* graph = createGraph(5);
-
-    // Add some edges
-    add_edge(graph, 0, 1, 10);
-    add_edge(graph, 0, 4, 20);
-    add_edge(graph, 1, 2, 30);
-    add_edge(graph, 1, 3, 40);
-    add_edge(graph, 2, 3, 60);
-    add_edge(graph, 3, 4, 70);
-    
-    // Set initial values for each vertex
-    // Directly use the vertex index for setting values
-    set_vertex_value(graph, 0, -1);
-    set_vertex_value(graph, 1, 1);
-    set_vertex_value(graph, 2, 2);
-    set_vertex_value(graph, 3, 3);
-    set_vertex_value(graph, 4, 4);
-    
-    
-    printf("Initial graph:\n");
-    printGraph(graph);
-    int getV = get_vertex_value(graph, 4);
-    printf("get vertex value from Vertex 4 : %d \n", getV);
-    // Test removing an edge
-    printf("\nRemoving edge from 1 to 3.\n");
-    remove_edge(graph, 1, 3);
-    printGraph(graph);
-
-    // Test removing a vertex
-    printf("\nRemoving vertex 2.\n");
-    remove_vertex(graph, 2);
-    printGraph(graph);
-
-    // Test getting and setting vertex and edge values
-    printf("\nSetting vertex 0 value to 100.\n");
-    set_vertex_value(graph, 0, 100);
-    printf("Vertex 0 value: %d\n", get_vertex_value(graph, 0));
-
-    printf("\nSetting edge value from 0 to 4 to 200.\n");
-    set_edge_value(graph, 0, 4, 200);
-    printf("Edge value from 0 to 4: %d\n", get_edge_value(graph, 0, 4));
-
-    // Cleanup
-    freeGraph(graph);
-
-    return 0;
+// graph_to_csr(G): Copy the edge arrays into CSR arrays once the graph stops changing, for the read-only algorithms (traversals, connected components). O(V + E).
+CSRGraph* graph_to_csr(Graph* graph) {
+    CSRGraph* csr = (CSRGraph*)csrAlloc(sizeof(CSRGraph));
+    csr->numVertices = graph->numVertices;
+    csr->numEdges = graph->numEdges;
+    csr->offsets = (int64_t*)csrAlloc((size_t)(graph->numVertices + 1) * sizeof(int64_t));
+    csr->neighbors = (int32_t*)csrAlloc((size_t)graph->numEdges * sizeof(int32_t));
+    csr->weights = (int32_t*)csrAlloc((size_t)graph->numEdges * sizeof(int32_t));
+
+    int64_t k = 0;
+    for (int v = 0; v < graph->numVertices; v++) {
+        csr->offsets[v] = k;
+        for (int e = 0; e < graph->vertices[v].degree; e++, k++) {
+            csr->neighbors[k] = graph->vertices[v].edges[e].dest;
+            csr->weights[k] = graph->vertices[v].edges[e].weight;
+        }
+    }
+    csr->offsets[graph->numVertices] = k;
+    return csr;
 }
-
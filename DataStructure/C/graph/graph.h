@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+// graph.h
+// Directed weighted graph with growable vertex and edge arrays. Each vertex
+// keeps its out-edges in a contiguous array, and one hash table maps
+// (src, dest) to the edge's slot, so adjacent, get_edge_value and
+// set_edge_value are O(1) on average instead of a list walk.
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "csr_graph.h"
+
+typedef struct Edge {
+    int dest;
+    int weight;
+} Edge;
+
+typedef struct Vertex {
+    int value;
+    int degree;   // Number of out-edges in edges
+    int capacity; // Allocated length of edges
+    Edge* edges;
+} Vertex;
+
+// Open addressing table from (src << 32 | dest) to the edge's index in src's array
+typedef struct EdgeIndex {
+    uint64_t* keys;
+    int* slots;
+    size_t capacity; // Power of two
+    size_t used;     // Live entries plus tombstones
+} EdgeIndex;
+
+typedef struct Graph {
+    int numVertices;
+    int capacity; // Allocated length of vertices
+    long numEdges;
+    Vertex* vertices;
+    EdgeIndex index;
+} Graph;
+
+// Function prototypes for graph operations
+Graph* createGraph(int numVertices);
+void add_edge(Graph* graph, int src, int dest, int weight);
+bool adjacent(Graph* graph, int x, int y);
+void neighbors(Graph* graph, int x);
+void add_vertex(Graph* graph, int x);
+void remove_vertex(Graph* graph, int vertex);
+void remove_edge(Graph* graph, int src, int dest);
+int get_vertex_value(Graph* graph, int x);
+void set_vertex_value(Graph* graph, int x, int value);
+int get_edge_value(Graph* graph, int src, int dest);
+void set_edge_value(Graph* graph, int src, int dest, int weight);
+void printGraph(Graph* graph);
+void freeGraph(Graph* graph);
+CSRGraph* graph_to_csr(Graph* graph);
+
+#endif // GRAPH_H
@@ -0,0 +1,106 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "graph.h"
+
+// Grows a graph one vertex at a time, past any initial size, and checks every
+// edge answer against the construction rule.
+int scale_test(void) {
+    const int n = 200000;
+    Graph* graph = createGraph(0);
+    for (int v = 0; v < n; v++) {
+        add_vertex(graph, v);
+    }
+    for (int v = 0; v < n; v++) {
+        for (int k = 1; k <= 4; k++) {
+            add_edge(graph, v, (int)(((long)v * 7 + k * 13) % n), k);
+        }
+    }
+    for (int v = 0; v < n; v += 2) {
+        remove_edge(graph, v, (int)(((long)v * 7 + 13) % n));
+    }
+    for (int v = 0; v < n; v++) {
+        for (int k = 1; k <= 4; k++) {
+            int dest = (int)(((long)v * 7 + k * 13) % n);
+            bool expected = !(k == 1 && v % 2 == 0);
+            if (adjacent(graph, v, dest) != expected ||
+                get_edge_value(graph, v, dest) != (expected ? k : -1)) {
+                printf("Test failed: edge %d -> %d\n", v, dest);
+                freeGraph(graph);
+                return 0;
+            }
+        }
+    }
+    printf("Test passed: %d vertices, %ld edges answer adjacent in O(1)\n", graph->numVertices, graph->numEdges);
+    freeGraph(graph);
+    return 1;
+}
+
+int main() {
+    // Create a graph with 5 vertices
+    Graph* graph = createGraph(5);
+
+    // Add some edges
+    add_edge(graph, 0, 1, 10);
+    add_edge(graph, 0, 4, 20);
+    add_edge(graph, 1, 2, 30);
+    add_edge(graph, 1, 3, 40);
+    add_edge(graph, 2, 3, 60);
+    add_edge(graph, 3, 4, 70);
+
+    // Set initial values for each vertex
+    // Directly use the vertex index for setting values
+    set_vertex_value(graph, 0, -1);
+    set_vertex_value(graph, 1, 1);
+    set_vertex_value(graph, 2, 2);
+    set_vertex_value(graph, 3, 3);
+    set_vertex_value(graph, 4, 4);
+
+
+    printf("Initial graph:\n");
+    printGraph(graph);
+    int getV = get_vertex_value(graph, 4);
+    printf("get vertex value from Vertex 4 : %d \n", getV);
+    // Test removing an edge
+    printf("\nRemoving edge from 1 to 3.\n");
+    remove_edge(graph, 1, 3);
+    printGraph(graph);
+
+    // Test removing a vertex
+    printf("\nRemoving vertex 2.\n");
+    remove_vertex(graph, 2);
+    printGraph(graph);
+
+    // Test getting and setting vertex and edge values
+    printf("\nSetting vertex 0 value to 100.\n");
+    set_vertex_value(graph, 0, 100);
+    printf("Vertex 0 value: %d\n", get_vertex_value(graph, 0));
+
+    printf("\nSetting edge value from 0 to 3 (formerly 4) to 200.\n");
+    set_edge_value(graph, 0, 3, 200);
+    printf("Edge value from 0 to 3: %d\n", get_edge_value(graph, 0, 3));
+
+    // Vertices can be added past the initial size
+    add_vertex(graph, 5);
+    printf("\nVertex 5 added.\n");
+    add_edge(graph, 4, 0, 90);
+    printf("Edge 4 -> 0 exists: %s\n", adjacent(graph, 4, 0) ? "yes" : "no");
+
+    // Flatten into CSR for read-only traversals
+    CSRGraph* csr = graph_to_csr(graph);
+    printf("\nCSR form: %d vertices, %lld edges\n", csr->numVertices, (long long)csr->numEdges);
+    for (int v = 0; v < csr->numVertices; v++) {
+        printf("Vertex %d:", v);
+        for (int64_t i = csr->offsets[v]; i < csr->offsets[v + 1]; i++) {
+            printf(" %d (Weight %d)", csr->neighbors[i], csr->weights[i]);
+        }
+        printf("\n");
+    }
+    csrFree(csr);
+
+    // Cleanup
+    freeGraph(graph);
+
+    return scale_test() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Compile with: gcc -O3 graph.c graph_test.c -o graph
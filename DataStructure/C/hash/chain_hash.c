@@ -19,12 +19,10 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "chain_hash.h"
+#include "hash_probing.h"
 
 //Separate Chaining
-typedef struct ListNode {
-    int key;
-    struct ListNode* next;
-} ListNode;
 
 typedef struct HashTable {
     ListNode** lists;
@@ -41,10 +39,6 @@ HashTable* createHashTable(int size) {
     return table;
 }
 
-int hashFunction(int key, int size) {
-    return key % size;
-}
-
 
 
 // Step-by-Step Explanation:
@@ -59,17 +53,8 @@ void chainedHashInsert(HashTable* table, int key) {
     // Compute the index using the hash function
     int index = hashFunction(key, table->size);
 
-    // Allocate memory for the new node
-    ListNode* newNode = (ListNode*)malloc(sizeof(ListNode));
-    if (newNode == NULL) {
-        printf("Unable to allocate memory for new node\n");
-        return;
-    }
-    newNode->key = key;
-
-    // Insert the new node at the beginning of the list at the computed index
-    newNode->next = table->lists[index];
-    table->lists[index] = newNode;
+    // Allocate the new node and insert it at the beginning of the list at the computed index
+    chainBucketInsert(&table->lists[index], key);
 }
 
 // Step-by-Step Explanation:
@@ -89,19 +74,8 @@ ListNode* chainedHashSearch(HashTable* table, int key) {
     // Compute the index for the given key using the hash function
     int index = hashFunction(key, table->size);
 
-    // Start from the head of the list at the computed index
-    ListNode* current = table->lists[index];
-
-    // Traverse the list to find the node with the given key
-    while (current != NULL) {
-        if (current->key == key) {
-            return current; // Key found, return the node
-        }
-        current = current->next; // Move to the next node in the list
-    }
-
-    // Key not found, return NULL
-    return NULL;
+    // Traverse the list at the computed index; NULL when the key is not present
+    return chainBucketSearch(table->lists[index], key);
 }
 
 // Step-by-Step Explanation:
@@ -121,30 +95,8 @@ void chainedHashDelete(HashTable* table, int key) {
     // Compute the index for the given key using the hash function
     int index = hashFunction(key, table->size);
 
-    // Start from the head of the list at the computed index
-    ListNode* current = table->lists[index];
-    ListNode* prev = NULL;
-
-    // Traverse the list to find the node with the given key
-    while (current != NULL) {
-        if (current->key == key) {
-            // Key found, now remove the node from the list
-            if (prev == NULL) {
-                // The node to delete is the head of the list
-                table->lists[index] = current->next;
-            } else {
-                // The node to delete is in the middle or end of the list
-                prev->next = current->next;
-            }
-            free(current); // Free the memory allocated for the node
-            return; // Key has been deleted, exit the function
-        }
-        // Move to the next node in the list
-        prev = current;
-        current = current->next;
-    }
-
-    // If the function reaches here, the key was not found in the list
+    // Unlink and free the first node with the key; nothing happens if it is absent
+    chainBucketDelete(&table->lists[index], key);
 }
 
 
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+
+// chain_hash.h
+// Bucket operations of the separate chaining table. They work on one bucket
+// head, so callers decide how buckets are laid out and locked.
+#ifndef CHAIN_HASH_H
+#define CHAIN_HASH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct ListNode {
+    int key;
+    struct ListNode* next;
+} ListNode;
+
+// Pushes key at the head of the bucket; returns 0 if the node cannot be allocated
+static inline int chainBucketInsert(ListNode** bucket, int key) {
+    ListNode* newNode = (ListNode*)malloc(sizeof(ListNode));
+    if (newNode == NULL) {
+        printf("Unable to allocate memory for new node\n");
+        return 0;
+    }
+    newNode->key = key;
+    newNode->next = *bucket;
+    *bucket = newNode;
+    return 1;
+}
+
+static inline ListNode* chainBucketSearch(ListNode* bucket, int key) {
+    for (ListNode* current = bucket; current != NULL; current = current->next) {
+        if (current->key == key) {
+            return current;
+        }
+    }
+    return NULL;
+}
+
+// Unlinks and frees the first node holding key; returns 1 if one was found
+static inline int chainBucketDelete(ListNode** bucket, int key) {
+    for (ListNode** link = bucket; *link != NULL; link = &(*link)->next) {
+        if ((*link)->key == key) {
+            ListNode* victim = *link;
+            *link = victim->next;
+            free(victim);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static inline void chainBucketFree(ListNode* bucket) {
+    while (bucket != NULL) {
+        ListNode* next = bucket->next;
+        free(bucket);
+        bucket = next;
+    }
+}
+
+#endif // CHAIN_HASH_H
@@ -85,7 +85,8 @@ bool cuckooInsert(CuckooHashTable* ht, int key) {
         pos1 = hash1(tempKey);
     }
 
-    // If loopCounter exceeds MAX_LOOPS, rehashing is needed (not implemented here)
+    // If loopCounter exceeds MAX_LOOPS, rehashing is needed (not implemented here;
+    // Concurrent DataStructure/C/Hash/cuckoo_map.c grows its buckets instead)
     printf("Rehashing needed\n");
     return false;
 }
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Cornell University.
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: I-Hsuan (Ethan) Huang
+ * Email: ih246@cornell.edu
+ */
+
+
+// hash_probing.h
+// Home and probe-sequence functions shared by the open addressing tables, so the
+// single-threaded tables and the concurrent set in Concurrent DataStructure/C/Hash
+// walk identical sequences. Arithmetic is unsigned and 64-bit: negative keys map
+// into the table and i * i cannot overflow on large tables.
+#ifndef HASH_PROBING_H
+#define HASH_PROBING_H
+
+#define LINEAR_PROBING 0
+#define QUADRATIC_PROBING 1
+#define DOUBLE_HASHING 2
+
+static inline int hashFunction(int key, int size) {
+    return (int)((unsigned int)key % (unsigned int)size);
+}
+
+static inline int linearProbing(int key, int i, int size) {
+    return (int)(((unsigned long long)hashFunction(key, size) + (unsigned long long)i) % (unsigned long long)size);
+}
+
+// Quadratic Probing
+static inline int quadraticProbing(int key, int i, int size) {
+    unsigned long long c1 = 1, c2 = 3; // Example constants
+    unsigned long long step = (unsigned long long)i;
+    return (int)(((unsigned long long)hashFunction(key, size) + c1 * step + c2 * step * step) % (unsigned long long)size);
+}
+
+// Double Hashing: with a prime size every step in [1, size - 1] is coprime to it,
+// so the sequence visits every slot
+static inline int hashFunction2(int key, int size) {
+    // Using a prime number less than table size as a simple example
+    int prime = size - 1; // Ensure this is prime and less than table size
+    return prime - (int)((unsigned int)key % (unsigned int)prime);
+}
+
+static inline int doubleHashing(int key, int i, int size) {
+    unsigned long long hash1 = (unsigned long long)hashFunction(key, size);
+    unsigned long long hash2 = (unsigned long long)hashFunction2(key, size);
+    return (int)((hash1 + (unsigned long long)i * hash2) % (unsigned long long)size);
+}
+
+#endif // HASH_PROBING_H
@@ -20,6 +20,7 @@
 //  Quadratic Probing and Double Hashing
 #include <stdio.h>
 #include <stdlib.h>
+#include "hash_probing.h"
 
 typedef enum EntryStatus {
     EMPTY, OCCUPIED, DELETED
@@ -40,39 +41,6 @@ typedef struct HashTable {
 
 
 
-#define LINEAR_PROBING 0
-#define QUADRATIC_PROBING 1
-#define DOUBLE_HASHING 2
-
-
-int hashFunction(int key, int size) {
-    return key % size;
-}
-
-int linearProbing(int key, int i, int size) {
-    return (hashFunction(key, size) + i) % size;
-}
-
-// Quadratic Probing
-int quadraticProbing(int key, int i, int size) {
-    int c1 = 1, c2 = 3; // Example constants
-    return (hashFunction(key, size) + c1 * i + c2 * i * i) % size;
-}
-
-// Double Hashing
-int hashFunction2(int key, int size) {
-    // Using a prime number less than table size as a simple example
-    int prime = size - 1; // Ensure this is prime and less than table size
-    return prime - (key % prime);
-}
-
-int doubleHashing(int key, int i, int size) {
-    int hash1 = hashFunction(key, size);
-    int hash2 = hashFunction2(key, size);
-    return (hash1 + i * hash2) % size;
-}
-
-
 // Initialize HashTable
 HashTable* initializeHashTable(int size) {
     HashTable* table = (HashTable*)malloc(sizeof(HashTable));